@@ -32,10 +32,16 @@ set SHARED_FLAGS=/nologo /Gm- /Zo /Oi /GR- /EHa- /fp:fast /fp:except- ^
     /D_CRT_SECURE_NO_WARNINGS=1
 
 set DEBUG_FLAGS=/Od /MTd /Zi /DPULSAR_DEBUG=1
+
+REM NOTE: Arena instrumentation is opt in, with "build instrument" or PULSAR_ARENA_INSTRUMENTATION=1 in the environment.
+set ARENA_INSTRUMENTATION=%PULSAR_ARENA_INSTRUMENTATION%
+if "%1" equ "instrument" set ARENA_INSTRUMENTATION=1
+if "%ARENA_INSTRUMENTATION%" equ "1" set DEBUG_FLAGS=%DEBUG_FLAGS% /DPULSAR_ARENA_INSTRUMENTATION=1
+
 set RELEASE_FLAGS=/O2 /MT /DPULSAR_DEBUG=0
 
 set LINKER_FLAGS=/opt:ref /incremental:no
-set LINKER_LIBRARIES=user32.lib gdi32.lib opengl32.lib
+set LINKER_LIBRARIES=user32.lib gdi32.lib opengl32.lib advapi32.lib psapi.lib
 
 pushd ..
 build\pulsar_code_generator.exe
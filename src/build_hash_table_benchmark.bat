@@ -0,0 +1,36 @@
+@echo off
+
+ctime -begin ctm/pulsar_hash_table_benchmark.ctm
+
+IF NOT EXIST build mkdir build
+pushd build
+
+ECHO]
+ECHO -------------------------------------
+ECHO *** BUILDING HASH TABLE BENCHMARK ***
+ECHO -------------------------------------
+
+REM /MT: Statically link C runtime library
+REM /Gm-: Disable incremental builds
+REM /Zi: Debug info
+REM /Oi: Intrinsics
+REM /GR-: Disable run-time type information
+REM /EHa-: Disable exceptions
+REM /WX: Treat warnings as errors
+REM /W4: Warning level 4
+REM /wd[xxx]: Disable warning
+REM /opt:ref: Cull unused functions
+
+REM NOTE: Always optimized, the numbers are meaningless otherwise.
+set FLAGS=/nologo /O2 /MT /Gm- /Zi /Zo /Oi /GR- /EHa- /fp:fast /fp:except- ^
+    /WX /W4 /wd4201 /wd4100 /wd4189 /wd4577 /wd4505 /wd4702 /wd4311 /wd4302 /wd4127 /wd4312 ^
+    /D_CRT_SECURE_NO_WARNINGS=1
+
+set LINKER_FLAGS=/opt:ref /incremental:no
+
+cl ..\pulsar_hash_table_benchmark.cpp %FLAGS% /link %LINKER_FLAGS%
+set LAST_ERROR=%ERRORLEVEL%
+
+popd
+
+ctime -end ctm/pulsar_hash_table_benchmark.ctm %LAST_ERROR%
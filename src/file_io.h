@@ -10,4 +10,9 @@ typedef struct EntireFile {
     void* data;
 } EntireFile;
 
+typedef struct FileChunk {
+    u32 size;
+    void* data;
+} FileChunk;
+
 #endif /* FILE_IO_H */
@@ -3,6 +3,14 @@
 
 #include <cmath>
 
+#if !defined(COMPILER_MSVC) && defined(_MSC_VER)
+#define COMPILER_MSVC 1
+#endif
+
+#if COMPILER_MSVC
+#include <intrin.h>
+#endif
+
 //
 // TODO: Convert all of these to platform-efficient versions
 // and remove math.h
@@ -124,4 +132,38 @@ inline BitScanResult find_least_significant_set_bit(u32 value) {
     return result;
 }
 
+inline BitScanResult find_least_significant_set_bit(u64 value) {
+    BitScanResult result = {};
+
+#if COMPILER_MSVC
+    result.found = _BitScanForward64((unsigned long*)&result.index, value);
+#else
+    if (value) {
+        result.index = cast(u32) __builtin_ctzll(value);
+        result.found = true;
+    }
+#endif
+    return result;
+}
+
+// @Note: Returns the value from before the add. Also a full memory barrier.
+inline u32 atomic_add_u32(u32 volatile* value, u32 addend) {
+#if COMPILER_MSVC
+    u32 result = cast(u32) _InterlockedExchangeAdd(cast(long volatile*) value, cast(long) addend);
+#else
+    u32 result = __sync_fetch_and_add(value, addend);
+#endif
+    return result;
+}
+
+// @Note: Returns the value from before the exchange. Also a full memory barrier.
+inline u32 atomic_exchange_u32(u32 volatile* value, u32 new_value) {
+#if COMPILER_MSVC
+    u32 result = cast(u32) _InterlockedExchange(cast(long volatile*) value, cast(long) new_value);
+#else
+    u32 result = __atomic_exchange_n(value, new_value, __ATOMIC_SEQ_CST);
+#endif
+    return result;
+}
+
 #endif
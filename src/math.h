@@ -124,6 +124,46 @@ inline f32 smootherstep(f32 x) {
     f32 result = x*x*x*(x*(x*6.0f - 15.0f) + 10.0f);
     return result;
 }
+
+//
+// NOTE: Random numbers
+//
+
+// @Note: xorshift64. Cheap, and fine for things that only have to look random, like particles or benchmark inputs.
+// The low bits are the weakest, so the narrower results come from the top.
+struct RandomSeries {
+    u64 state;
+};
+
+inline RandomSeries random_seed(u64 seed) {
+    RandomSeries result;
+    result.state = seed ? seed : 1; // @Note: A state of 0 stays 0
+    return result;
+}
+
+inline u64 random_u64(RandomSeries* series) {
+    u64 x = series->state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    series->state = x;
+    return x;
+}
+
+inline u32 random_u32(RandomSeries* series) {
+    u32 result = cast(u32) (random_u64(series) >> 32);
+    return result;
+}
+
+inline f32 random_unilateral(RandomSeries* series) {
+    f32 result = cast(f32) (random_u64(series) >> 40) / cast(f32) (1 << 24);
+    return result;
+}
+
+inline f32 random_range(RandomSeries* series, f32 lo, f32 hi) {
+    f32 result = lo + (hi - lo)*random_unilateral(series);
+    return result;
+}
 //
 // NOTE: Types
 //
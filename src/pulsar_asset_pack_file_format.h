@@ -55,14 +55,27 @@ introspect() struct PackedFont {
     f32 ascent;
     f32 descent;
     f32 line_gap;
+    u32 atlas_page_count;
 
     /* Data:
      * glyph_count = one_past_last_codepoint - first_codepoint;
-     * ImageID glyph_table[glyph_count];
+     * ImageID atlas_pages[atlas_page_count];
+     * PackedGlyph glyph_table[glyph_count];
      * f32 kerning_table[glyph_count][glyph_count];
      */
 };
 
+// @Note: Where a glyph lives in its font's atlas pages. The pages are images with the font's 1 / oversample_amount as
+// their scale, so a glyph drawn from one is like an image of w by h texels aligned by align.
+struct PackedGlyph {
+    u32 atlas_page; // @Note: Index into the font's atlas_pages, not an asset id
+    u32 w; // @Note: 0 for glyphs with nothing to draw
+    u32 h;
+    v2 align;
+    v2 min_uv;
+    v2 max_uv;
+};
+
 enum MidiFlag {
     MidiFlag_IgnoreExtremes = 0x1, // Ignore the very first and last message (for tracks that want to tie notes across loop points)
 };
@@ -120,7 +133,7 @@ struct PackedAsset {
 struct AssetPackHeader {
     u32 magic_value;
 
-#define ASSET_PACK_VERSION 0
+#define ASSET_PACK_VERSION 1
     u32 version;
 
     u32 asset_count;
@@ -22,6 +22,8 @@
 
 #define GAMMA_CORRECT_FONTS 1
 #define FONT_OVERSAMPLING 2
+#define FONT_ATLAS_PAGE_SIZE 1024
+#define FONT_ATLAS_PADDING 1 // @Note: Empty texels around every glyph, so bilinear filtering doesn't pick up its neighbours
 #define AUDIO_SAMPLE_RATE 48000
 
 #pragma pack(push, 1)
@@ -341,10 +343,12 @@ struct AssetDescription {
 
     f32 bpm;
     MidiID* midi_tracks;
+
+    PackedGlyph* glyphs;
 };
 
 global MemoryArena global_arena;
-global Array<AssetDescription> asset_descriptions;
+global BucketArray<AssetDescription> asset_descriptions;
 global u32 packed_asset_count = 1; // @Note: Reserving the 0th index for the null asset
 
 internal AssetDescription* add_asset(char* asset_name = 0, char* file_name = 0) {
@@ -372,7 +376,7 @@ internal AssetDescription* add_asset(char* asset_name = 0, char* file_name = 0)
         }
     }
 
-    AssetDescription* asset_desc = array_add(&asset_descriptions);
+    AssetDescription* asset_desc = bucket_array_add(&asset_descriptions);
     asset_desc->asset_index = packed_asset_count++;
     asset_desc->asset_name = asset_name;
     asset_desc->source_file = file_name;
@@ -394,6 +398,91 @@ internal AssetDescription* add_image(char* asset_name, char* file_name, v2 align
     return desc;
 }
 
+inline f32 get_font_scale(stbtt_fontinfo* font_info, PackedFont* font) {
+    f32 result = stbtt_ScaleForPixelHeight(font_info, cast(f32) (font->oversample_amount*font->size));
+    return result;
+}
+
+// @Note: Shelf packs the glyphs into as few atlas pages as it takes, tallest glyphs first, and leaves their rects in
+// desc->glyphs. The pixels get rendered into the rects when the font is packed.
+internal void layout_font_atlas(AssetDescription* desc) {
+    PackedFont* font = &desc->packed.font;
+    u32 glyph_count = font->one_past_last_codepoint - font->first_codepoint;
+    desc->glyphs = push_array(&global_arena, glyph_count, PackedGlyph);
+
+    TemporaryMemory temp = begin_temporary_memory(&global_arena);
+
+    EntireFile file = read_entire_file(desc->source_file, allocator(arena_allocator, &global_arena));
+    if (file.size) {
+        const u8* ttf_source = cast(const u8*) file.data;
+
+        stbtt_fontinfo font_info;
+        stbtt_InitFont(&font_info, ttf_source, stbtt_GetFontOffsetForIndex(ttf_source, 0));
+        f32 font_scale = get_font_scale(&font_info, font);
+
+        u32* sorted_glyphs = push_array(&global_arena, glyph_count, u32, no_clear());
+        u32 sorted_glyph_count = 0;
+        for (u32 glyph_index = 0; glyph_index < glyph_count; glyph_index++) {
+            PackedGlyph* glyph = desc->glyphs + glyph_index;
+
+            s32 ix0, iy0, ix1, iy1;
+            stbtt_GetCodepointBitmapBox(&font_info, font->first_codepoint + glyph_index, font_scale, font_scale, &ix0, &iy0, &ix1, &iy1);
+            glyph->w = ix1 - ix0;
+            glyph->h = iy1 - iy0;
+
+            if (glyph->w && glyph->h) {
+                assert(glyph->w + 2*FONT_ATLAS_PADDING <= FONT_ATLAS_PAGE_SIZE && glyph->h + 2*FONT_ATLAS_PADDING <= FONT_ATLAS_PAGE_SIZE);
+
+                // @Note: Insertion sort, tallest first. There's only a hundred or so glyphs.
+                u32 insert_index = sorted_glyph_count++;
+                while (insert_index > 0 && desc->glyphs[sorted_glyphs[insert_index - 1]].h < glyph->h) {
+                    sorted_glyphs[insert_index] = sorted_glyphs[insert_index - 1];
+                    insert_index--;
+                }
+                sorted_glyphs[insert_index] = glyph_index;
+            }
+        }
+
+        u32 page = 0;
+        u32 shelf_x = 0;
+        u32 shelf_y = 0;
+        u32 shelf_h = 0;
+        for (u32 sorted_index = 0; sorted_index < sorted_glyph_count; sorted_index++) {
+            PackedGlyph* glyph = desc->glyphs + sorted_glyphs[sorted_index];
+            u32 cell_w = glyph->w + 2*FONT_ATLAS_PADDING;
+            u32 cell_h = glyph->h + 2*FONT_ATLAS_PADDING;
+
+            if (shelf_x + cell_w > FONT_ATLAS_PAGE_SIZE) {
+                shelf_x = 0;
+                shelf_y += shelf_h;
+                shelf_h = 0;
+            }
+
+            if (shelf_y + cell_h > FONT_ATLAS_PAGE_SIZE) {
+                page++;
+                shelf_x = 0;
+                shelf_y = 0;
+                shelf_h = 0;
+            }
+
+            u32 x = shelf_x + FONT_ATLAS_PADDING;
+            u32 y = shelf_y + FONT_ATLAS_PADDING;
+
+            f32 rcp_page_size = 1.0f / cast(f32) FONT_ATLAS_PAGE_SIZE;
+            glyph->atlas_page = page;
+            glyph->min_uv = rcp_page_size*vec2(x, y);
+            glyph->max_uv = rcp_page_size*vec2(x + glyph->w, y + glyph->h);
+
+            shelf_x += cell_w;
+            shelf_h = MAX(shelf_h, cell_h);
+        }
+
+        font->atlas_page_count = sorted_glyph_count ? page + 1 : 0;
+    }
+
+    end_temporary_memory(temp);
+}
+
 internal AssetDescription* add_font(char* asset_name, char* file_name, u32 size) {
     AssetDescription* desc = add_asset(asset_name, file_name);
 
@@ -402,9 +491,12 @@ internal AssetDescription* add_font(char* asset_name, char* file_name, u32 size)
     font->first_codepoint = ' ';
     font->one_past_last_codepoint = '~' + 1;
     font->size = size;
+    font->oversample_amount = FONT_OVERSAMPLING;
 
-    // @Note: We will pack an image asset for every individual glyph for now.
-    packed_asset_count += font->one_past_last_codepoint - font->first_codepoint;
+    // @Note: The atlas pages are image assets of their own, stored right after the font, so the glyphs get laid out
+    // now to find out how many pages there are going to be.
+    layout_font_atlas(desc);
+    packed_asset_count += font->atlas_page_count;
 
     return desc;
 }
@@ -437,6 +529,8 @@ internal AssetDescription* add_soundtrack(char* asset_name, char* audio_file, u3
 }
 
 int main(int argument_count, char** arguments) {
+    initialize_memory_kernels();
+
 #define MEMORY_POOL_SIZE GIGABYTES(2ul)
     void* memory_pool = malloc(MEMORY_POOL_SIZE);
     // @Note: Zero the memory pool so everything allocated from the global
@@ -444,7 +538,7 @@ int main(int argument_count, char** arguments) {
     memset(memory_pool, 0, MEMORY_POOL_SIZE);
     initialize_arena(&global_arena, MEMORY_POOL_SIZE, memory_pool);
 
-    allocate_array(&asset_descriptions, 64, allocator(arena_allocator, &global_arena));
+    allocate_bucket_array(&asset_descriptions, allocator(arena_allocator, &global_arena));
 
     {
         MidiSourceInfo midi_files[] = { "assets/pulsar_kicktrack_1.mid", 0 };
@@ -502,8 +596,8 @@ int main(int argument_count, char** arguments) {
     if (out) {
         fseek(out, header.asset_name_store, SEEK_SET);
         fputc(0, out); // @Note: The name store starts with a null byte for assets without a name.
-        for (u32 asset_index = 0; asset_index < asset_descriptions.count; asset_index++) {
-            AssetDescription* asset_desc = asset_descriptions.data + asset_index;
+        for (BucketIterator<AssetDescription> it = iterate_bucket_array(&asset_descriptions); it.item; advance_iterator(&it)) {
+            AssetDescription* asset_desc = it.item;
 
             if (asset_desc->asset_name) {
                 PackedAsset* packed = &asset_desc->packed;
@@ -525,10 +619,10 @@ int main(int argument_count, char** arguments) {
 
         // @Note: Reserving the null index for the null asset
         u32 asset_catalog_index = 1;
-        PackedAsset* asset_catalog = push_array(&global_arena, packed_asset_count, PackedAsset, no_clear());
+        PackedAsset* asset_catalog = push_array(&global_arena, packed_asset_count, PackedAsset);
 
-        for (u32 asset_index = 0; asset_index < asset_descriptions.count; asset_index++) {
-            AssetDescription* asset_desc = asset_descriptions.data + asset_index;
+        for (BucketIterator<AssetDescription> it = iterate_bucket_array(&asset_descriptions); it.item; advance_iterator(&it)) {
+            AssetDescription* asset_desc = it.item;
             asset_catalog[asset_catalog_index++] = asset_desc->packed;
             PackedAsset* packed = asset_catalog + asset_catalog_index - 1;
 
@@ -597,9 +691,9 @@ int main(int argument_count, char** arguments) {
                         stbtt_fontinfo font_info;
                         stbtt_InitFont(&font_info, ttf_source, stbtt_GetFontOffsetForIndex(ttf_source, 0));
 
-                        u32 oversample_amount = FONT_OVERSAMPLING;
+                        u32 oversample_amount = packed->font.oversample_amount;
                         f32 rcp_oversample_amount = 1.0f / cast(f32) oversample_amount;
-                        f32 font_scale = stbtt_ScaleForPixelHeight(&font_info, cast(f32) (oversample_amount*packed->font.size));
+                        f32 font_scale = get_font_scale(&font_info, &packed->font);
 
                         s32 ascent, descent, line_gap;
                         stbtt_GetFontVMetrics(&font_info, &ascent, &descent, &line_gap);
@@ -612,23 +706,30 @@ int main(int argument_count, char** arguments) {
                         packed->font.ascent = scaled_ascent;
                         packed->font.descent = scaled_descent;
                         packed->font.line_gap = scaled_line_gap;
-                        packed->font.oversample_amount = oversample_amount;
 
-                        // @Note: The glyphs are stored in the asset catalog immediately after the font.
-                        u32 glyph_count = packed->font.one_past_last_codepoint - packed->font.first_codepoint;
-                        ImageID* glyph_table = push_array(&global_arena, glyph_count, ImageID);
-                        for (u32 glyph_index = 0; glyph_index < glyph_count; glyph_index++) {
-                            glyph_table[glyph_index] = { asset_catalog_index++ };
+                        // @Note: The atlas pages are stored in the asset catalog immediately after the font.
+                        u32 atlas_page_count = packed->font.atlas_page_count;
+                        ImageID* atlas_pages = push_array(&global_arena, atlas_page_count, ImageID);
+                        for (u32 page_index = 0; page_index < atlas_page_count; page_index++) {
+                            atlas_pages[page_index] = { asset_catalog_index++ };
                         }
 
-                        fwrite(glyph_table, sizeof(ImageID), glyph_count, out);
-                        fprintf(stderr, "Packed font '%s' from '%s' (glyph count: %d)\n", asset_desc->asset_name, asset_desc->source_file, glyph_count);
+                        u32 atlas_page_pixel_count = FONT_ATLAS_PAGE_SIZE*FONT_ATLAS_PAGE_SIZE;
+                        u32* atlas_pixels = push_array(&global_arena, atlas_page_count*atlas_page_pixel_count, u32);
+
+                        u32 glyph_count = packed->font.one_past_last_codepoint - packed->font.first_codepoint;
+                        PackedGlyph* glyph_table = asset_desc->glyphs;
 
+                        fwrite(atlas_pages, sizeof(ImageID), atlas_page_count, out);
+                        fprintf(stderr, "Packed font '%s' from '%s' (glyph count: %d, atlas pages: %d)\n", asset_desc->asset_name, asset_desc->source_file, glyph_count, atlas_page_count);
+
+                        // @Note: The glyph table goes in after the glyphs' aligns are known, along with the kerning table
+                        u32 glyph_table_size = sizeof(PackedGlyph)*glyph_count;
                         u32 kerning_table_size = sizeof(f32)*glyph_count*glyph_count;
                         f32* kerning_table = push_array(&global_arena, glyph_count*glyph_count, f32, no_clear());
 
-                        u32 kerning_table_position = ftell(out);
-                        fseek(out, kerning_table_size, SEEK_CUR);
+                        u32 glyph_table_position = ftell(out);
+                        fseek(out, glyph_table_size + kerning_table_size, SEEK_CUR);
 
                         s32 whitespace_advance_width;
                         stbtt_GetCodepointHMetrics(&font_info, ' ', &whitespace_advance_width, 0);
@@ -638,10 +739,7 @@ int main(int argument_count, char** arguments) {
                         for (u32 glyph_index = 0; glyph_index < glyph_count; glyph_index++) {
                             TemporaryMemory glyph_temp = begin_temporary_memory(&global_arena);
 
-                            PackedAsset* packed_glyph = asset_catalog + glyph_table[glyph_index].value;
-
-                            packed_glyph->type = AssetType_Image;
-                            packed_glyph->data_offset = ftell(out) - header.asset_data;
+                            PackedGlyph* glyph = glyph_table + glyph_index;
 
                             u32 codepoint = packed->font.first_codepoint + glyph_index;
 
@@ -650,6 +748,8 @@ int main(int argument_count, char** arguments) {
 
                             s32 w = ix1 - ix0;
                             s32 h = iy1 - iy0;
+                            assert(cast(u32) w == glyph->w && cast(u32) h == glyph->h);
+
                             u8* stb_glyph = cast(u8*) push_size(&global_arena, w*h);
                             stbtt_MakeCodepointBitmap(&font_info, stb_glyph, w, h, w, font_scale, font_scale, codepoint);
 
@@ -664,22 +764,24 @@ int main(int argument_count, char** arguments) {
                                 kerning_table[glyph_count*paired_glyph_index + glyph_index] = rcp_oversample_amount*font_scale*cast(f32) (advance_width + kern_width);
                             }
 
-                            // @TODO: See about single channel texture format
-                            packed_glyph->image.pixel_format = PixelFormat_BGRA8;
-                            packed_glyph->image.w = w;
-                            packed_glyph->image.h = h;
-                            packed_glyph->image.align = vec2(-scaled_left_side_bearing, cast(f32) iy1) / vec2(w, h);
-                            packed_glyph->image.scale = vec2(rcp_oversample_amount, rcp_oversample_amount);
+                            if (!glyph->w || !glyph->h) {
+                                end_temporary_memory(glyph_temp);
+                                continue;
+                            }
+
+                            glyph->align = vec2(-scaled_left_side_bearing, cast(f32) iy1) / vec2(w, h);
 
-                            u32 pitch = sizeof(u32)*packed_glyph->image.w;
-                            u32 out_glyph_size = packed_glyph->image.h*pitch;
-                            u8* out_glyph = cast(u8*) push_size(&global_arena, out_glyph_size);
+                            // @Note: The atlas is bottom up like every other image, so the glyph's top row goes in last
+                            u32 pitch = FONT_ATLAS_PAGE_SIZE;
+                            u32 atlas_x = round_f32_to_u32(glyph->min_uv.x*FONT_ATLAS_PAGE_SIZE);
+                            u32 atlas_y = round_f32_to_u32(glyph->min_uv.y*FONT_ATLAS_PAGE_SIZE);
+                            u32* page_pixels = atlas_pixels + glyph->atlas_page*atlas_page_pixel_count;
 
                             u8* source = stb_glyph;
-                            u8* dest_row = out_glyph + (packed_glyph->image.h - 1)*pitch;
-                            for (u32 y = 0; y < packed_glyph->image.h; y++) {
-                                u32* dest_pixel = cast(u32*) dest_row;
-                                for (u32 x = 0; x < packed_glyph->image.w; x++) {
+                            u32* dest_row = page_pixels + (atlas_y + glyph->h - 1)*pitch + atlas_x;
+                            for (u32 y = 0; y < glyph->h; y++) {
+                                u32* dest_pixel = dest_row;
+                                for (u32 x = 0; x < glyph->w; x++) {
                                     u8 alpha = *source++;
 #if GAMMA_CORRECT_FONTS
                                     u8 color = cast(u8) (255.0f*square_root(cast(f32) alpha / 255.0f));
@@ -690,17 +792,30 @@ int main(int argument_count, char** arguments) {
                                 }
                                 dest_row -= pitch;
                             }
-                            fwrite(out_glyph, out_glyph_size, 1, out);
 
                             end_temporary_memory(glyph_temp);
                         }
 
                         u32 end_position = ftell(out);
-                        fseek(out, kerning_table_position, SEEK_SET);
+                        fseek(out, glyph_table_position, SEEK_SET);
+                        fwrite(glyph_table, glyph_table_size, 1, out);
                         fwrite(kerning_table, kerning_table_size, 1, out);
                         fseek(out, end_position, SEEK_SET);
 
-                        fprintf(stderr, "Packed %d glyphs for '%s'\n", glyph_count, asset_desc->asset_name);
+                        // @TODO: See about single channel texture format
+                        for (u32 page_index = 0; page_index < atlas_page_count; page_index++) {
+                            PackedAsset* packed_page = asset_catalog + atlas_pages[page_index].value;
+                            packed_page->type = AssetType_Image;
+                            packed_page->data_offset = ftell(out) - header.asset_data;
+                            packed_page->image.pixel_format = PixelFormat_BGRA8;
+                            packed_page->image.w = FONT_ATLAS_PAGE_SIZE;
+                            packed_page->image.h = FONT_ATLAS_PAGE_SIZE;
+                            packed_page->image.align = vec2(0, 0);
+                            packed_page->image.scale = vec2(rcp_oversample_amount, rcp_oversample_amount);
+
+                            fwrite(atlas_pixels + page_index*atlas_page_pixel_count, sizeof(u32)*atlas_page_pixel_count, 1, out);
+                        }
+
                     } break;
 
                     case AssetDataType_Midi: {
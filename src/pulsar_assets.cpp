@@ -4,7 +4,7 @@ internal void load_assets(Assets* assets, MemoryArena* arena, char* file_name) {
     if (asset_file.size > 0) {
         AssetPackHeader* header = cast(AssetPackHeader*) asset_file.data;
         assert(header->magic_value == ASSET_PACK_CODE('p', 'l', 'a', 'f'));
-        assert(header->version == 0);
+        assert(header->version == ASSET_PACK_VERSION);
 
         assets->asset_count = header->asset_count;
         assets->asset_catalog = push_array(arena, assets->asset_count, Asset, no_clear());
@@ -19,6 +19,7 @@ internal void load_assets(Assets* assets, MemoryArena* arena, char* file_name) {
 
             dest_asset->name.data = name_store + source_asset->name_offset;
             dest_asset->name.len  = cstr_length(dest_asset->name.data);
+            dest_asset->next_asset_with_same_name = 0;
             // @Note: Not actually necessary, but nice for type safety I guess
             // @TODO: Make asset type checking compile out in release?
             dest_asset->type = source_asset->type;
@@ -45,8 +46,9 @@ internal void load_assets(Assets* assets, MemoryArena* arena, char* file_name) {
                     Font* font = &dest_asset->font;
                     font->packed_font = source_asset->font;
                     u32 glyph_count = font->one_past_last_codepoint - font->first_codepoint;
-                    font->glyph_table = cast(ImageID*) (assets->asset_data + source_asset->data_offset);
-                    font->kerning_table = cast(f32*) (font->glyph_table + sizeof(ImageID)*glyph_count);
+                    font->atlas_pages = cast(ImageID*) (assets->asset_data + source_asset->data_offset);
+                    font->glyph_table = cast(PackedGlyph*) (font->atlas_pages + font->atlas_page_count);
+                    font->kerning_table = cast(f32*) (font->glyph_table + glyph_count);
                 } break;
 
                 case AssetType_Midi: {
@@ -62,6 +64,18 @@ internal void load_assets(Assets* assets, MemoryArena* arena, char* file_name) {
                 } break;
             }
         }
+
+        // @Note: Built back to front, so assets that share a name stay chained in catalog order
+        initialize_hash_table(&assets->asset_name_table, allocator(arena_allocator, arena), 2*assets->asset_count);
+        for (u32 reverse_index = 1; reverse_index < assets->asset_count; reverse_index++) {
+            u32 asset_index = assets->asset_count - reverse_index;
+            Asset* asset = assets->asset_catalog + asset_index;
+            if (asset->name.len) {
+                u32* first_asset_index = hash_table_add(&assets->asset_name_table, asset->name);
+                asset->next_asset_with_same_name = *first_asset_index;
+                *first_asset_index = asset_index;
+            }
+        }
     } else {
         // @TODO: Elegant handling of asset file errors
         INVALID_CODE_PATH;
@@ -71,14 +85,15 @@ internal void load_assets(Assets* assets, MemoryArena* arena, char* file_name) {
 inline AssetID get_asset_id_by_name(Assets* assets, String name, AssetType asset_type = AssetType_Unknown) {
     AssetID result = { 0 };
 
-    for (u32 asset_index = 1; asset_index < assets->asset_count; asset_index++) {
+    u32* first_asset_index = hash_table_find(&assets->asset_name_table, name);
+    u32 asset_index = first_asset_index ? *first_asset_index : 0;
+    while (asset_index) {
         Asset* asset = assets->asset_catalog + asset_index;
-        if (asset->name.len && strings_are_equal(asset->name, name)) {
-            if (asset_type == AssetType_Unknown || asset->type == asset_type) {
-                result = { asset_index };
-                break;
-            }
+        if (asset_type == AssetType_Unknown || asset->type == asset_type) {
+            result = { asset_index };
+            break;
         }
+        asset_index = asset->next_asset_with_same_name;
     }
 
     if (!result.value) {
@@ -208,16 +223,28 @@ inline b32 in_font_range(Font* font, u32 codepoint) {
     return result;
 }
 
-inline ImageID get_glyph_id_for_codepoint(Font* font, u32 codepoint) {
-    u32 glyph_table_index = codepoint - font->first_codepoint;
-    u32 glyph_count = font->one_past_last_codepoint - font->first_codepoint;
-    ImageID result = { 0 };
+inline PackedGlyph* get_glyph_for_codepoint(Font* font, u32 codepoint) {
+    PackedGlyph* result = 0;
     if (in_font_range(font, codepoint)) {
-        result = font->glyph_table[glyph_table_index];
+        result = font->glyph_table + (codepoint - font->first_codepoint);
     }
     return result;
 }
 
+inline Image* get_glyph_atlas_page(Assets* assets, Font* font, PackedGlyph* glyph) {
+    Image* result = 0;
+    if (glyph->atlas_page < font->atlas_page_count) {
+        result = get_image(assets, font->atlas_pages[glyph->atlas_page]);
+    }
+    return result;
+}
+
+inline AxisAlignedBox2 get_aligned_glyph_aab(Font* font, PackedGlyph* glyph) {
+    v2 dim = vec2(glyph->w, glyph->h) / cast(f32) font->oversample_amount;
+    AxisAlignedBox2 result = aab_min_dim(-glyph->align*dim, dim);
+    return result;
+}
+
 inline f32 get_advance_for_codepoint_pair(Font* font, u32 c1, u32 c2) {
     u32 g1 = c1 - font->first_codepoint;
     u32 g2 = c2 - font->first_codepoint;
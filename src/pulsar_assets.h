@@ -11,7 +11,8 @@ struct Image;
 
 struct Font {
     using_struct(PackedFont, packed_font);
-    ImageID* glyph_table;
+    ImageID* atlas_pages;
+    PackedGlyph* glyph_table;
     f32* kerning_table;
 };
 
@@ -35,12 +36,17 @@ struct Asset {
     };
     String name;
     AssetType type;
+
+    u32 next_asset_with_same_name;
 };
 
 struct Assets {
     u32 asset_count;
     Asset* asset_catalog;
 
+    // @Note: Maps a name to the first asset with that name, the rest are chained through next_asset_with_same_name
+    HashTable<String, u32> asset_name_table;
+
     u8* asset_data;
 };
 
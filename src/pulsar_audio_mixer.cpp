@@ -1,7 +1,7 @@
 inline void initialize_audio_mixer(AudioMixer* mixer, MemoryArena* permanent_arena) {
     mixer->arena = permanent_arena;
     mixer->first_audio_group = 0;
-    mixer->first_free_playing_sound = 0;
+    initialize_pool(&mixer->playing_sounds, permanent_arena);
     mixer->master_volume[0] = 1.0f;
     mixer->master_volume[1] = 1.0f;
 }
@@ -16,46 +16,49 @@ inline void initialize_audio_group(AudioGroup* group, AudioMixer* mixer) {
     group->volume.target_volume[1]  = 1.0f;
     group->volume_on_unpause[0] = group->volume.current_volume[0];
     group->volume_on_unpause[1] = group->volume.current_volume[1];
-    group->first_playing_sound = 0;
+    group->playing_sound_count = 0;
 
     group->next_audio_group = mixer->first_audio_group;
     mixer->first_audio_group = group;
 }
 
+// @Note: Returns null if there are too many sounds playing already, the sound just doesn't play then
 inline PlayingSound* play_sound_internal(AudioGroup* group, v2 starting_volume, u32 flags = 0) {
     AudioMixer* mixer = group->mixer;
 
-    if (!mixer->first_free_playing_sound) {
-        mixer->first_free_playing_sound = push_struct(mixer->arena, PlayingSound);
-        mixer->first_free_playing_sound->next = 0;
+    Handle<PlayingSound> handle;
+    PlayingSound* playing_sound = pool_alloc(&mixer->playing_sounds, &handle);
+    if (!playing_sound) {
+        return 0;
     }
 
-    PlayingSound* playing_sound = mixer->first_free_playing_sound;
-    mixer->first_free_playing_sound = playing_sound->next;
-
-    *playing_sound = {};
+    playing_sound->handle = handle;
+    playing_sound->group = group;
     playing_sound->playback_rate = 1.0f;
     playing_sound->volume.current_volume[0] = starting_volume.x;
     playing_sound->volume.current_volume[1] = starting_volume.y;
     playing_sound->flags = flags;
 
-    playing_sound->next = group->first_playing_sound;
-    group->first_playing_sound = playing_sound;
+    group->playing_sound_count++;
 
     return playing_sound;
 }
 
 inline PlayingSound* play_sound(AudioGroup* group, Sound* sound, v2 starting_volume = vec2(0.5f, 0.5f), u32 flags = 0) {
     PlayingSound* playing_sound = play_sound_internal(group, starting_volume, flags);
-    playing_sound->source_type = SoundSource_Sound;
-    playing_sound->sound = sound;
+    if (playing_sound) {
+        playing_sound->source_type = SoundSource_Sound;
+        playing_sound->sound = sound;
+    }
     return playing_sound;
 }
 
 inline PlayingSound* play_synth(AudioGroup* group, Synth* synth, v2 starting_volume = vec2(0.5f, 0.5f), u32 flags = 0) {
     PlayingSound* playing_sound = play_sound_internal(group, starting_volume, flags);
-    playing_sound->source_type = SoundSource_Synth;
-    playing_sound->synth = synth;
+    if (playing_sound) {
+        playing_sound->source_type = SoundSource_Synth;
+        playing_sound->synth = synth;
+    }
     return playing_sound;
 }
 
@@ -87,6 +90,18 @@ inline void change_volume(PlayingSound* sound, f32 t, v2 target_volume) {
     change_volume(&sound->volume, t, target_volume);
 }
 
+inline PlayingSound* get_playing_sound(AudioMixer* mixer, Handle<PlayingSound> handle) {
+    PlayingSound* result = pool_get(&mixer->playing_sounds, handle);
+    return result;
+}
+
+inline void change_volume(AudioMixer* mixer, Handle<PlayingSound> handle, f32 t, v2 target_volume) {
+    PlayingSound* sound = get_playing_sound(mixer, handle);
+    if (sound) {
+        change_volume(sound, t, target_volume);
+    }
+}
+
 inline void change_volume(AudioGroup* group, f32 t, v2 target_volume) {
     change_volume(&group->volume, t, target_volume);
     group->volume_on_unpause[0] = target_volume.e[0];
@@ -110,24 +125,30 @@ inline void change_playback_rate(PlayingSound* sound, f32 playback_rate) {
     sound->playback_rate = clamp(playback_rate, 0.1f, 32.0f);
 }
 
+inline void stop_sound(AudioMixer* mixer, u32 live_index) {
+    PlayingSound* playing_sound = pool_get_live(&mixer->playing_sounds, live_index);
+    assert(playing_sound->group->playing_sound_count > 0);
+    playing_sound->group->playing_sound_count--;
+    pool_free_live(&mixer->playing_sounds, live_index);
+}
+
 inline void stop_all_sounds(AudioGroup* group) {
     AudioMixer* mixer = group->mixer;
-
-    PlayingSound* last_playing_sound = group->first_playing_sound;
-    if (last_playing_sound) {
-        while (last_playing_sound->next) {
-            last_playing_sound = last_playing_sound->next;
+    for (u32 live_index = 0; live_index < mixer->playing_sounds.live_count;) {
+        PlayingSound* playing_sound = pool_get_live(&mixer->playing_sounds, live_index);
+        if (playing_sound->group == group) {
+            stop_sound(mixer, live_index);
+        } else {
+            live_index++;
         }
-        last_playing_sound->next = mixer->first_free_playing_sound;
-        mixer->first_free_playing_sound = group->first_playing_sound;
-        group->first_playing_sound = 0;
     }
 }
 
 inline void stop_all_sounds(AudioMixer* mixer) {
     for (AudioGroup* group = mixer->first_audio_group; group; group = group->next_audio_group) {
-        stop_all_sounds(group);
+        group->playing_sound_count = 0;
     }
+    clear_pool(&mixer->playing_sounds);
 }
 
 inline f32 get_volume_for_sample_offset(SoundVolume volume, u32 channel, u32 sample_rate, u32 sample_offset) {
@@ -141,18 +162,104 @@ inline f32 get_volume_for_sample_offset(SoundVolume volume, u32 channel, u32 sam
     return result;
 }
 
-internal void output_playing_sounds(AudioMixer* mixer, GameSoundOutputBuffer* sound_buffer, MemoryArena* temp_arena) {
+inline u64 get_playback_phase(PlayingSound* playing_sound) {
+    u64 result = (cast(u64) playing_sound->samples_played << 32) | playing_sound->sample_fraction;
+    return result;
+}
+
+inline void set_playback_phase(PlayingSound* playing_sound, u64 phase) {
+    playing_sound->samples_played = cast(u32) (phase >> 32);
+    playing_sound->sample_fraction = cast(u32) phase;
+}
+
+// @Note: How far the phase moves per output frame
+inline u64 get_playback_phase_step(f32 playback_rate) {
+    u64 result = cast(u64) (cast(f64) max(0.0f, playback_rate)*4294967296.0);
+    return result;
+}
+
+// @Note: What the sound's channels get multiplied by frame_offset frames into the buffer being written
+inline v2 get_playing_sound_gain(PlayingSound* playing_sound, AudioGroup* group, u32 sample_rate, u32 frame_offset) {
+    v2 result;
+    for (u32 channel = 0; channel < 2; channel++) {
+        f32 volume = get_volume_for_sample_offset(playing_sound->volume, channel, sample_rate, frame_offset);
+        f32 group_volume = group->mix_volume[channel]*get_volume_for_sample_offset(group->volume, channel, sample_rate, frame_offset);
+        result.e[channel] = group_volume*volume;
+    }
+    return result;
+}
+
+// @Note: Adds frame_count frames of a stereo sound to dest, starting at phase and moving by phase_step every frame, which
+// have to stay inside the sound. Samples are picked, not interpolated. The gains go in a straight line from gain, by
+// gain_step per frame.
+internal void mix_sound_frames(f32* dest0, f32* dest1, s16* source0, s16* source1, u32 frame_count, u64 phase, u64 phase_step, v2 gain, v2 gain_step) {
+    // @Note: Folding the s16 to f32 scale into the gains saves a multiply per sample
+    f32 to_float = 1.0f / cast(f32) INT16_MAX;
+    gain *= to_float;
+    gain_step *= to_float;
+
+    __m128 lane_offsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    __m128 gain0 = _mm_add_ps(_mm_set1_ps(gain.x), _mm_mul_ps(lane_offsets, _mm_set1_ps(gain_step.x)));
+    __m128 gain1 = _mm_add_ps(_mm_set1_ps(gain.y), _mm_mul_ps(lane_offsets, _mm_set1_ps(gain_step.y)));
+    __m128 gain0_step = _mm_set1_ps(4.0f*gain_step.x);
+    __m128 gain1_step = _mm_set1_ps(4.0f*gain_step.y);
+
+    u32 frame_index = 0;
+    if (phase_step == (cast(u64) 1 << 32)) {
+        // @Note: Playing at the sound's own rate, so the samples are in a row
+        s16* at0 = source0 + (phase >> 32);
+        s16* at1 = source1 + (phase >> 32);
+        for (; frame_index + 4 <= frame_count; frame_index += 4) {
+            __m128i samples0 = _mm_loadl_epi64(cast(__m128i*) (at0 + frame_index));
+            __m128i samples1 = _mm_loadl_epi64(cast(__m128i*) (at1 + frame_index));
+            __m128 value0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples0, samples0), 16));
+            __m128 value1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples1, samples1), 16));
+
+            _mm_storeu_ps(dest0 + frame_index, _mm_add_ps(_mm_loadu_ps(dest0 + frame_index), _mm_mul_ps(value0, gain0)));
+            _mm_storeu_ps(dest1 + frame_index, _mm_add_ps(_mm_loadu_ps(dest1 + frame_index), _mm_mul_ps(value1, gain1)));
+
+            gain0 = _mm_add_ps(gain0, gain0_step);
+            gain1 = _mm_add_ps(gain1, gain1_step);
+        }
+    } else {
+        for (; frame_index + 4 <= frame_count; frame_index += 4) {
+            u64 frame_phase = phase + frame_index*phase_step;
+            u32 index0 = cast(u32) (frame_phase >> 32);
+            u32 index1 = cast(u32) ((frame_phase +   phase_step) >> 32);
+            u32 index2 = cast(u32) ((frame_phase + 2*phase_step) >> 32);
+            u32 index3 = cast(u32) ((frame_phase + 3*phase_step) >> 32);
+
+            __m128 value0 = _mm_setr_ps(cast(f32) source0[index0], cast(f32) source0[index1], cast(f32) source0[index2], cast(f32) source0[index3]);
+            __m128 value1 = _mm_setr_ps(cast(f32) source1[index0], cast(f32) source1[index1], cast(f32) source1[index2], cast(f32) source1[index3]);
+
+            _mm_storeu_ps(dest0 + frame_index, _mm_add_ps(_mm_loadu_ps(dest0 + frame_index), _mm_mul_ps(value0, gain0)));
+            _mm_storeu_ps(dest1 + frame_index, _mm_add_ps(_mm_loadu_ps(dest1 + frame_index), _mm_mul_ps(value1, gain1)));
+
+            gain0 = _mm_add_ps(gain0, gain0_step);
+            gain1 = _mm_add_ps(gain1, gain1_step);
+        }
+    }
+
+    for (; frame_index < frame_count; frame_index++) {
+        u32 sample_index = cast(u32) ((phase + frame_index*phase_step) >> 32);
+        dest0[frame_index] += (gain.x + gain_step.x*cast(f32) frame_index)*cast(f32) source0[sample_index];
+        dest1[frame_index] += (gain.y + gain_step.y*cast(f32) frame_index)*cast(f32) source1[sample_index];
+    }
+}
+
+internal void output_playing_sounds(AudioMixer* mixer, GameSoundOutputBuffer* sound_buffer) {
     // @TODO: Formalize the handling of channels in the mixer.
     // @TODO: I think the having to output speculative audio versus making canonical changes has a risk of spiraling
     // into error prone complexity. It would be nice to use the same code paths wherever possible.
     // @TODO: Linear interpolation for varyin playback rates
 
-    TemporaryMemory mixer_memory = begin_temporary_memory(temp_arena);
+    TemporaryMemory scratch = get_scratch();
 
     u32 sample_count = sound_buffer->samples_to_write;
+    u32 sample_rate = sound_buffer->sample_rate;
 
-    f32* float_channel0 = push_array(temp_arena, sample_count, f32);
-    f32* float_channel1 = push_array(temp_arena, sample_count, f32);
+    f32* float_channel0 = push_array(scratch.arena, sample_count, f32, align(16, true));
+    f32* float_channel1 = push_array(scratch.arena, sample_count, f32, align(16, true));
 
     for (AudioGroup* group = mixer->first_audio_group; group; group = group->next_audio_group) {
         if (group->paused) {
@@ -161,7 +268,7 @@ internal void output_playing_sounds(AudioMixer* mixer, GameSoundOutputBuffer* so
 
         b32 all_channels_quiet = true;
         for (u32 channel = 0; channel < 2; channel++) {
-            group->volume.current_volume[channel] = get_volume_for_sample_offset(group->volume, channel, sound_buffer->sample_rate, sound_buffer->samples_committed);
+            group->volume.current_volume[channel] = get_volume_for_sample_offset(group->volume, channel, sample_rate, sound_buffer->samples_committed);
             if (group->volume.current_volume[channel] > 0.0f) {
                 all_channels_quiet = false;
             }
@@ -170,141 +277,144 @@ internal void output_playing_sounds(AudioMixer* mixer, GameSoundOutputBuffer* so
         if (group->pause_requested && all_channels_quiet) {
             group->pause_requested = false;
             group->paused = true;
-            continue;
         }
+    }
 
-        for (PlayingSound** playing_sound_ptr = &group->first_playing_sound; *playing_sound_ptr;) {
-            PlayingSound* playing_sound = *playing_sound_ptr;
+    Pool<PlayingSound>* playing_sounds = &mixer->playing_sounds;
+    for (u32 live_index = 0; live_index < playing_sounds->live_count;) {
+        PlayingSound* playing_sound = pool_get_live(playing_sounds, live_index);
+        AudioGroup* group = playing_sound->group;
 
-            f32 playback_rate = game_config->simulation_rate*playing_sound->playback_rate;
+        if (group->paused) {
+            live_index++;
+            continue;
+        }
 
-            b32 sound_finished = false;
-            b32 looping = playing_sound->flags & Playback_Looping;
+        u64 phase_step = get_playback_phase_step(game_config->simulation_rate*playing_sound->playback_rate);
 
-            if (playing_sound->initialized) {
-                // @Incomplete: With this approach, if left unaccounted for, midi sync will have a 1 frame delay
-                // @Incomplete: This approach as-is will not work with a smooth variable playback rate (maths may be able to get to the rescue)
-                playing_sound->samples_played += cast(u32) (cast(f32) sound_buffer->samples_committed*playback_rate);
+        b32 sound_finished = false;
+        b32 looping = playing_sound->flags & Playback_Looping;
 
-                for (u32 channel = 0; channel < 2; channel++) {
-                    playing_sound->volume.current_volume[channel] =
-                        get_volume_for_sample_offset(playing_sound->volume, channel, sound_buffer->sample_rate, sound_buffer->samples_committed);
-                }
-            } else {
-                playing_sound->samples_played = 0;
-                playing_sound->initialized = true;
-            }
+        if (playing_sound->initialized) {
+            // @Incomplete: With this approach, if left unaccounted for, midi sync will have a 1 frame delay
+            // @Incomplete: This approach as-is will not work with a smooth variable playback rate (maths may be able to get to the rescue)
+            set_playback_phase(playing_sound, get_playback_phase(playing_sound) + sound_buffer->samples_committed*phase_step);
 
-            if (playing_sound->synced_midi) {
-                // @Note: This is here for the sake of handling looping correctly, but I don't like it. I want to move this
-                // out of the mixer. Or midi into the mixer entirely.
-                playing_sound->synced_midi->tick_timer = playing_sound->samples_played;
+            for (u32 channel = 0; channel < 2; channel++) {
+                playing_sound->volume.current_volume[channel] =
+                    get_volume_for_sample_offset(playing_sound->volume, channel, sample_rate, sound_buffer->samples_committed);
             }
+        } else {
+            set_playback_phase(playing_sound, 0);
+            playing_sound->initialized = true;
+        }
 
-            if (playing_sound->source_type == SoundSource_Sound) {
-                Sound* sound = playing_sound->sound;
+        if (playing_sound->source_type == SoundSource_Sound) {
+            Sound* sound = playing_sound->sound;
 
-                if (sound) {
-                    if (looping) {
-                        if (playing_sound->samples_played >= sound->sample_count) {
-                            playing_sound->samples_played %= sound->sample_count;
-                        }
-                    } else if (playing_sound->samples_played >= sound->sample_count) {
-                        playing_sound->samples_played = sound->sample_count;
-                        sound_finished = true;
+            if (sound && sound->sample_count) {
+                if (looping) {
+                    if (playing_sound->samples_played >= sound->sample_count) {
+                        set_playback_phase(playing_sound, get_playback_phase(playing_sound) % (cast(u64) sound->sample_count << 32));
                     }
-                } else {
+                } else if (playing_sound->samples_played >= sound->sample_count) {
+                    set_playback_phase(playing_sound, cast(u64) sound->sample_count << 32);
                     sound_finished = true;
                 }
             } else {
-                assert(playing_sound->source_type == SoundSource_Synth);
-                if (!playing_sound->synth) {
-                    sound_finished = true;
-                }
+                sound_finished = true;
             }
+        } else {
+            assert(playing_sound->source_type == SoundSource_Synth);
+            if (!playing_sound->synth) {
+                sound_finished = true;
+            }
+        }
 
-            if (sound_finished) {
-                *playing_sound_ptr = playing_sound->next;
-                playing_sound->next = mixer->first_free_playing_sound;
-                mixer->first_free_playing_sound = playing_sound;
-            } else {
-                u32 samples_played = playing_sound->samples_played;
-                u32 total_samples_to_mix = sound_buffer->samples_to_write;
-
-                f32* dest0 = float_channel0;
-                f32* dest1 = float_channel1;
-                f32* dest[2] = { dest0, dest1 };
-
-                if (playing_sound->source_type == SoundSource_Sound) {
-                    Sound* sound = playing_sound->sound;
+        if (sound_finished) {
+            stop_sound(mixer, live_index);
+        } else {
+            v2 gain = get_playing_sound_gain(playing_sound, group, sample_rate, 0);
 
-                    while (sound && total_samples_to_mix > 0) {
-                        if (looping) {
-                            if (samples_played >= sound->sample_count) {
-                                samples_played %= sound->sample_count;
-                            }
-                        }
+            if (playing_sound->source_type == SoundSource_Sound) {
+                Sound* sound = playing_sound->sound;
 
-                        assert(playing_sound->samples_played >= 0 && playing_sound->samples_played < sound->sample_count);
+                // @Note: Mono sounds go to both channels
+                s16* source0 = sound->samples;
+                s16* source1 = (sound->channel_count > 1) ? sound->samples + sound->sample_count : sound->samples;
 
-                        u32 samples_to_mix = total_samples_to_mix;
-                        u32 samples_remaining_in_sound = looping ? sound->sample_count : sound->sample_count - playing_sound->samples_played;
+                u64 sound_end = cast(u64) sound->sample_count << 32;
+                u64 phase = get_playback_phase(playing_sound);
 
+                u32 frame_index = 0;
+                while (frame_index < sample_count) {
+                    if (phase >= sound_end) {
                         if (!looping) {
-                            if (samples_to_mix > samples_remaining_in_sound) {
-                                samples_to_mix = samples_remaining_in_sound;
-                            }
+                            break;
                         }
+                        phase %= sound_end;
+                    }
 
-                        for (u32 sample_index = 0; sample_index < samples_to_mix; sample_index++) {
-                            u32 adjusted_sample_index = cast(u32) (cast(f32) sample_index*playback_rate);
-                            u32 mapped_sample_index = (samples_played + adjusted_sample_index) % sound->sample_count;
-
-                            for (u32 channel = 0; channel < sound->channel_count; channel++) {
-                                f32 volume = get_volume_for_sample_offset(playing_sound->volume, channel, sound_buffer->sample_rate, adjusted_sample_index);
-                                f32 group_volume = group->mix_volume[channel]*get_volume_for_sample_offset(group->volume, channel, sound_buffer->sample_rate, adjusted_sample_index);
-
-                                f32 sample_value = cast(f32) (sound->samples + sound->sample_count*channel)[mapped_sample_index];
-                                *dest[channel]++ += group_volume*volume*(sample_value / cast(f32) INT16_MAX);
-                            }
-                        }
+                    u32 block_frame_count = MIN(MIXER_BLOCK_FRAME_COUNT, sample_count - frame_index);
+                    if (phase + (block_frame_count - 1)*phase_step >= sound_end) {
+                        block_frame_count = cast(u32) ((sound_end - phase + phase_step - 1) / phase_step);
+                    }
 
-                        assert(total_samples_to_mix >= samples_to_mix);
-                        total_samples_to_mix -= samples_to_mix;
+                    v2 end_gain = get_playing_sound_gain(playing_sound, group, sample_rate, frame_index + block_frame_count);
+                    v2 gain_step = (end_gain - gain) / cast(f32) block_frame_count;
 
-                        samples_played += cast(u32) (cast(f32) samples_to_mix*playback_rate);
+                    mix_sound_frames(float_channel0 + frame_index, float_channel1 + frame_index, source0, source1, block_frame_count, phase, phase_step, gain, gain_step);
 
-                        if (!looping && samples_to_mix >= samples_remaining_in_sound) {
-                            break;
-                        }
-                    }
-                } else {
-                    assert(playing_sound->source_type == SoundSource_Synth);
-                    for (u32 sample_index = 0; sample_index < total_samples_to_mix; sample_index++) {
-                        // @TODO: Formalize channels
-                        for (u32 channel = 0; channel < 2; channel++) {
-                            f32 volume = get_volume_for_sample_offset(playing_sound->volume, channel, sound_buffer->sample_rate, sample_index);
-                            f32 group_volume = group->mix_volume[channel]*get_volume_for_sample_offset(group->volume, channel, sound_buffer->sample_rate, sample_index);
-                            // @TODO: Decide on a way synths can communicate they're done playing
-                            *dest[channel]++ += volume*group_volume*playing_sound->synth(2, channel, sound_buffer->sample_rate, samples_played + sample_index, 440.0f);
-                        }
-                    }
+                    phase += block_frame_count*phase_step;
+                    frame_index += block_frame_count;
+                    gain = end_gain;
                 }
+            } else {
+                assert(playing_sound->source_type == SoundSource_Synth);
+                u32 samples_played = playing_sound->samples_played;
+                for (u32 block_first_frame = 0; block_first_frame < sample_count; block_first_frame += MIXER_BLOCK_FRAME_COUNT) {
+                    u32 block_frame_count = MIN(MIXER_BLOCK_FRAME_COUNT, sample_count - block_first_frame);
+
+                    v2 end_gain = get_playing_sound_gain(playing_sound, group, sample_rate, block_first_frame + block_frame_count);
+                    v2 gain_step = (end_gain - gain) / cast(f32) block_frame_count;
+
+                    for (u32 frame_index = 0; frame_index < block_frame_count; frame_index++) {
+                        u32 sample_index = samples_played + block_first_frame + frame_index;
+                        v2 frame_gain = gain + gain_step*cast(f32) frame_index;
+                        // @TODO: Decide on a way synths can communicate they're done playing
+                        float_channel0[block_first_frame + frame_index] += frame_gain.x*playing_sound->synth(2, 0, sample_rate, sample_index, 440.0f);
+                        float_channel1[block_first_frame + frame_index] += frame_gain.y*playing_sound->synth(2, 1, sample_rate, sample_index, 440.0f);
+                    }
 
-                playing_sound_ptr = &playing_sound->next;
+                    gain = end_gain;
+                }
             }
+
+            live_index++;
         }
     }
 
-    // @Note: Convert to 16 bit and output to sound buffer
+    // @Note: Convert to 16 bit and output to sound buffer, interleaving the channels
     // @TODO: Dither
-    f32* source0 = float_channel0;
-    f32* source1 = float_channel1;
+    __m128 master_volume0 = _mm_set1_ps(INT16_MAX*mixer->master_volume[0]);
+    __m128 master_volume1 = _mm_set1_ps(INT16_MAX*mixer->master_volume[1]);
+    __m128 max_value = _mm_set1_ps(cast(f32) INT16_MAX);
+    __m128 min_value = _mm_set1_ps(-cast(f32) INT16_MAX);
+
     s16* sample_out = sound_buffer->samples;
-    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
-        *sample_out++ = cast(s16) (INT16_MAX*clamp(mixer->master_volume[0]*(*source0++), -1.0f, 1.0f));
-        *sample_out++ = cast(s16) (INT16_MAX*clamp(mixer->master_volume[1]*(*source1++), -1.0f, 1.0f));
+    u32 sample_index = 0;
+    for (; sample_index + 4 <= sample_count; sample_index += 4) {
+        __m128 value0 = _mm_min_ps(max_value, _mm_max_ps(min_value, _mm_mul_ps(master_volume0, _mm_load_ps(float_channel0 + sample_index))));
+        __m128 value1 = _mm_min_ps(max_value, _mm_max_ps(min_value, _mm_mul_ps(master_volume1, _mm_load_ps(float_channel1 + sample_index))));
+        __m128i packed0 = _mm_packs_epi32(_mm_cvttps_epi32(value0), _mm_setzero_si128());
+        __m128i packed1 = _mm_packs_epi32(_mm_cvttps_epi32(value1), _mm_setzero_si128());
+        _mm_storeu_si128(cast(__m128i*) (sample_out + 2*sample_index), _mm_unpacklo_epi16(packed0, packed1));
+    }
+
+    for (; sample_index < sample_count; sample_index++) {
+        sample_out[2*sample_index + 0] = cast(s16) (INT16_MAX*clamp(mixer->master_volume[0]*float_channel0[sample_index], -1.0f, 1.0f));
+        sample_out[2*sample_index + 1] = cast(s16) (INT16_MAX*clamp(mixer->master_volume[1]*float_channel1[sample_index], -1.0f, 1.0f));
     }
 
-    end_temporary_memory(mixer_memory);
+    release_scratch(scratch);
 }
@@ -17,6 +17,10 @@ enum SoundSourceType {
 #define SOUND_SYNTH(name) f32 name(u32 channel_count, u32 channel_index, u32 sample_rate, u32 sample_index, f32 pitch)
 typedef SOUND_SYNTH(Synth);
 
+// @Note: Sounds get mixed a block of frames at a time. Blocks stop at the end of the sound, so the sample positions in a
+// block never wrap, and a sound's gain goes in a straight line from the start of each block to its end.
+#define MIXER_BLOCK_FRAME_COUNT 32
+
 struct SoundVolume {
     f32 current_volume[2];
     f32 dv_over_t[2];
@@ -24,12 +28,18 @@ struct SoundVolume {
 };
 
 struct PlayingSound {
+    Handle<PlayingSound> handle;
+    struct AudioGroup* group;
+
     b32 initialized;
 
     SoundVolume volume;
 
     f32 playback_rate;
+
+    // @Note: Together a 32.32 fixed point position in the sound, so playback rates that aren't whole numbers don't drift
     u32 samples_played;
+    u32 sample_fraction;
 
     u32 flags;
 
@@ -38,10 +48,6 @@ struct PlayingSound {
         Sound* sound;
         Synth* synth;
     };
-
-    struct PlayingMidi* synced_midi; // Icky
-
-    PlayingSound* next;
 };
 
 struct AudioGroup {
@@ -54,7 +60,7 @@ struct AudioGroup {
     SoundVolume volume;
     f32 volume_on_unpause[2];
 
-    PlayingSound* first_playing_sound;
+    u32 playing_sound_count;
     AudioGroup* next_audio_group;
 };
 
@@ -64,7 +70,7 @@ struct AudioMixer {
     f32 master_volume[2];
 
     AudioGroup* first_audio_group;
-    PlayingSound* first_free_playing_sound;
+    Pool<PlayingSound> playing_sounds;
 };
 
 #endif /* AUDIO_MIXER_H */
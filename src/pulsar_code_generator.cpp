@@ -449,7 +449,7 @@ struct MetaEnum {
 };
 
 global Array<MetaType> meta_type_array;
-global Array<MetaStruct> meta_struct_array;
+global BucketArray<MetaStruct> meta_struct_array;
 global Array<MetaEnum> meta_enum_array;
 
 inline void add_meta_type_if_unique(Array<MetaType>* type_array, Token type_token) {
@@ -516,11 +516,11 @@ internal StructMember parse_member(Tokenizer* tokenizer, Token struct_type_token
 internal void parse_struct(Tokenizer* tokenizer, IntrospectionParams params) {
     Token name_token = get_token(tokenizer);
 
-    MetaStruct meta;
-    meta.name = name_token;
-    allocate_array(&meta.members, 8, general_allocator);
+    MetaStruct* meta = bucket_array_add(&meta_struct_array);
+    meta->name = name_token;
+    allocate_array(&meta->members, 8, general_allocator);
 
-    add_meta_type_if_unique(&meta_type_array, meta.name);
+    add_meta_type_if_unique(&meta_type_array, meta->name);
 
     if (match(tokenizer, '{')) {
         for (;;) {
@@ -533,14 +533,12 @@ internal void parse_struct(Tokenizer* tokenizer, IntrospectionParams params) {
                 break;
             } else {
                 StructMember member = parse_member(tokenizer, name_token, member_token);
-                array_add(&meta.members, member);
+                array_add(&meta->members, member);
             }
         }
     } else {
         error(tokenizer, "Expected '{' after struct declaration.");
     }
-
-    array_add(&meta_struct_array, meta);
 }
 
 internal void parse_enum(Tokenizer* tokenizer, IntrospectionParams params) {
@@ -617,13 +615,14 @@ inline void win32_initialize_perf_counter() {
 
 int main(int argument_count, char** arguments) {
     win32_initialize_perf_counter();
+    initialize_memory_kernels();
     LARGE_INTEGER start_clock = win32_get_clock();
 
     initialize_arena(&general_arena, MEGABYTES(128), malloc(MEGABYTES(128)));
 
     allocate_array(&meta_type_array, 8, general_allocator);
     allocate_array(&meta_enum_array, 8, general_allocator);
-    allocate_array(&meta_struct_array, 8, general_allocator);
+    allocate_bucket_array(&meta_struct_array, general_allocator);
 
     b32 finding_source = false;
 
@@ -733,8 +732,8 @@ int main(int argument_count, char** arguments) {
     }
     fprintf(pre_headers, "};\n\n");
 
-    for (size_t struct_index = 0; struct_index < meta_struct_array.count; struct_index++) {
-        MetaStruct meta = meta_struct_array.data[struct_index];
+    for (BucketIterator<MetaStruct> it = iterate_bucket_array(&meta_struct_array); it.item; advance_iterator(&it)) {
+        MetaStruct meta = *it.item;
         fprintf(pre_headers, "#define BodyOf_%.*s \\\n", PRINTF_TOKEN(meta.name));
         for (size_t member_index = 0; member_index < meta.members.count; member_index++) {
             StructMember member = meta.members.data[member_index];
@@ -790,8 +789,8 @@ int main(int argument_count, char** arguments) {
         }
     }
 
-    for (size_t struct_index = 0; struct_index < meta_struct_array.count; struct_index++) {
-        MetaStruct meta = meta_struct_array.data[struct_index];
+    for (BucketIterator<MetaStruct> it = iterate_bucket_array(&meta_struct_array); it.item; advance_iterator(&it)) {
+        MetaStruct meta = *it.item;
         fprintf(post_headers, "static MemberDefinition MembersOf_%.*s[] = {\n", PRINTF_TOKEN(meta.name));
         for (size_t member_index = 0; member_index < meta.members.count; member_index++) {
             StructMember member = meta.members.data[member_index];
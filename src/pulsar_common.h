@@ -113,6 +113,9 @@ define_saturating_cast(f64, f32, -FLT_MAX , FLT_MAX);
 #define introspect(...)
 
 #define PULSAR_MEMORY_MALLOC_ALLOCATOR 1
+#ifndef PULSAR_ARENA_INSTRUMENTATION
+#define PULSAR_ARENA_INSTRUMENTATION 0
+#endif
 #include "pulsar_memory.h"
 #include "pulsar_memory_arena.h"
 
@@ -48,12 +48,12 @@ internal CONSOLE_COMMAND(cc_repair_entity_guids) {
                     log_print(LogLevel_Warn, "Duplicate Entity ID { %u } repaired (indices %u vs %u)", inner->guid.value, outer_entity_index, inner_entity_index);
                     inner->guid.value = level->first_available_guid++;
 
+                    // @Note: Adding a slot can move the others, so each one is filled in before getting the next
                     EntityHash* outer_hash = get_entity_hash_slot(editor, outer->guid);
-                    EntityHash* inner_hash = get_entity_hash_slot(editor, inner->guid);
-
                     outer_hash->guid = outer->guid;
                     outer_hash->index = outer_entity_index;
 
+                    EntityHash* inner_hash = get_entity_hash_slot(editor, inner->guid);
                     inner_hash->guid = inner->guid;
                     inner_hash->index = inner_entity_index;
                 }
@@ -222,6 +222,67 @@ internal CONSOLE_COMMAND(cc_dump_config) {
     }
 }
 
+#if PULSAR_ARENA_INSTRUMENTATION
+internal CONSOLE_COMMAND(cc_dump_arena_stats) {
+    f64 mb = 1024.0*1024.0;
+
+    log_print(LogLevel_Info, "Arenas:");
+    for (u32 arena_index = 0; arena_index < arena_instrumentation.arena_count; arena_index++) {
+        MemoryArena* arena = arena_instrumentation.arenas[arena_index];
+        log_print(LogLevel_Info, "    %-12s size: %9.2fMB  used: %9.2fMB  committed: %9.2fMB  high water: %9.2fMB",
+            arena->debug_name ? arena->debug_name : "(unnamed)",
+            arena->size / mb, arena->used / mb, arena->committed / mb, arena->high_water / mb
+        );
+    }
+
+    u32 max_sites_to_show = 16;
+    u64 requested_site_count;
+    if (parse_u64(&arguments, &requested_site_count)) {
+        max_sites_to_show = saturating_cast_u64_u32(requested_site_count);
+    }
+
+    TemporaryMemory scratch = get_scratch();
+
+    u32 site_count = 0;
+    SortEntry* sites = push_array(scratch.arena, MAX_ARENA_CALL_SITES, SortEntry, no_clear());
+    SortEntry* sort_temp = push_array(scratch.arena, MAX_ARENA_CALL_SITES, SortEntry, no_clear());
+    for (u32 site_index = 0; site_index < MAX_ARENA_CALL_SITES; site_index++) {
+        ArenaCallSite* site = arena_instrumentation.call_sites + site_index;
+        if (site->file) {
+            SortEntry* entry = sites + site_count++;
+            entry->sort_key = site->bytes;
+            entry->index = site_index;
+        }
+    }
+
+    sort_entries(site_count, sites, sort_temp);
+
+    log_print(LogLevel_Info, "Top %u of %u call sites by bytes:", MIN(max_sites_to_show, site_count), site_count);
+    for (u32 sorted_index = 0; sorted_index < MIN(max_sites_to_show, site_count); sorted_index++) {
+        ArenaCallSite* site = arena_instrumentation.call_sites + sites[site_count - sorted_index - 1].index;
+        log_print(LogLevel_Info, "    %s %9.2fMB in %7I64u %s (peak %.2fKB)  %s(%u)",
+            site->kind == ArenaCallSite_Temp ? "temp" : "push",
+            site->bytes / mb, site->count,
+            site->kind == ArenaCallSite_Temp ? "blocks" : "pushes",
+            site->peak_bytes / 1024.0,
+            site->file, site->line
+        );
+    }
+
+    release_scratch(scratch);
+}
+#endif
+
+internal CONSOLE_COMMAND(cc_capture_sort_keys) {
+    game_state->capture_sort_keys = true;
+}
+
+internal CONSOLE_COMMAND(cc_capture_frames) {
+    u64 frame_count = 1;
+    parse_u64(&arguments, &frame_count);
+    begin_render_capture(&game_state->render_capture, saturating_cast_u64_u32(frame_count));
+}
+
 internal CONSOLE_COMMAND(cc_kill_player) {
     kill_player(game_state);
 }
@@ -273,6 +334,11 @@ global ConsoleCommand console_commands[] = {
     console_command(switch_game_mode, "Switch the gamemode."),
     console_command(set, "Set a config variable."),
     console_command(dump_config, "Dump the current config state."),
+#if PULSAR_ARENA_INSTRUMENTATION
+    console_command(dump_arena_stats, "Dump arena high-water marks and the heaviest allocation sites. Optionally takes how many sites to show."),
+#endif
+    console_command(capture_sort_keys, "Write the next frame's render sort keys to " SORT_KEY_CAPTURE_FILE_NAME " for pulsar_sort_benchmark."),
+    console_command(capture_frames, "Write the render commands of the next frames to " RENDER_CAPTURE_FILE_NAME " for pulsar_render_replay. Optionally takes how many frames."),
     console_command(kill_player, "Kill player."),
     console_command(delete_entity, "Delete an entity with a given GUID."),
     console_command(quit, "Quit the game."),
@@ -282,27 +348,28 @@ global ConsoleCommand console_commands[] = {
 #endif
 };
 
+inline void initialize_console_command_table(ConsoleState* console, MemoryArena* arena) {
+    initialize_hash_table(&console->command_table, allocator(arena_allocator, arena), 2*ARRAY_COUNT(console_commands));
+    for (u32 command_index = 0; command_index < ARRAY_COUNT(console_commands); command_index++) {
+        hash_table_insert(&console->command_table, console_commands[command_index].name, command_index);
+    }
+}
+
 inline void execute_console_command(GameState* game_state, GameInput* input, String in_buffer) {
     if (in_buffer.data[0] != '/') {
         String command = advance_word(&in_buffer);
         if (command.len > 0) {
             b32 print_help = false;
 
-            b32 found_command = false;
-            for (u32 command_index = 0; command_index < ARRAY_COUNT(console_commands); command_index++) {
-                ConsoleCommand candidate = console_commands[command_index];
-                if (strings_are_equal(command, candidate.name)) {
-                    found_command = true;
-                    if (candidate.f == cc_help) {
-                        print_help = true;
-                    } else {
-                        candidate.f(game_state, game_state->editor_state, input, trim_spaces_right(in_buffer));
-                    }
-                    break;
+            u32* command_index = hash_table_find(&game_state->console_state->command_table, command);
+            if (command_index) {
+                ConsoleCommand candidate = console_commands[*command_index];
+                if (candidate.f == cc_help) {
+                    print_help = true;
+                } else {
+                    candidate.f(game_state, game_state->editor_state, input, trim_spaces_right(in_buffer));
                 }
-            }
-
-            if (!found_command) {
+            } else {
                 log_print(LogLevel_Error, "Unknown command: %.*s", string_expand(command));
             }
 
@@ -337,9 +404,9 @@ internal void execute_console(GameState* game_state, ConsoleState* console, Game
     render_screenspace(rc);
 
     UILayoutContext layout_context;
-    layout_context.rc         = rc;
-    layout_context.assets     = &game_state->assets;
-    layout_context.temp_arena = &game_state->transient_arena;
+    layout_context.rc     = rc;
+    layout_context.assets = &game_state->assets;
+    layout_context.text_cache = game_state->text_layout_cache;
 
     v2 dim = get_screen_dim(rc);
     f32 width = dim.x;
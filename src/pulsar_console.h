@@ -26,6 +26,8 @@ struct ConsoleState {
     u32  caret_pos;
     u32  input_buffer_count;
     char input_buffer[255];
+
+    HashTable<String, u32> command_table;
 };
 
 inline String input_buffer_as_string(ConsoleState* console) {
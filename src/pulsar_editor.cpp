@@ -47,23 +47,21 @@ inline T* get_data(EditorState* editor, EntityData<T> data) {
     return result;
 }
 
+inline EntityHash* find_entity_hash_slot(EditorState* editor, EntityID guid) {
+    EntityHash* result = hash_table_find(&editor->entity_hash, guid.value);
+    return result;
+}
+
+// @Note: Adds a slot for the guid if there wasn't one yet. The returned slot is only valid until the next slot is added
+// or removed.
 inline EntityHash* get_entity_hash_slot(EditorState* editor, EntityID guid) {
     EntityHash* result = 0;
 
-    // @Note: Knuth
-    u32 hash_value = (guid.value*(guid.value + 3)) % ARRAY_COUNT(editor->entity_hash);
-
-    if (hash_value) {
-        for (u32 search = 0; search < ARRAY_COUNT(editor->entity_hash); search++) {
-            u32 hash_index = (hash_value + search) % ARRAY_COUNT(editor->entity_hash);
-            EntityHash* hash_slot = editor->entity_hash + hash_index;
-            if (!hash_slot->guid.value || hash_slot->guid.value == guid.value) {
-                if (!hash_slot->guid.value) {
-                    hash_slot->guid = guid;
-                }
-                result = hash_slot;
-                break;
-            }
+    if (guid.value) {
+        b32 added;
+        result = hash_table_add(&editor->entity_hash, guid.value, &added);
+        if (added) {
+            result->guid = guid;
         }
     }
 
@@ -74,7 +72,7 @@ inline Entity* get_entity_from_guid(EditorState* editor, EntityID guid) {
     GameState* game_state = editor->game_state; // @DisentangleGameStateFromEditor
 
     Entity* result = 0;
-    EntityHash* hash_slot = get_entity_hash_slot(editor, guid);
+    EntityHash* hash_slot = find_entity_hash_slot(editor, guid);
     if (hash_slot) {
         if (hash_slot->index && hash_slot->index < ARRAY_COUNT(editor->game_state->active_level->entities)) {
             if (game_state->game_mode == GameMode_Ingame) {
@@ -105,6 +103,8 @@ inline AddEntityResult add_entity(EditorState* editor, EntityType type, EntityID
     entity->type = type;
     entity->color = COLOR_WHITE;
 
+    invalidate_static_geometry(&editor->game_state->static_geometry);
+
     AddEntityResult result;
     result.guid = entity->guid;
     result.ptr = entity;
@@ -211,13 +211,14 @@ inline AddEntityResult add_trigger_zone(EditorState* editor, AxisAlignedBox2 zon
 
 inline void add_undo_history(EditorState* editor, UndoType type, u32 data_size, void* data, char* description = 0);
 inline void delete_entity(EditorState* editor, EntityID guid, b32 with_undo_history = true) {
-    EntityHash* hash_slot = get_entity_hash_slot(editor, guid);
+    EntityHash* hash_slot = find_entity_hash_slot(editor, guid);
 
     if (hash_slot) {
         Level* level = editor->game_state->active_level;
 
-        assert(hash_slot->index < ARRAY_COUNT(level->entities));
-        Entity* entity = level->entities + hash_slot->index;
+        u32 index = hash_slot->index;
+        assert(index < ARRAY_COUNT(level->entities));
+        Entity* entity = level->entities + index;
 
         for (u32 selected_index = 0; selected_index < editor->selected_entity_count; ++selected_index) {
             EntityID selected = editor->selected_entities[selected_index];
@@ -230,15 +231,16 @@ inline void delete_entity(EditorState* editor, EntityID guid, b32 with_undo_hist
             add_undo_history(editor, Undo_DeleteEntity, sizeof(*entity), entity, 0);
         }
 
-        hash_slot->guid = { 0 }; // Free the deleted entity's hash slot
+        hash_table_remove(&editor->entity_hash, guid.value); // Free the deleted entity's hash slot
 
-        if (level->entity_count > 1) {
-            level->entities[hash_slot->index] = level->entities[--level->entity_count];
-            EntityHash* moved_entity_hash = get_entity_hash_slot(editor, level->entities[hash_slot->index].guid);
-            moved_entity_hash->index = hash_slot->index;
-        } else {
-            level->entity_count--;
+        u32 last_index = --level->entity_count;
+        if (index != last_index) {
+            level->entities[index] = level->entities[last_index];
+            EntityHash* moved_entity_hash = get_entity_hash_slot(editor, level->entities[index].guid);
+            moved_entity_hash->index = index;
         }
+
+        invalidate_static_geometry(&editor->game_state->static_geometry);
     } else {
         log_print(LogLevel_Error, "Tried to delete non-existent EntityID { %u }", guid.value);
     }
@@ -255,7 +257,11 @@ inline UndoFooter* get_undo_footer(EditorState* editor, u32 offset) {
 }
 
 // @TODO: This is more complicated and hard to understand than I would like
+// @Note: Every edit goes through here before it changes anything, so this is where the level's static geometry finds out
+// it's out of date. Edits that keep going for a while, like drags, invalidate it for as long as their widget is active.
 inline UndoFooter* add_undo_footer(EditorState* editor, u32 data_size) {
+    invalidate_static_geometry(&editor->game_state->static_geometry);
+
     UndoFooter* prev_footer = 0;
     u32 data_index = 0;
     if (editor->undo_most_recent) {
@@ -380,12 +386,14 @@ inline void add_entity_data_undo_history(EditorState* editor, EntityData<T> enti
 inline void undo(EditorState* editor, u32 batch_chain_id = 0) {
     UndoFooter* footer = get_undo_footer(editor, editor->undo_most_recent);
     if (footer && (!batch_chain_id || footer->batch_id == batch_chain_id)) {
+        invalidate_static_geometry(&editor->game_state->static_geometry);
+
         void* data = get_undo_data(footer);
 
-        TemporaryMemory temp = begin_temporary_memory(editor->arena);
+        TemporaryMemory scratch = get_scratch();
         switch (footer->type) {
             case Undo_SetEntityData: {
-                void* temp_redo_buffer = push_size(editor->arena, footer->data_size, no_clear());
+                void* temp_redo_buffer = push_size(scratch.arena, footer->data_size, no_clear());
                 Entity* entity = get_entity_from_guid(editor, footer->entity_guid);
                 void* entity_data = cast(u8*) entity + footer->entity_data_offset;
                 copy(footer->data_size, entity_data, temp_redo_buffer);
@@ -394,7 +402,7 @@ inline void undo(EditorState* editor, u32 batch_chain_id = 0) {
             } break;
 
             case Undo_SetData: {
-                void* temp_redo_buffer = push_size(editor->arena, footer->data_size, no_clear());
+                void* temp_redo_buffer = push_size(scratch.arena, footer->data_size, no_clear());
                 copy(footer->data_size, footer->data_ptr, temp_redo_buffer);
                 copy(footer->data_size, data, footer->data_ptr);
                 copy(footer->data_size, temp_redo_buffer, data);
@@ -416,7 +424,7 @@ inline void undo(EditorState* editor, u32 batch_chain_id = 0) {
                 copy(footer->data_size, data, added_entity.ptr);
             } break;
         }
-        end_temporary_memory(temp);
+        release_scratch(scratch);
 
         editor->undo_most_recent = footer->prev;
 
@@ -439,12 +447,14 @@ inline void redo(EditorState* editor, u32 batch_chain_id = 0) {
     if (footer_index) {
         UndoFooter* footer = get_undo_footer(editor, footer_index);
         if (footer && (!batch_chain_id || footer->batch_id == batch_chain_id)) {
+            invalidate_static_geometry(&editor->game_state->static_geometry);
+
             void* data = get_undo_data(footer);
 
-            TemporaryMemory temp = begin_temporary_memory(editor->arena);
+            TemporaryMemory scratch = get_scratch();
             switch (footer->type) {
                 case Undo_SetEntityData: {
-                    void* temp_undo_buffer = push_size(editor->arena, footer->data_size, no_clear());
+                    void* temp_undo_buffer = push_size(scratch.arena, footer->data_size, no_clear());
                     Entity* entity = get_entity_from_guid(editor, footer->entity_guid);
                     void* entity_data = cast(u8*) entity + footer->entity_data_offset;
                     copy(footer->data_size, entity_data, temp_undo_buffer);
@@ -453,7 +463,7 @@ inline void redo(EditorState* editor, u32 batch_chain_id = 0) {
                 } break;
 
                 case Undo_SetData: {
-                    void* temp_undo_buffer = push_size(editor->arena, footer->data_size, no_clear());
+                    void* temp_undo_buffer = push_size(scratch.arena, footer->data_size, no_clear());
                     copy(footer->data_size, footer->data_ptr, temp_undo_buffer);
                     copy(footer->data_size, data, footer->data_ptr);
                     copy(footer->data_size, temp_undo_buffer, data);
@@ -475,7 +485,7 @@ inline void redo(EditorState* editor, u32 batch_chain_id = 0) {
                     }
                 } break;
             }
-            end_temporary_memory(temp);
+            release_scratch(scratch);
 
             editor->undo_most_recent = footer_index;
 
@@ -487,10 +497,8 @@ inline void redo(EditorState* editor, u32 batch_chain_id = 0) {
 }
 
 inline void load_level_into_editor(EditorState* editor, Level* level) {
-    // @Note: Weird paranoid assert in case I ever change the hash from a fixed size array and forget to change this...
-    assert(sizeof(editor->entity_hash) == sizeof(EntityHash)*MAX_ENTITY_COUNT);
-
-    zero_size(sizeof(editor->entity_hash), editor->entity_hash);
+    clear_hash_table(&editor->entity_hash);
+    invalidate_static_geometry(&editor->game_state->static_geometry);
 
     for (u32 entity_index = 1; entity_index < level->entity_count; entity_index++) {
         Entity* entity = level->entities + entity_index;
@@ -596,11 +604,29 @@ enum LayoutTextOp {
     LayoutTextOp_Print,
 };
 
+// @Note: The glyphs of a line that share an atlas page get pushed as one glyph run, once the line or page changes
+struct LayoutGlyphRun {
+    Image* atlas_page;
+    v2 origin;
+    u32 glyph_count;
+    u32 glyph_capacity;
+    RenderGlyph* glyphs;
+    AxisAlignedBox2 bounds;
+};
+
+inline void layout_flush_glyph_run(UILayout* layout, LayoutGlyphRun* run, v4 color) {
+    if (run->glyph_count) {
+        push_glyph_run(layout->context.rc, transform2d(run->origin), run->atlas_page, layout->font->glyph_table, run->glyph_count, run->glyphs, run->bounds, color, vec4(0, 0, 0, color.a), vec2(1.0f, -1.0f));
+    }
+    run->atlas_page = 0;
+    run->glyph_count = 0;
+}
+
 inline AxisAlignedBox2 layout_text_bounds(UILayout* layout, char* format_string, ...);
 internal void layout_text_op_va(UILayout* layout, LayoutTextOp op, v4 color, char* format_string, va_list va_args) {
-    TemporaryMemory temp = begin_temporary_memory(layout->context.temp_arena);
+    TemporaryMemory scratch = get_scratch();
 
-    String text = push_formatted_string_va(layout->context.temp_arena, format_string, va_args);
+    String text = push_formatted_string_va(scratch.arena, format_string, va_args);
 
     Font* font = layout->font;
 
@@ -612,56 +638,61 @@ internal void layout_text_op_va(UILayout* layout, LayoutTextOp op, v4 color, cha
         if (layout->flags & Layout_VertCenterAlign) offset_p.y -= 0.5f*dim.y;
     }
 
+    u32 leading_codepoint = 0;
     if (!layout->print_initialized) {
         layout->last_print_bounds = inverted_infinity_aab2();
         layout->print_initialized = true;
     } else {
-        if (layout->last_codepoint && text.data[0]) {
-            at_p.x += get_advance_for_codepoint_pair(font, layout->last_codepoint, text.data[0]);
-        }
+        leading_codepoint = layout->last_codepoint;
     }
 
-    u32 last_codepoint = layout->last_codepoint;
-    for (char* at = text.data; at[0]; at++) {
-        last_codepoint = at[0];
-        if (at[0] == ' ') {
-            at_p.x += font->whitespace_width;
-        } else if (at[0] == '\n') {
-            at_p.x  = layout->origin.x;
-            at_p.y += layout->vertical_advance;
-        } else if (in_font_range(font, at[0])) {
-            ImageID glyph_id = get_glyph_id_for_codepoint(font, at[0]);
-            if (glyph_id.value) {
-                Image* glyph = get_image(layout->context.assets, glyph_id);
-                v2 p = vec2(roundf(offset_p.x + at_p.x), roundf(offset_p.y + at_p.y)) + vec2(layout->depth*font->whitespace_width*4.0f, 0.0f);
-
-                if (op == LayoutTextOp_Print) {
-                    if (glyph) {
-                        push_image(layout->context.rc, transform2d(p + vec2(1.0f, -1.0f), vec2(glyph->w, glyph->h)), glyph, vec4(0, 0, 0, color.a));
-                        push_image(layout->context.rc, transform2d(p, vec2(glyph->w, glyph->h)), glyph, color);
-                    } else {
-                        push_rect(layout->context.rc, aab_min_dim(p, vec2(font->size, font->size)), COLOR_RED);
-                    }
-                }
+    TextLayout* text_layout = get_text_layout(layout->context.text_cache, layout->context.assets, font, text, leading_codepoint, layout->origin.x - at_p.x, layout->vertical_advance, scratch.arena);
 
-                AxisAlignedBox2 glyph_aab = {};
-                if (glyph) {
-                    glyph_aab = offset(get_aligned_image_aab(glyph), p);
-                } else {
-                    glyph_aab = aab_min_dim(vec2(0, 0), vec2(font->size, font->size));
-                }
+    v2 pen_p = offset_p + at_p + vec2(layout->depth*font->whitespace_width*4.0f, 0.0f);
 
-                layout->last_print_bounds = aab_union(layout->last_print_bounds, glyph_aab);
+    if (op == LayoutTextOp_Print) {
+        LayoutGlyphRun run = {};
 
-                if (in_font_range(font, at[1])) {
-                    at_p.x += get_advance_for_codepoint_pair(font, at[0], at[1]);
-                }
+        u32 loaded_page_index = TEXT_LAYOUT_MISSING_PAGE;
+        Image* loaded_page = 0;
+
+        for (u32 glyph_index = 0; glyph_index < text_layout->glyph_count; glyph_index++) {
+            TextLayoutGlyph* glyph = text_layout->glyphs + glyph_index;
+            v2 p = vec2(roundf(offset_p.x + at_p.x + glyph->p.x), roundf(offset_p.y + at_p.y + glyph->p.y)) + vec2(layout->depth*font->whitespace_width*4.0f, 0.0f);
+
+            if (glyph->atlas_page == TEXT_LAYOUT_MISSING_PAGE) {
+                push_rect(layout->context.rc, aab_min_dim(p, vec2(font->size, font->size)), COLOR_RED);
+                continue;
             }
-        } else {
-            // @TODO: Make it clear some unsupported characters showed up
+
+            if (glyph->atlas_page != loaded_page_index) {
+                loaded_page_index = glyph->atlas_page;
+                loaded_page = get_image(layout->context.assets, font->atlas_pages[loaded_page_index]);
+            }
+
+            if (run.atlas_page != loaded_page || run.origin.y != p.y || run.glyph_count == run.glyph_capacity) {
+                layout_flush_glyph_run(layout, &run, color);
+
+                // @Note: A run can't hold more than the glyphs left in the layout
+                run.atlas_page = loaded_page;
+                run.origin = p;
+                run.glyph_capacity = text_layout->glyph_count - glyph_index;
+                run.glyphs = push_frame_array(layout->context.rc, run.glyph_capacity, RenderGlyph, no_clear());
+                run.bounds = inverted_infinity_aab2();
+            }
+
+            PackedGlyph* packed_glyph = font->glyph_table + glyph->glyph_index;
+            RenderGlyph* run_glyph = run.glyphs + run.glyph_count++;
+            run_glyph->glyph_index = glyph->glyph_index;
+            run_glyph->x = p.x - run.origin.x;
+            run.bounds = aab_union(run.bounds, offset(get_aligned_glyph_aab(font, packed_glyph), p - run.origin));
         }
+
+        layout_flush_glyph_run(layout, &run, color);
     }
 
+    layout->last_print_bounds = aab_union(layout->last_print_bounds, offset(text_layout->bounds, pen_p));
+
     if (op == LayoutTextOp_GetBounds) {
         if (layout->flags & Layout_CenterAlign) {
             v2 dim = get_dim(layout->last_print_bounds);
@@ -671,12 +702,14 @@ internal void layout_text_op_va(UILayout* layout, LayoutTextOp op, v4 color, cha
             layout->last_print_bounds = offset(layout->last_print_bounds, the_offset);
         }
     } else {
-        layout->at_p = at_p;
-        layout->last_codepoint = last_codepoint;
+        layout->at_p = at_p + text_layout->end_p;
+        if (text_layout->last_codepoint) {
+            layout->last_codepoint = text_layout->last_codepoint;
+        }
         layout->total_bounds = aab_union(layout->total_bounds, layout->last_print_bounds);
     }
 
-    end_temporary_memory(temp);
+    release_scratch(scratch);
 }
 
 inline void layout_print_va(UILayout* layout, v4 color, char* format_string, va_list va_args) {
@@ -1038,7 +1071,7 @@ inline EditorWidget drag_region_widget(GameState* game_state, EditorState* edito
     {
         v2 corner = 0.5f*vec2(-region_value.x, -region_value.y);
         AxisAlignedBox2 corner_box = aab_center_dim(corner, corner_box_size);
-        push_shape(&game_state->render_context, t, rectangle(corner_box), corner_color, ShapeRenderMode_Fill, 2000.0f);
+        push_shape(&game_state->render_context, t, rectangle(corner_box), corner_color, ShapeRenderMode_Fill, EDITOR_HANDLE_LAYER);
 
         if (is_in_aab(offset(corner_box, t.offset), editor->world_mouse_p)) {
             widget.drag_region.scaling = vec2(-1.0f, -1.0f);
@@ -1049,7 +1082,7 @@ inline EditorWidget drag_region_widget(GameState* game_state, EditorState* edito
     {
         v2 corner = 0.5f*vec2(region_value.x, -region_value.y);
         AxisAlignedBox2 corner_box = aab_center_dim(corner, corner_box_size);
-        push_shape(&game_state->render_context, t, rectangle(corner_box), corner_color, ShapeRenderMode_Fill, 2000.0f);
+        push_shape(&game_state->render_context, t, rectangle(corner_box), corner_color, ShapeRenderMode_Fill, EDITOR_HANDLE_LAYER);
 
         if (is_in_aab(offset(corner_box, t.offset), editor->world_mouse_p)) {
             widget.drag_region.scaling = vec2(1.0f, -1.0f);
@@ -1060,7 +1093,7 @@ inline EditorWidget drag_region_widget(GameState* game_state, EditorState* edito
     {
         v2 corner = 0.5f*vec2(region_value.x, region_value.y);
         AxisAlignedBox2 corner_box = aab_center_dim(corner, corner_box_size);
-        push_shape(&game_state->render_context, t, rectangle(corner_box), corner_color, ShapeRenderMode_Fill, 2000.0f);
+        push_shape(&game_state->render_context, t, rectangle(corner_box), corner_color, ShapeRenderMode_Fill, EDITOR_HANDLE_LAYER);
 
         if (is_in_aab(offset(corner_box, t.offset), editor->world_mouse_p)) {
             widget.drag_region.scaling = vec2(1.0f, 1.0f);
@@ -1071,7 +1104,7 @@ inline EditorWidget drag_region_widget(GameState* game_state, EditorState* edito
     {
         v2 corner = 0.5f*vec2(-region_value.x, region_value.y);
         AxisAlignedBox2 corner_box = aab_center_dim(corner, corner_box_size);
-        push_shape(&game_state->render_context, t, rectangle(corner_box), corner_color, ShapeRenderMode_Fill, 2000.0f);
+        push_shape(&game_state->render_context, t, rectangle(corner_box), corner_color, ShapeRenderMode_Fill, EDITOR_HANDLE_LAYER);
 
         if (is_in_aab(offset(corner_box, t.offset), editor->world_mouse_p)) {
             widget.drag_region.scaling = vec2(-1.0f, 1.0f);
@@ -1134,10 +1167,15 @@ inline EditorState* allocate_editor(GameState* game_state, GameRenderCommands* r
 
     initialize_render_context(&editor->render_context, render_commands, 0.0f);
     editor->render_context.sort_key_bias = 32000.0f;
+    editor->render_context.triangulation_cache = game_state->triangulation_cache;
 
     editor->assets = &game_state->assets;
+    editor->text_cache = game_state->text_layout_cache;
     editor->arena = &game_state->transient_arena;
 
+    // @Note: Sized so a full level never makes it grow
+    initialize_hash_table(&editor->entity_hash, allocator(arena_allocator, &game_state->permanent_arena), 2*MAX_ENTITY_COUNT);
+
     editor->shown = false;
     editor->show_statistics = false;
 
@@ -1183,6 +1221,8 @@ internal void execute_editor(GameState* game_state, EditorState* editor, GameInp
         f32 peak_frame_time = 0.0f;
         u32 average_render_commands = 0;
         u32 peak_render_commands = 0;
+        u32 average_culled_render_commands = 0;
+        u32 average_draw_batches = 0;
         // @TODO: be a good statistician and don't use a stupid average for this, but some cool gaussian or something
         for (u32 frame_index = 0; frame_index < frame_history->valid_entry_count; frame_index++) {
             DebugFrameInfo* frame = frame_history->history + ((frame_history->first_valid_entry + frame_index) % ARRAY_COUNT(frame_history->history));
@@ -1190,9 +1230,13 @@ internal void execute_editor(GameState* game_state, EditorState* editor, GameInp
             peak_frame_time = max(peak_frame_time, frame->time);
             average_render_commands += frame->render_commands;
             peak_render_commands = MAX(peak_render_commands, frame->render_commands);
+            average_culled_render_commands += frame->culled_render_commands;
+            average_draw_batches += frame->draw_batches;
         }
         average_frame_time /= frame_history->valid_entry_count;
         average_render_commands /= frame_history->valid_entry_count;
+        average_culled_render_commands /= frame_history->valid_entry_count;
+        average_draw_batches /= frame_history->valid_entry_count;
 
         f32 adjusted_frame_dt = input->frame_dt / game_config->simulation_rate; // @Note: This way the frame time counter won't go bright red if you lower the simulation rate
 
@@ -1201,13 +1245,20 @@ internal void execute_editor(GameState* game_state, EditorState* editor, GameInp
         v4 timer_color = vec4(1.0f, 1.0f-frame_target_miss_amount_in_ms, 1.0f-frame_target_miss_amount_in_ms, 1.0f);
         layout_print_line(&layout, COLOR_WHITE, "Target Update Rate: %ghz, %fms/f", input->update_rate, 1000.0f / input->update_rate);
         layout_print_line(&layout, timer_color, "Average Frame Time: %fms, Peak: %fms", average_frame_time_in_ms, 1000.0f*peak_frame_time);
-        layout_print_line(&layout, COLOR_WHITE, "Average Render Commands: %u, Peak: %u\n", average_render_commands, peak_render_commands);
+        layout_print_line(&layout, COLOR_WHITE, "Average Render Commands: %u, Peak: %u, Culled: %u, Draw Batches: %u", average_render_commands, peak_render_commands, average_culled_render_commands, average_draw_batches);
+        layout_print_line(&layout, COLOR_WHITE, "Text Layout Cache: %u layouts, %u hits, %u misses", editor->text_cache->entry_table.count, editor->text_cache->hits, editor->text_cache->misses);
+        layout_print_line(&layout, COLOR_WHITE, "Triangulation Cache: %u polygons, %u hits, %u misses", game_state->triangulation_cache->entry_count, game_state->triangulation_cache->hits, game_state->triangulation_cache->misses);
+        layout_print_line(&layout, COLOR_WHITE, "Background Particles: %u / %u\n", game_state->background_particles.count, game_state->background_particles.capacity);
     }
 
     if (!editor->shown) {
         return;
     }
 
+    if (editor->active_widget.type && !is_active(editor, pan_widget)) {
+        invalidate_static_geometry(&game_state->static_geometry);
+    }
+
     Level* level = game_state->active_level;
 
     if (game_state->game_mode == GameMode_Editor) {
@@ -1255,14 +1306,19 @@ internal void execute_editor(GameState* game_state, EditorState* editor, GameInp
     layout_print_line(&sound_log, COLOR_WHITE, "Playing Sounds:");
     sound_log.depth++;
     for (AudioGroup* group = game_state->audio_mixer.first_audio_group; group; group = group->next_audio_group) {
-        if (group->first_playing_sound) {
+        if (group->playing_sound_count) {
             layout_print_line(&sound_log, COLOR_WHITE, "Audio Group%s, volume { %g, %g }:",
                 group->paused ? " (paused)" : "",
                 group->volume.current_volume[0], group->volume.current_volume[1]
             );
         }
         sound_log.depth++;
-        for (PlayingSound* playing_sound = group->first_playing_sound; playing_sound; playing_sound = playing_sound->next) {
+        for (u32 live_index = 0; live_index < game_state->audio_mixer.playing_sounds.live_count; live_index++) {
+            PlayingSound* playing_sound = pool_get_live(&game_state->audio_mixer.playing_sounds, live_index);
+            if (playing_sound->group != group) {
+                continue;
+            }
+
             Sound* sound = playing_sound->sound;
             Asset* asset = cast(Asset*) sound;
 
@@ -1286,7 +1342,8 @@ internal void execute_editor(GameState* game_state, EditorState* editor, GameInp
 
     layout_print_line(&sound_log, COLOR_WHITE, "Playing Midi:");
     sound_log.depth++;
-    for (PlayingMidi* playing_midi = game_state->first_playing_midi; playing_midi; playing_midi = playing_midi->next) {
+    for (u32 live_index = 0; live_index < game_state->playing_midis.live_count; live_index++) {
+        PlayingMidi* playing_midi = pool_get_live(&game_state->playing_midis, live_index);
         MidiTrack* track = playing_midi->track;
 
         v4 color = playing_midi->source_soundtrack_player->can_be_heard_by_player ? COLOR_WHITE : COLOR_GREY;
@@ -1449,8 +1506,8 @@ internal void execute_editor(GameState* game_state, EditorState* editor, GameInp
         AxisAlignedBox2 selection_box = bounding_aab(editor->world_mouse_p_on_active, world_mouse_p);
         v2 selection_dim = get_dim(selection_box);
 
-        push_rect(&game_state->render_context, selection_box, vec4(0.3f, 0.3f, 0.5f, 0.2f), ShapeRenderMode_Fill);
-        push_rect(&game_state->render_context, selection_box, vec4(0.5f, 0.5f, 0.8f, 0.8f), ShapeRenderMode_Outline);
+        push_rect(&game_state->render_context, selection_box, vec4(0.3f, 0.3f, 0.5f, 0.2f), ShapeRenderMode_Fill, EDITOR_OVERLAY_LAYER);
+        push_rect(&game_state->render_context, selection_box, vec4(0.5f, 0.5f, 0.8f, 0.8f), ShapeRenderMode_Outline, EDITOR_OVERLAY_LAYER);
 
         if (was_released(input->mouse_buttons[PlatformMouseButton_Left])) {
             selection_box = correct_aab_winding(selection_box);
@@ -1684,9 +1741,9 @@ internal void execute_editor(GameState* game_state, EditorState* editor, GameInp
                 v3 fill_color    = is_active(editor, widget) ? COLOR_RED.rgb : entity->color.rgb;
                 v3 outline_color = is_active(editor, widget) || is_hot(editor, widget) ? COLOR_RED.rgb : entity->color.rgb;
 
-                push_rect(&game_state->render_context, aab_center_dim(world_end_p, entity->collision), vec4(fill_color, 0.25f));
-                push_rect(&game_state->render_context, aab_center_dim(world_end_p, entity->collision), vec4(outline_color, 0.85f), ShapeRenderMode_Outline);
-                push_line(&game_state->render_context, entity->p, world_end_p, vec4(outline_color, 0.85f));
+                push_rect(&game_state->render_context, aab_center_dim(world_end_p, entity->collision), vec4(fill_color, 0.25f), ShapeRenderMode_Fill, EDITOR_OVERLAY_LAYER);
+                push_rect(&game_state->render_context, aab_center_dim(world_end_p, entity->collision), vec4(outline_color, 0.85f), ShapeRenderMode_Outline, EDITOR_OVERLAY_LAYER);
+                push_line(&game_state->render_context, entity->p, world_end_p, vec4(outline_color, 0.85f), EDITOR_OVERLAY_LAYER);
 
                 if (is_in_region(entity->collision, world_mouse_p - world_end_p)) {
                     editor->next_hot_widget = widget;
@@ -1823,14 +1880,14 @@ internal void execute_editor(GameState* game_state, EditorState* editor, GameInp
     }
 
     if (moused_over) {
-        push_shape(&game_state->render_context, transform2d(moused_over->p), rectangle(moused_over->collision + vec2(0.1f, 0.1f)), COLOR_PINK, ShapeRenderMode_Outline, 1000.0f);
+        push_shape(&game_state->render_context, transform2d(moused_over->p), rectangle(moused_over->collision + vec2(0.1f, 0.1f)), COLOR_PINK, ShapeRenderMode_Outline, EDITOR_OVERLAY_LAYER);
     }
 
     if (editor->selected_entity_count) {
         for (u32 selected_index = 0; selected_index < editor->selected_entity_count; selected_index++) {
             Entity* this_selected = get_entity_from_guid(editor, editor->selected_entities[selected_index]);
             if (this_selected) {
-                push_shape(&game_state->render_context, transform2d(this_selected->p), rectangle(this_selected->collision + vec2(0.1f, 0.1f)), this_selected == moused_over ? COLOR_YELLOW : COLOR_GREEN, ShapeRenderMode_Outline, 1000.0f);
+                push_shape(&game_state->render_context, transform2d(this_selected->p), rectangle(this_selected->collision + vec2(0.1f, 0.1f)), this_selected == moused_over ? COLOR_YELLOW : COLOR_GREEN, ShapeRenderMode_Outline, EDITOR_OVERLAY_LAYER);
             }
         }
     }
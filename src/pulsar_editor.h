@@ -4,6 +4,12 @@
 #define UNDO_BUFFER_SIZE MEGABYTES(2)
 #define MAX_ENTITY_COUNT 256
 
+// @Note: Editor overlays get drawn into the game's render context, so they need layers of their own above the world.
+// Within a layer, render commands sort by type before push order, so an overlay left on layer 0 would end up under
+// any sprite or text there. Handles go above the rest of the overlays, so they can still be grabbed.
+#define EDITOR_OVERLAY_LAYER 1000.0f
+#define EDITOR_HANDLE_LAYER  2000.0f
+
 struct Level {
     u32 name_length;
     char name[256];
@@ -160,6 +166,7 @@ struct EditorState {
 
     RenderContext render_context;
     Assets* assets;
+    TextLayoutCache* text_cache;
 
     ImageID camera_icon;
     ImageID speaker_icon;
@@ -213,7 +220,7 @@ struct EditorState {
     EntityType current_editable_type;
     LinearBuffer<EditableParameter>* editable_parameter_info[EntityType_Count];
 
-    EntityHash entity_hash[MAX_ENTITY_COUNT];
+    HashTable<u32, EntityHash> entity_hash;
 
     u32 doing_undo_batch;
     u32 current_batch_id;
@@ -225,7 +232,7 @@ struct EditorState {
 struct UILayoutContext {
     RenderContext* rc;
     Assets* assets;
-    MemoryArena* temp_arena;
+    TextLayoutCache* text_cache;
 };
 
 struct UILayout {
@@ -299,7 +306,7 @@ inline void set_font(UILayout* layout, Font* font) {
 }
 
 inline UILayout make_layout(EditorState* editor, v2 origin, b32 bottom_up = false) {
-    UILayout layout = make_layout({ &editor->render_context, editor->assets, editor->arena }, editor->font, origin, bottom_up);
+    UILayout layout = make_layout({ &editor->render_context, editor->assets, editor->text_cache }, editor->font, origin, bottom_up);
     return layout;
 }
 
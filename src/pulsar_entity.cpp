@@ -98,17 +98,35 @@ inline void do_trigger_behaviour(GameState* game_state, Entity* trigger_zone, Tr
 internal void simulate_entities(GameState* game_state, GameInput* input, f32 frame_dt) {
     game_state->midi_event_buffer_count = 0;
     if (!game_state->midi_paused) {
-        for (PlayingMidi** playing_midi_ptr = &game_state->first_playing_midi; *playing_midi_ptr;) {
-            PlayingMidi* playing_midi = *playing_midi_ptr;
+        Pool<PlayingMidi>* playing_midis = &game_state->playing_midis;
+        for (u32 live_index = 0; live_index < playing_midis->live_count;) {
+            PlayingMidi* playing_midi = pool_get_live(playing_midis, live_index);
             MidiTrack* track = playing_midi->track;
 
             f32 ticks_for_frame = cast(f32) track->ticks_per_second*frame_dt;
 
-            // @Note: I moved the sync to output_playing_sounds, which means that if the midi track has a sync sound
-            // playing_midi->tick_timer will be synced to it at the end of every frame
+            // @Note: If the midi track has a sync sound, the tick timer follows its play cursor. The midi track only holds a handle
+            // to it, so if the sound has been stopped the handle stops resolving and the midi track stops with it.
+            b32 midi_done = false;
+            PlayingSound* sync_sound = 0;
+            if (!is_null(playing_midi->sync_sound)) {
+                sync_sound = get_playing_sound(&game_state->audio_mixer, playing_midi->sync_sound);
+                if (sync_sound) {
+                    // @Note: The mixer wraps a looping sound's play cursor, so if it's behind last frame's the sound went past its end
+                    // since then. Unwrapping it lets the events up to the end still happen, and the track restarts below.
+                    u32 samples_played = sync_sound->samples_played;
+                    if (samples_played < playing_midi->tick_timer) {
+                        samples_played += sync_sound->sound->sample_count;
+                    }
+                    playing_midi->tick_timer = samples_played;
+                } else {
+                    midi_done = true;
+                }
+            }
+
             u32 tick_timer_for_frame = playing_midi->tick_timer + cast(u32) (game_config->simulation_rate*(ticks_for_frame*playing_midi->playback_rate));
 
-            if (playing_midi->event_index < track->event_count) {
+            if (!midi_done && playing_midi->event_index < track->event_count) {
                 for (MidiEvent event = track->events[playing_midi->event_index];
                      playing_midi->event_index < track->event_count && event.absolute_time_in_ticks <= tick_timer_for_frame;
                      event = track->events[++playing_midi->event_index])
@@ -139,24 +157,22 @@ internal void simulate_entities(GameState* game_state, GameInput* input, f32 fra
                 }
             }
 
-            b32 midi_done = false;
-            if (playing_midi->sync_sound) {
-                if (playing_midi->tick_timer >= playing_midi->sync_sound->sound->sample_count) {
+            if (sync_sound) {
+                if (playing_midi->tick_timer >= sync_sound->sound->sample_count) {
                     if (playing_midi->flags & Playback_Looping) {
                         playing_midi->event_index = 0;
-                        playing_midi->tick_timer -= playing_midi->sync_sound->sound->sample_count;
+                        playing_midi->tick_timer -= sync_sound->sound->sample_count;
                     } else {
                         midi_done = true;
                     }
                 }
-            } else {
+            } else if (!midi_done) {
                 playing_midi->tick_timer = tick_timer_for_frame;
                 if (playing_midi->event_index >= track->event_count) {
                     assert(playing_midi->event_index == track->event_count);
                     if (playing_midi->flags & Playback_Looping) {
                         playing_midi->event_index = 0;
                         playing_midi->tick_timer = 0;
-                        playing_midi_ptr = &playing_midi->next;
                     } else {
                         midi_done = true;
                     }
@@ -164,11 +180,9 @@ internal void simulate_entities(GameState* game_state, GameInput* input, f32 fra
             }
 
             if (midi_done) {
-                *playing_midi_ptr = playing_midi->next;
-                playing_midi->next = game_state->first_free_playing_midi;
-                game_state->first_free_playing_midi = playing_midi;
+                pool_free_live(playing_midis, live_index);
             } else {
-                playing_midi_ptr = &playing_midi->next;
+                live_index++;
             }
         }
     }
@@ -577,10 +591,10 @@ internal void simulate_entities(GameState* game_state, GameInput* input, f32 fra
 
         switch (entity->type) {
             case EntityType_SoundtrackPlayer: {
-                if (!entity->playing) {
+                if (is_null(entity->playing)) {
                     if (entity->soundtrack_id.value) {
                         entity->playing = play_soundtrack(game_state, entity, entity->playback_flags);
-                        change_volume(entity->playing, 0.0f, vec2(0, 0));
+                        change_volume(&game_state->audio_mixer, entity->playing, 0.0f, vec2(0, 0));
                     }
                 } else {
                     entity->color = COLOR_GREEN;
@@ -604,6 +618,7 @@ internal void simulate_entities(GameState* game_state, GameInput* input, f32 fra
                         if (event.source_soundtrack.value == entity->soundtrack_id.value) {
                             if (event.type == MidiEvent_NoteOn) {
                                 game_state->background_pulse_t += (volume.x + volume.y)*game_config->background_pulse_intensity;
+                                trigger_particle_emitter(&game_state->background_emitter, event.note_value, (volume.x + volume.y)*(cast(f32) event.velocity / 127.0f));
                             } else if (event.type == MidiEvent_NoteOff) {
                                 game_state->background_pulse_t += 0.25f*(volume.x + volume.y)*game_config->background_pulse_intensity;
                             }
@@ -612,7 +627,7 @@ internal void simulate_entities(GameState* game_state, GameInput* input, f32 fra
 
                     entity->can_be_heard_by_player = volume.x > 0.0f || volume.y > 0.0f;
 
-                    change_volume(entity->playing, 0.05f, volume);
+                    change_volume(&game_state->audio_mixer, entity->playing, 0.05f, volume);
                 }
             } break;
 
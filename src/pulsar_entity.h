@@ -116,7 +116,7 @@ struct Entity {
             f32 vert_fade_region;
             b32 can_be_heard_by_player;
 
-            PlayingSound* playing;
+            Handle<PlayingSound> playing;
         };
 
         struct /* CameraZone */ {
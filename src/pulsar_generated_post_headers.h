@@ -158,6 +158,7 @@ static MemberDefinition MembersOf_PackedFont[] = {
     { 0, MetaType_f32, 6, "ascent", (unsigned int)&((PackedFont*)0)->ascent, sizeof(f32) },
     { 0, MetaType_f32, 7, "descent", (unsigned int)&((PackedFont*)0)->descent, sizeof(f32) },
     { 0, MetaType_f32, 8, "line_gap", (unsigned int)&((PackedFont*)0)->line_gap, sizeof(f32) },
+    { 0, MetaType_u32, 16, "atlas_page_count", (unsigned int)&((PackedFont*)0)->atlas_page_count, sizeof(u32) },
 };
 
 static MemberDefinition MembersOf_PackedMidi[] = {
@@ -188,7 +189,13 @@ static MemberDefinition MembersOf_GameConfig[] = {
     { 0, MetaType_u32, 22, "command_buffer_size_mb", (unsigned int)&((GameConfig*)0)->command_buffer_size_mb, sizeof(u32) },
     { 0, MetaType_u32, 25, "permanent_storage_size_mb", (unsigned int)&((GameConfig*)0)->permanent_storage_size_mb, sizeof(u32) },
     { 0, MetaType_u32, 25, "transient_storage_size_mb", (unsigned int)&((GameConfig*)0)->transient_storage_size_mb, sizeof(u32) },
+    { 0, MetaType_u32, 27, "arena_decommit_threshold_mb", (unsigned int)&((GameConfig*)0)->arena_decommit_threshold_mb, sizeof(u32) },
+    { 0, MetaType_b32, 15, "use_large_pages", (unsigned int)&((GameConfig*)0)->use_large_pages, sizeof(b32) },
+    { 0, MetaType_u32, 19, "prefault_storage_mb", (unsigned int)&((GameConfig*)0)->prefault_storage_mb, sizeof(u32) },
     { 0, MetaType_u32, 10, "msaa_count", (unsigned int)&((GameConfig*)0)->msaa_count, sizeof(u32) },
+    { 0, MetaType_b32, 19, "use_shader_renderer", (unsigned int)&((GameConfig*)0)->use_shader_renderer, sizeof(b32) },
+    { 0, MetaType_b32, 21, "use_software_renderer", (unsigned int)&((GameConfig*)0)->use_software_renderer, sizeof(b32) },
+    { 0, MetaType_u32, 30, "software_renderer_thread_count", (unsigned int)&((GameConfig*)0)->software_renderer_thread_count, sizeof(u32) },
     { 0, MetaType_f32, 13, "master_volume", (unsigned int)&((GameConfig*)0)->master_volume, sizeof(f32) },
     { 0, MetaType_f32, 15, "gameplay_volume", (unsigned int)&((GameConfig*)0)->gameplay_volume, sizeof(f32) },
     { 0, MetaType_f32, 9, "ui_volume", (unsigned int)&((GameConfig*)0)->ui_volume, sizeof(f32) },
@@ -58,7 +58,8 @@ enum MetaType {
     f32 whitespace_width; \
     f32 ascent; \
     f32 descent; \
-    f32 line_gap;
+    f32 line_gap; \
+    u32 atlas_page_count;
 
 #define BodyOf_PackedMidi \
     u32 ticks_per_second; \
@@ -85,7 +86,13 @@ enum MetaType {
     u32 command_buffer_size_mb; \
     u32 permanent_storage_size_mb; \
     u32 transient_storage_size_mb; \
+    u32 arena_decommit_threshold_mb; \
+    b32 use_large_pages; \
+    u32 prefault_storage_mb; \
     u32 msaa_count; \
+    b32 use_shader_renderer; \
+    b32 use_software_renderer; \
+    u32 software_renderer_thread_count; \
     f32 master_volume; \
     f32 gameplay_volume; \
     f32 ui_volume; \
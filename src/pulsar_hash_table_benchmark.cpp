@@ -0,0 +1,249 @@
+#include <windows.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <assert.h>
+
+#include "pulsar_common.h"
+#include "pulsar_template_hash_table.h"
+
+// @Note: Measures HashTable lookups against the scans they replaced: the linear strings_are_equal scan that asset, console
+// command and serializable lookups used to do, and the Knuth hash with modulo probing that the editor used for entity
+// guids. Half of the lookups are for keys that aren't there. Before timing anything, the table is checked against a
+// plain array through a long run of random adds and removes.
+
+#define BENCHMARK_MIN_KEY_COUNT 4
+#define BENCHMARK_MAX_KEY_COUNT 65536
+#define BENCHMARK_LOOKUPS_PER_RUN 1000000
+#define BENCHMARK_RUNS 5
+
+global s64 perf_count_frequency;
+
+inline LARGE_INTEGER win32_get_clock() {
+    LARGE_INTEGER result;
+    QueryPerformanceCounter(&result);
+    return result;
+}
+
+inline f64 win32_get_seconds_elapsed(LARGE_INTEGER start, LARGE_INTEGER end) {
+    f64 result = cast(f64) (end.QuadPart - start.QuadPart) / cast(f64) perf_count_frequency;
+    return result;
+}
+
+inline void win32_initialize_perf_counter() {
+    LARGE_INTEGER perf_count_frequency_result;
+    QueryPerformanceFrequency(&perf_count_frequency_result);
+    perf_count_frequency = perf_count_frequency_result.QuadPart;
+}
+
+global RandomSeries random_series = { 0x12345678 };
+
+//
+// The old lookups
+//
+
+internal u32 linear_scan_find(u32 key_count, String* keys, String key) {
+    u32 result = UINT32_MAX;
+    for (u32 key_index = 0; key_index < key_count; key_index++) {
+        if (strings_are_equal(keys[key_index], key)) {
+            result = key_index;
+            break;
+        }
+    }
+    return result;
+}
+
+struct KnuthSlot {
+    u32 guid;
+    u32 value;
+};
+
+// @Note: The probing get_entity_hash_slot used to do, minus the insert on a miss
+internal KnuthSlot* knuth_find(u32 slot_count, KnuthSlot* slots, u32 guid) {
+    KnuthSlot* result = 0;
+
+    u32 hash_value = (guid*(guid + 3)) % slot_count;
+    for (u32 search = 0; search < slot_count; search++) {
+        KnuthSlot* slot = slots + (hash_value + search) % slot_count;
+        if (!slot->guid || slot->guid == guid) {
+            if (slot->guid) {
+                result = slot;
+            }
+            break;
+        }
+    }
+
+    return result;
+}
+
+internal void knuth_insert(u32 slot_count, KnuthSlot* slots, u32 guid, u32 value) {
+    u32 hash_value = (guid*(guid + 3)) % slot_count;
+    for (u32 search = 0; search < slot_count; search++) {
+        KnuthSlot* slot = slots + (hash_value + search) % slot_count;
+        if (!slot->guid || slot->guid == guid) {
+            slot->guid = guid;
+            slot->value = value;
+            break;
+        }
+    }
+}
+
+//
+// Validation
+//
+
+internal b32 validate_hash_table(MemoryArena* arena) {
+    u32 key_space = 4096;
+
+    HashTable<u32, u32> table;
+    initialize_hash_table(&table, allocator(arena_allocator, arena));
+
+    b32* present = push_array(arena, key_space, b32);
+    u32* values = push_array(arena, key_space, u32);
+    u32 present_count = 0;
+
+    for (u32 operation = 0; operation < 1000000; operation++) {
+        u32 key = random_u32(&random_series) % key_space;
+        u32 choice = random_u32(&random_series) % 3;
+        if (choice == 0) {
+            b32 added;
+            *hash_table_add(&table, key, &added) = operation;
+            if (added != !present[key]) {
+                fprintf(stderr, "Add of key %u disagreed about whether it was new\n", key);
+                return false;
+            }
+            present_count += added;
+            present[key] = true;
+            values[key] = operation;
+        } else if (choice == 1) {
+            b32 removed = hash_table_remove(&table, key);
+            if (removed != present[key]) {
+                fprintf(stderr, "Remove of key %u disagreed about whether it was there\n", key);
+                return false;
+            }
+            present_count -= removed;
+            present[key] = false;
+        } else {
+            u32* value = hash_table_find(&table, key);
+            if ((value != 0) != present[key] || (value && *value != values[key])) {
+                fprintf(stderr, "Find of key %u returned the wrong value\n", key);
+                return false;
+            }
+        }
+
+        if (table.count != present_count) {
+            fprintf(stderr, "Table count %u doesn't match %u keys\n", table.count, present_count);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// Timing
+//
+
+// @Note: Returns the best of BENCHMARK_RUNS in nanoseconds per lookup
+#define TIME_LOOKUPS(result, lookup_count, lookup_expression) {                             \
+    f64 best_seconds = DBL_MAX;                                                             \
+    for (u32 run = 0; run < BENCHMARK_RUNS; run++) {                                        \
+        u32 found = 0;                                                                      \
+        LARGE_INTEGER start = win32_get_clock();                                            \
+        for (u32 lookup_index = 0; lookup_index < (lookup_count); lookup_index++) {         \
+            found += (lookup_expression) ? 1 : 0;                                           \
+        }                                                                                   \
+        LARGE_INTEGER end = win32_get_clock();                                              \
+        sink += found;                                                                      \
+        best_seconds = MIN(best_seconds, win32_get_seconds_elapsed(start, end));           \
+    }                                                                                       \
+    (result) = 1.0e9*best_seconds / cast(f64) (lookup_count);                              \
+}
+
+global volatile u32 sink;
+
+int main(int argument_count, char** arguments) {
+    win32_initialize_perf_counter();
+    initialize_memory_kernels();
+
+    size_t arena_size = MEGABYTES(512);
+    MemoryArena arena;
+    initialize_arena(&arena, arena_size, _aligned_malloc(arena_size, 64));
+
+    {
+        TemporaryMemory temp = begin_temporary_memory(&arena);
+        b32 valid = validate_hash_table(&arena);
+        end_temporary_memory(temp);
+        if (!valid) {
+            return 1;
+        }
+    }
+
+    fprintf(stdout, "Nanoseconds per lookup, half of them misses\n\n");
+    fprintf(stdout, "%8s%16s%16s%16s%16s\n", "keys", "string scan", "string table", "guid knuth", "guid table");
+
+    for (u32 key_count = BENCHMARK_MIN_KEY_COUNT; key_count <= BENCHMARK_MAX_KEY_COUNT; key_count *= 4) {
+        TemporaryMemory temp = begin_temporary_memory(&arena);
+
+        // @Note: Keys shaped like asset names, which tend to share long prefixes
+        u32 query_count = 2*key_count;
+        String* queries = push_array(&arena, query_count, String);
+        for (u32 query_index = 0; query_index < query_count; query_index++) {
+            char* name = push_array(&arena, 32, char, no_clear());
+            s32 name_length = _snprintf(name, 32, "player_footstep_%u", query_index*7919);
+            queries[query_index] = wrap_string(cast(size_t) name_length, name);
+        }
+        String* keys = queries;
+
+        HashTable<String, u32> string_table;
+        initialize_hash_table(&string_table, allocator(arena_allocator, &arena));
+        for (u32 key_index = 0; key_index < key_count; key_index++) {
+            hash_table_insert(&string_table, keys[key_index], key_index);
+        }
+
+        u32 knuth_slot_count = 2*key_count;
+        KnuthSlot* knuth_slots = push_array(&arena, knuth_slot_count, KnuthSlot);
+        HashTable<u32, u32> guid_table;
+        initialize_hash_table(&guid_table, allocator(arena_allocator, &arena));
+        for (u32 key_index = 0; key_index < key_count; key_index++) {
+            knuth_insert(knuth_slot_count, knuth_slots, key_index + 1, key_index);
+            hash_table_insert(&guid_table, key_index + 1, key_index);
+        }
+
+        // @Note: Visit the queries in a shuffled order, so the scans can't get lucky with the branch predictor
+        u32* order = push_array(&arena, BENCHMARK_LOOKUPS_PER_RUN, u32, no_clear());
+        for (u32 lookup_index = 0; lookup_index < BENCHMARK_LOOKUPS_PER_RUN; lookup_index++) {
+            order[lookup_index] = random_u32(&random_series) % query_count;
+        }
+
+        // @Note: The first key_count queries are the keys, the rest are misses
+        for (u32 query_index = 0; query_index < query_count; query_index++) {
+            u32 expected = (query_index < key_count) ? query_index : UINT32_MAX;
+            u32* string_value = hash_table_find(&string_table, queries[query_index]);
+            KnuthSlot* knuth_slot = knuth_find(knuth_slot_count, knuth_slots, query_index + 1);
+            u32* guid_value = hash_table_find(&guid_table, query_index + 1);
+            if ((string_value ? *string_value : UINT32_MAX) != expected ||
+                (knuth_slot ? knuth_slot->value : UINT32_MAX) != expected ||
+                (guid_value ? *guid_value : UINT32_MAX) != expected) {
+                fprintf(stderr, "Lookups disagree for query %u with %u keys\n", query_index, key_count);
+                return 1;
+            }
+        }
+
+        // @Note: The scans are quadratic in total, so they get fewer lookups at the larger sizes
+        u32 scan_lookup_count = MIN(BENCHMARK_LOOKUPS_PER_RUN, 20000000 / key_count);
+
+        f64 string_scan_ns, string_table_ns, guid_knuth_ns, guid_table_ns;
+        TIME_LOOKUPS(string_scan_ns, scan_lookup_count, linear_scan_find(key_count, keys, queries[order[lookup_index]]) != UINT32_MAX);
+        TIME_LOOKUPS(string_table_ns, BENCHMARK_LOOKUPS_PER_RUN, hash_table_find(&string_table, queries[order[lookup_index]]));
+        TIME_LOOKUPS(guid_knuth_ns, scan_lookup_count, knuth_find(knuth_slot_count, knuth_slots, order[lookup_index] + 1));
+        TIME_LOOKUPS(guid_table_ns, BENCHMARK_LOOKUPS_PER_RUN, hash_table_find(&guid_table, order[lookup_index] + 1));
+
+        fprintf(stdout, "%8u%16.1f%16.1f%16.1f%16.1f\n", key_count, string_scan_ns, string_table_ns, guid_knuth_ns, guid_table_ns);
+
+        end_temporary_memory(temp);
+    }
+
+    return 0;
+}
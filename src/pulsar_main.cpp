@@ -7,10 +7,15 @@
 #include "external/rnd.h"
 
 #include "pulsar_assets.cpp"
+#include "pulsar_text_layout_cache.cpp"
+#include "pulsar_triangulation.cpp"
 #include "pulsar_audio_mixer.cpp"
 #include "pulsar_render_commands.cpp"
+#include "pulsar_render_capture.cpp"
+#include "pulsar_particles.cpp"
 #include "pulsar_gjk.cpp"
 #include "pulsar_entity.cpp"
+#include "pulsar_static_geometry.cpp"
 #include "pulsar_editor.cpp"
 #include "pulsar_console.cpp"
 
@@ -137,13 +142,19 @@ global Serializable entity_serializables[] = {
 
 /* Lev file layout:
 * LevFileHeader header;
+* for string_count:
+*     u32  string_length;
+*     char string[string_length];
 * for each entity serialized:
 *     u32 member_count; // number of members to follow
 *     for member_count:
+*         u32 member_name_index; // index into the string table
+*         u32 member_data_size;
+*         u8  member_data[member_data_size];
+*
+* Before version 3 there was no string table, and each member stored its name inline in place of member_name_index:
 *         u32  member_name_length;
 *         char member_name[member_name_length];
-*         u32  member_data_size;
-*         u8   member_data[member_data_size];
 */
 
 #pragma pack(push, 1)
@@ -151,44 +162,40 @@ struct LevFileHeader {
    struct {
        char magic[4];
        
-#define LEV_VERSION 2
+#define LEV_VERSION 3
        u32 version;
        
        u32 header_size;
    } prelude;
    
    u32 entity_count;
+   
+   // @Note: Version 3+
+   u32 string_count;
+   u32 string_table_size;
 };
 #pragma pack(pop)
 
 internal void write_level_to_disk(GameState* game_state, Level* level, String level_name) {
-   MemoryArena* arena = &game_state->transient_arena;
-   
-   TemporaryMemory temp = begin_temporary_memory(arena);
-   
-   LinearBuffer<u8>* stream = begin_linear_buffer<u8>(arena);
-   
-   // @TODO: I should have some kind of nice way to write byte streams to memory arenas
-#define write_stream(size, data) { u8* buf = lb_push_n(stream, size); copy(size, data, buf); }
-   
-   LevFileHeader header;
-   
-   header.prelude.magic[0] = 'l';
-   header.prelude.magic[1] = 'e';
-   header.prelude.magic[2] = 'v';
-   header.prelude.magic[3] = 'l';
+   TemporaryMemory scratch = get_scratch();
+   MemoryArena* arena = scratch.arena;
    
-   header.prelude.version = LEV_VERSION;
-   header.prelude.header_size = sizeof(header);
+   // @Note: The string table and the entity stream get built side by side and are written straight out of their chunks
+   ChunkedBuffer<u8>* strings = begin_chunked_buffer<u8>(arena, KILOBYTES(1));
+   ChunkedBuffer<u8>* stream = begin_chunked_buffer<u8>(arena, KILOBYTES(16));
    
-   header.entity_count = level->entity_count;
+   u32 string_count = 0;
+   u32 name_indices[ARRAY_COUNT(entity_serializables)];
+   for (u32 ser_index = 0; ser_index < ARRAY_COUNT(entity_serializables); ser_index++) {
+       name_indices[ser_index] = UINT32_MAX;
+   }
    
-   write_stream(sizeof(header), &header);
+#define write_stream(buf, size, data) cb_write(buf, size, cast(u8*) (data))
    
    for (u32 entity_index = 1; entity_index < level->entity_count; entity_index++) {
        Entity* entity = level->entities + entity_index;
        
-       u32* place_of_member_count = cast(u32*) lb_push_n(stream, sizeof(u32));
+       u32* place_of_member_count = cast(u32*) cb_push_n(stream, sizeof(u32));
        u32 member_count = 0;
        
        for (u32 ser_index = 0; ser_index < ARRAY_COUNT(entity_serializables); ser_index++) {
@@ -208,15 +215,21 @@ internal void write_level_to_disk(GameState* game_state, Level* level, String le
                if (ser_data.size > 0) {
                    member_count++;
                    
-                   write_stream(sizeof(u32), &ser->name.len);
-                   write_stream(ser->name.len, ser->name.data);
+                   if (name_indices[ser_index] == UINT32_MAX) {
+                       name_indices[ser_index] = string_count++;
+                       u32 name_length = safe_truncate_u64_u32(ser->name.len);
+                       write_stream(strings, sizeof(u32), &name_length);
+                       write_stream(strings, ser->name.len, ser->name.data);
+                   }
+                   
+                   write_stream(stream, sizeof(u32), &name_indices[ser_index]);
                    
                    if (ser_data.data_is_ptr) {
-                       write_stream(sizeof(u32), &ser_data.size);
-                       write_stream(ser_data.size, ser_data.data_ptr);
+                       write_stream(stream, sizeof(u32), &ser_data.size);
+                       write_stream(stream, ser_data.size, ser_data.data_ptr);
                    } else {
-                       write_stream(sizeof(u32), &ser_data.size);
-                       write_stream(ser_data.size, &ser_data.data_value);
+                       write_stream(stream, sizeof(u32), &ser_data.size);
+                       write_stream(stream, ser_data.size, &ser_data.data_value);
                    }
                }
            }
@@ -227,38 +240,84 @@ internal void write_level_to_disk(GameState* game_state, Level* level, String le
    
 #undef write_stream
    
-   end_linear_buffer(stream);
+   LevFileHeader header;
+   
+   header.prelude.magic[0] = 'l';
+   header.prelude.magic[1] = 'e';
+   header.prelude.magic[2] = 'v';
+   header.prelude.magic[3] = 'l';
+   
+   header.prelude.version = LEV_VERSION;
+   header.prelude.header_size = sizeof(header);
+   
+   header.entity_count = level->entity_count;
+   header.string_count = string_count;
+   header.string_table_size = safe_truncate_u64_u32(strings->count);
+   
+   u32 chunk_count = 0;
+   FileChunk* chunks = push_array(arena, 1 + strings->chunk_count + stream->chunk_count, FileChunk, no_clear());
+   
+   chunks[chunk_count].size = sizeof(header);
+   chunks[chunk_count].data = &header;
+   chunk_count++;
+   
+   for (BufferChunk* chunk = strings->first_chunk; chunk; chunk = chunk->next) {
+       chunks[chunk_count].size = safe_truncate_u64_u32(chunk->count);
+       chunks[chunk_count].data = chunk_data<u8>(chunk);
+       chunk_count++;
+   }
+   
+   for (BufferChunk* chunk = stream->first_chunk; chunk; chunk = chunk->next) {
+       chunks[chunk_count].size = safe_truncate_u64_u32(chunk->count);
+       chunks[chunk_count].data = chunk_data<u8>(chunk);
+       chunk_count++;
+   }
+   
+   end_chunked_buffer(strings);
+   end_chunked_buffer(stream);
    
    char* temp_level_name_cstr = push_string_and_null_terminate(arena, level_name.len, level_name.data);
-   platform.write_entire_file(temp_level_name_cstr, cast(u32) stream->count, stream->data);
+   platform.write_entire_file_chunked(temp_level_name_cstr, chunk_count, chunks);
    
    log_print(LogLevel_Info, "Saved level '%.*s' to disk", string_expand(level_name));
    
-   end_temporary_memory(temp);
+   release_scratch(scratch);
 }
 
-inline Serializable* find_serializable_by_name(u32 serializable_count, Serializable* serializables, String name) {
+inline void initialize_serializable_table(HashTable<String, u32>* table, MemoryArena* arena, u32 serializable_count, Serializable* serializables) {
+   initialize_hash_table(table, allocator(arena_allocator, arena), 2*serializable_count);
+   for (u32 ser_index = 0; ser_index < serializable_count; ser_index++) {
+       hash_table_insert(table, serializables[ser_index].name, ser_index);
+   }
+}
+
+inline Serializable* find_serializable_by_name(HashTable<String, u32>* table, Serializable* serializables, String name) {
    Serializable* result = 0;
    
-   for (u32 ser_index = 0; ser_index < serializable_count; ser_index++) {
-       Serializable* ser = serializables + ser_index;
-       if (strings_are_equal(name, ser->name)) {
-           result = ser;
-           break;
-       }
+   u32* ser_index = hash_table_find(table, name);
+   if (ser_index) {
+       result = serializables + *ser_index;
    }
    
    return result;
 }
 
+inline u8* read_level_stream(u8** stream, u8* stream_end, u64 size) {
+   u8* result = 0;
+   if (size <= cast(u64) (stream_end - *stream)) {
+       result = *stream;
+       *stream += size;
+   }
+   return result;
+}
+
 internal b32 load_level_from_disk(GameState* game_state, Level* level, String level_name) {
    assert(level);
    
-   MemoryArena* arena = &game_state->transient_arena;
-   
    b32 level_load_error = false;
    
-   TemporaryMemory temp = begin_temporary_memory(arena);
+   TemporaryMemory scratch = get_scratch();
+   MemoryArena* arena = scratch.arena;
    
    // @TODO: Start using String consistently to avoid this kind of sillyness
    char* temp_level_name_cstr = push_string_and_null_terminate(arena, level_name.len, level_name.data);
@@ -267,13 +326,22 @@ internal b32 load_level_from_disk(GameState* game_state, Level* level, String le
        u8* stream = cast(u8*) file.data;
        u8* stream_end = stream + file.size;
        
-#define read_stream(size) (assert(stream + (size) <= stream_end), stream += (size), stream - (size))
+       // @Note: Everything in the file gets checked against stream_end, because levels can come from anywhere.
+       // read_stream returns null if there aren't size bytes left.
+#define read_stream(size) read_level_stream(&stream, stream_end, (size))
        LevFileHeader* header = cast(LevFileHeader*) stream;
-       assert(header->prelude.header_size <= sizeof(*header));
        
-       stream += header->prelude.header_size;
+       u32 string_count = 0;
+       String* string_table = 0;
        
-       if (header->prelude.magic[0] == 'l' &&
+       if (file.size < sizeof(header->prelude) ||
+           header->prelude.header_size > MIN(file.size, sizeof(*header)) ||
+           header->prelude.header_size < offsetof(LevFileHeader, string_count) ||
+           (header->prelude.version >= 3 && header->prelude.header_size < sizeof(*header))
+           ) {
+           level_load_error = true;
+           log_print(LogLevel_Error, "Level Load Error: The header is cut off or the wrong size");
+       } else if (header->prelude.magic[0] == 'l' &&
            header->prelude.magic[1] == 'e' &&
            header->prelude.magic[2] == 'v' &&
            header->prelude.magic[3] == 'l'
@@ -282,6 +350,8 @@ internal b32 load_level_from_disk(GameState* game_state, Level* level, String le
                log_print(LogLevel_Warn, "Level Load Warning: Version mismatch: %u in file, expected %u", header->prelude.version, LEV_VERSION);
            }
            
+           stream += header->prelude.header_size;
+           
            assert(level_name.len <= ARRAY_COUNT(level->name));
            level->name_length = cast(u32) level_name.len;
            copy(level_name.len, level_name.data, level->name);
@@ -289,17 +359,72 @@ internal b32 load_level_from_disk(GameState* game_state, Level* level, String le
            level->entity_count = header->entity_count;
            level->first_available_guid = 1;
            
-           for (u32 entity_index = 1; entity_index < level->entity_count; entity_index++) {
+           if (level->entity_count > ARRAY_COUNT(level->entities)) {
+               level_load_error = true;
+               log_print(LogLevel_Error, "Level Load Error: %u entities in file, but a level holds at most %u", level->entity_count, cast(u32) ARRAY_COUNT(level->entities));
+           }
+           
+           if (!level_load_error && header->prelude.version >= 3) {
+               // @Note: The string table has to fit in what's left of the file, and its strings have to add up to it. Every
+               // string takes at least its u32 length, which bounds the count before the table gets allocated.
+               u32 string_table_size = header->string_table_size;
+               if (string_table_size <= cast(u64) (stream_end - stream) && header->string_count <= string_table_size / sizeof(u32)) {
+                   u8* string_table_end = stream + string_table_size;
+                   
+                   b32 strings_fit = true;
+                   string_count = header->string_count;
+                   string_table = push_array(arena, string_count, String, no_clear());
+                   for (u32 string_index = 0; string_index < string_count; string_index++) {
+                       u32* string_length = cast(u32*) read_level_stream(&stream, string_table_end, sizeof(u32));
+                       char* string_data = string_length ? cast(char*) read_level_stream(&stream, string_table_end, *string_length) : 0;
+                       if (!string_data) {
+                           strings_fit = false;
+                           break;
+                       }
+                       string_table[string_index] = wrap_string(*string_length, string_data);
+                   }
+                   
+                   if (!strings_fit || stream != string_table_end) {
+                       level_load_error = true;
+                       log_print(LogLevel_Error, "Level Load Error: The %u strings don't fit the %u byte string table", string_count, string_table_size);
+                   }
+               } else {
+                   level_load_error = true;
+                   log_print(LogLevel_Error, "Level Load Error: The string table is %u bytes for %u strings, with %u bytes left in the file", string_table_size, header->string_count, cast(u32) (stream_end - stream));
+               }
+           }
+           
+           for (u32 entity_index = 1; !level_load_error && entity_index < level->entity_count; entity_index++) {
                Entity* entity = level->entities + entity_index;
                
-               u32 member_count = *(cast(u32*) read_stream(sizeof(u32)));
+               u32* member_count = cast(u32*) read_stream(sizeof(u32));
+               if (!member_count) {
+                   level_load_error = true;
+                   log_print(LogLevel_Error, "Level Load Error: The file ends before entity %u", entity_index);
+                   break;
+               }
                
-               for (u32 member_index = 0; member_index < member_count; member_index++) {
-                   u32 member_name_length = *(cast(u32*) read_stream(sizeof(u32)));
-                   assert(member_name_length);
-                   char* member_name_c = cast(char*) read_stream(member_name_length);
-                   
-                   String member_name = wrap_string(member_name_length, member_name_c);
+               for (u32 member_index = 0; member_index < *member_count; member_index++) {
+                   String member_name;
+                   if (string_table) {
+                       u32* member_name_index = cast(u32*) read_stream(sizeof(u32));
+                       if (!member_name_index || *member_name_index >= string_count) {
+                           level_load_error = true;
+                           log_print(LogLevel_Error, "Level Load Error: Entity %u has a member name that is cut off or not in the string table", entity_index);
+                           break;
+                       }
+                       member_name = string_table[*member_name_index];
+                   } else {
+                       u32* member_name_length = cast(u32*) read_stream(sizeof(u32));
+                       char* member_name_c = member_name_length ? cast(char*) read_stream(*member_name_length) : 0;
+                       if (!member_name_c) {
+                           level_load_error = true;
+                           log_print(LogLevel_Error, "Level Load Error: Entity %u has a member name that is cut off", entity_index);
+                           break;
+                       }
+                       member_name = wrap_string(*member_name_length, member_name_c);
+                   }
+                   assert(member_name.len);
                    
                    // @Note: Remap renamed entity data
                    if (header->prelude.version < 2) {
@@ -308,10 +433,16 @@ internal b32 load_level_from_disk(GameState* game_state, Level* level, String le
                        }
                    }
                    
-                   u32 data_size = *(cast(u32*) read_stream(sizeof(u32)));
-                   void* data_source = read_stream(data_size);
+                   u32* data_size_in_file = cast(u32*) read_stream(sizeof(u32));
+                   void* data_source = data_size_in_file ? read_stream(*data_size_in_file) : 0;
+                   if (!data_source) {
+                       level_load_error = true;
+                       log_print(LogLevel_Error, "Level Load Error: Member '%.*s' of entity %u is cut off", string_expand(member_name), entity_index);
+                       break;
+                   }
+                   u32 data_size = *data_size_in_file;
                    
-                   Serializable* ser = find_serializable_by_name(ARRAY_COUNT(entity_serializables), entity_serializables, member_name);
+                   Serializable* ser = find_serializable_by_name(&game_state->entity_serializable_table, entity_serializables, member_name);
                    if (ser) {
                        void** data_dest = cast(void**) (cast(u8*) entity + ser->offset);
                        
@@ -343,7 +474,7 @@ internal b32 load_level_from_disk(GameState* game_state, Level* level, String le
                            break;
                        }
                    } else {
-                       log_print(LogLevel_Warn, "Level Load Warning: Could not find matching member '%.*s'", member_name_length, member_name);
+                       log_print(LogLevel_Warn, "Level Load Warning: Could not find matching member '%.*s'", string_expand(member_name));
                    }
                }
            }
@@ -378,7 +509,7 @@ internal b32 load_level_from_disk(GameState* game_state, Level* level, String le
        log_print(LogLevel_Info, "Successfully loaded level '%.*s'", string_expand(level_name));
    }
    
-   end_temporary_memory(temp);
+   release_scratch(scratch);
    
    return !level_load_error;
 }
@@ -400,26 +531,22 @@ inline String level_name(Level* level) {
    return result;
 }
 
+// @Note: Returns null if there are too many midi tracks playing already
 inline PlayingMidi* play_midi(GameState* game_state, MidiTrack* track, u32 flags = 0, PlayingSound* sync_sound = 0, Entity* source_soundtrack_player = 0) {
-   if (!game_state->first_free_playing_midi) {
-       game_state->first_free_playing_midi = push_struct(&game_state->permanent_arena, PlayingMidi);
-       game_state->first_free_playing_midi->next_free = 0;
+   PlayingMidi* playing_midi = pool_alloc(&game_state->playing_midis);
+   if (!playing_midi) {
+       log_print(LogLevel_Warn, "Too many midi tracks playing, could not play another one");
+       return 0;
    }
    
-   PlayingMidi* playing_midi = game_state->first_free_playing_midi;
-   game_state->first_free_playing_midi = playing_midi->next_free;
-   
-   *playing_midi = {};
    playing_midi->track = track;
    playing_midi->flags = flags;
    playing_midi->source_soundtrack_player = source_soundtrack_player;
-   playing_midi->sync_sound = sync_sound;
-   playing_midi->sync_sound->synced_midi = playing_midi;
+   if (sync_sound) {
+       playing_midi->sync_sound = sync_sound->handle;
+   }
    playing_midi->playback_rate = 1.0f;
    
-   playing_midi->next = game_state->first_playing_midi;
-   game_state->first_playing_midi = playing_midi;
-   
    String track_name = {};
    
    Asset* track_asset = cast(Asset*) track;
@@ -442,16 +569,19 @@ inline void change_playback_rate(PlayingMidi* midi, f32 playback_rate) {
    midi->playback_rate = clamp(playback_rate, 0.1f, 32.0f);
 }
 
-inline PlayingSound* play_soundtrack(GameState* game_state, Entity* soundtrack_player, u32 flags) {
-   PlayingSound* result = 0;
+inline Handle<PlayingSound> play_soundtrack(GameState* game_state, Entity* soundtrack_player, u32 flags) {
+   Handle<PlayingSound> result = {};
    Soundtrack* soundtrack = get_soundtrack(&game_state->assets, soundtrack_player->soundtrack_id);
    if (soundtrack) {
        Sound* sound = get_sound(&game_state->assets, soundtrack->sound);
        if (sound) {
-           result = play_sound(&game_state->game_audio, sound, vec2(0.5f, 0.5f), flags);
-           for (u32 midi_index = 0; midi_index < soundtrack->midi_track_count; midi_index++) {
-               MidiTrack* track = get_midi(&game_state->assets, soundtrack->midi_tracks[midi_index]);
-               PlayingMidi* playing_midi = play_midi(game_state, track, flags, result, soundtrack_player);
+           PlayingSound* playing_sound = play_sound(&game_state->game_audio, sound, vec2(0.5f, 0.5f), flags);
+           if (playing_sound) {
+               result = playing_sound->handle;
+               for (u32 midi_index = 0; midi_index < soundtrack->midi_track_count; midi_index++) {
+                   MidiTrack* track = get_midi(&game_state->assets, soundtrack->midi_tracks[midi_index]);
+                   PlayingMidi* playing_midi = play_midi(game_state, track, flags, playing_sound, soundtrack_player);
+               }
            }
        }
    }
@@ -460,15 +590,7 @@ inline PlayingSound* play_soundtrack(GameState* game_state, Entity* soundtrack_p
 }
 
 inline void stop_all_midi_tracks(GameState* game_state) {
-   PlayingMidi* last_playing_midi = game_state->first_playing_midi;
-   if (last_playing_midi) {
-       while (last_playing_midi->next) {
-           last_playing_midi = last_playing_midi->next;
-       }
-       last_playing_midi->next = game_state->first_free_playing_midi;
-       game_state->first_free_playing_midi = game_state->first_playing_midi;
-       game_state->first_playing_midi = 0;
-   }
+   clear_pool(&game_state->playing_midis);
    
    game_state->midi_event_buffer_count = 0;
 }
@@ -483,11 +605,11 @@ internal void play_level(GameState* game_state, Level* level) {
    for (u32 entity_index = 0; entity_index < level->entity_count; entity_index++) {
        Entity* entity = level->entities + entity_index;
        SortEntry* entry = sorted_entities + entity_index;
-       entry->sort_key = cast(f32) entity->type; // @TODO: Kind of weird to cast an enum to a float, makes me feel bad
+       entry->sort_key = entity->type;
        entry->index = entity_index;
    }
    
-   radix_sort(level->entity_count, sorted_entities, sort_temp);
+   coherent_sort_entries(&game_state->entity_sort, level->entity_count, sorted_entities, sort_temp);
    
    game_state->player = 0;
    
@@ -502,7 +624,7 @@ internal void play_level(GameState* game_state, Level* level) {
        
        *dest = *source;
        
-       EntityHash* hash = get_entity_hash_slot(game_state->editor_state, dest->guid);
+       EntityHash* hash = find_entity_hash_slot(game_state->editor_state, dest->guid);
        if (hash) {
            hash->gamestate_index = entity_index;
        }
@@ -527,6 +649,8 @@ internal void play_level(GameState* game_state, Level* level) {
    game_state->entity_type_counts[current_type] = current_type_count;
    game_state->entity_count = level->entity_count;
    
+   invalidate_static_geometry(&game_state->static_geometry);
+   
    if (!game_state->entity_type_counts[EntityType_Checkpoint]) {
        // @TODO: Handle invalid levels in some robust way
        log_print(LogLevel_Error, "Level '%.*s' has no checkpoints! This is not good! Fix it!! Now!!! Unless you're not in a position to fix it, in which case I'm sorry.", string_expand(level_name(level)));
@@ -605,9 +729,12 @@ inline void switch_game_mode(GameState* game_state, GameMode game_mode) {
        case GameMode_Menu: {
            menu->source_game_mode = prev_game_mode;
            
-           if (!menu->music) {
-               menu->music = play_sound(&game_state->ui_audio, get_sound_by_name(&game_state->assets, string_literal("menu_ambient")), vec2(0.0f, 0.0f), Playback_Looping);
-               change_volume(menu->music, 2.0f*game_config->menu_fade_in_speed, vec2(0.5f, 0.5f));
+           if (is_null(menu->music)) {
+               PlayingSound* music = play_sound(&game_state->ui_audio, get_sound_by_name(&game_state->assets, string_literal("menu_ambient")), vec2(0.0f, 0.0f), Playback_Looping);
+               if (music) {
+                   menu->music = music->handle;
+                   change_volume(&game_state->audio_mixer, menu->music, 2.0f*game_config->menu_fade_in_speed, vec2(0.5f, 0.5f));
+               }
            }
            
            unpause_group(&game_state->ui_audio, 1.0f);
@@ -693,13 +820,6 @@ inline void set_camera_view(RenderContext* rc, CameraView view) {
    render_worldspace(rc, view.vfov);
 }
 
-inline ParticleSystem create_particle_system(MemoryArena* arena, u32 count) {
-   ParticleSystem result;
-   result.count = count;
-   result.particles = push_array(arena, count, Particle);
-   return result;
-}
-
 internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
    assert(memory->permanent_storage_size >= sizeof(GameState));
    
@@ -713,12 +833,39 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
    GameState* game_state = cast(GameState*) memory->permanent_storage;
    
    if (!memory->initialized) {
-       initialize_arena(&game_state->permanent_arena, memory->permanent_storage_size - sizeof(GameState), cast(u8*) memory->permanent_storage + sizeof(GameState));
-       initialize_arena(&game_state->transient_arena, memory->transient_storage_size, memory->transient_storage);
+       // @Note: The platform only reserves our storage, so the GameState itself needs committing before we touch it
+       b32 game_state_committed = platform.commit(memory->permanent_storage, sizeof(GameState));
+       assert(game_state_committed);
+       
+       size_t decommit_threshold = MEGABYTES(cast(size_t) game_config->arena_decommit_threshold_mb);
+       initialize_growable_arena(&game_state->permanent_arena, memory->permanent_storage_size - sizeof(GameState), cast(u8*) memory->permanent_storage + sizeof(GameState), platform.commit, platform.decommit, decommit_threshold);
+       initialize_growable_arena(&game_state->transient_arena, memory->transient_storage_size, memory->transient_storage, platform.commit, platform.decommit, decommit_threshold);
+       name_arena(&game_state->permanent_arena, "Permanent");
+       name_arena(&game_state->transient_arena, "Transient");
+       
+       size_t scratch_arena_size = GIGABYTES(cast(size_t) 1);
+       void* scratch_memory = platform.reserve(SCRATCH_ARENA_COUNT*scratch_arena_size);
+       initialize_thread_context(&game_state->main_thread_context, scratch_arena_size, scratch_memory, platform.commit, platform.decommit, decommit_threshold);
+       set_thread_context(&game_state->main_thread_context);
+       
+       size_t frame_arena_size = GIGABYTES(cast(size_t) 1);
+       u8* frame_memory = cast(u8*) platform.reserve(ARRAY_COUNT(game_state->frame_arenas)*frame_arena_size);
+       for (u32 arena_index = 0; arena_index < ARRAY_COUNT(game_state->frame_arenas); arena_index++) {
+           MemoryArena* frame_arena = game_state->frame_arenas + arena_index;
+           initialize_growable_arena(frame_arena, frame_arena_size, frame_memory + arena_index*frame_arena_size, platform.commit, platform.decommit, decommit_threshold);
+           name_arena(frame_arena, "Frame");
+       }
        
        // @TODO: Make the load_assets routine ignorant of the platform's file system
        load_assets(&game_state->assets, &game_state->transient_arena, "assets.pla");
        
+       // @Note: The cached layouts point at the fonts that were just loaded, so loading them again needs a reset_text_layout_cache
+       game_state->text_layout_cache = push_struct(&game_state->permanent_arena, TextLayoutCache);
+       initialize_text_layout_cache(game_state->text_layout_cache, allocator(arena_allocator, &game_state->permanent_arena));
+       
+       game_state->triangulation_cache = push_struct(&game_state->permanent_arena, TriangulationCache);
+       initialize_triangulation_cache(game_state->triangulation_cache, allocator(arena_allocator, &game_state->permanent_arena));
+       
        game_state->sounds.player_footsteps[0] = get_sound_by_name(&game_state->assets, string_literal("player_footstep_1"));
        game_state->sounds.player_footsteps[1] = get_sound_by_name(&game_state->assets, string_literal("player_footstep_2"));
        game_state->sounds.player_footsteps[2] = get_sound_by_name(&game_state->assets, string_literal("player_footstep_3"));
@@ -732,16 +879,23 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
        game_state->sounds.player_land = get_sound_by_name(&game_state->assets, string_literal("player_land"));
        
        initialize_audio_mixer(&game_state->audio_mixer, &game_state->permanent_arena);
+       initialize_pool(&game_state->playing_midis, &game_state->permanent_arena);
        initialize_audio_group(&game_state->game_audio, &game_state->audio_mixer);
        initialize_audio_group(&game_state->ui_audio, &game_state->audio_mixer);
        
+       initialize_serializable_table(&game_state->entity_serializable_table, &game_state->permanent_arena, ARRAY_COUNT(entity_serializables), entity_serializables);
+       initialize_coherent_sort(&game_state->entity_sort, MAX_ENTITY_COUNT, game_state->entity_sort_permutation, game_state->entity_sort_indices);
+       
        initialize_render_context(&game_state->render_context, render_commands, 30.0f);
+       game_state->render_context.triangulation_cache = game_state->triangulation_cache;
        
        {
            ConsoleState* console = game_state->console_state = push_struct(&game_state->permanent_arena, ConsoleState);
            
            initialize_render_context(&game_state->console_state->rc, render_commands, 1.0f);
+           game_state->console_state->rc.triangulation_cache = game_state->triangulation_cache;
            console->font = get_font_by_name(&game_state->assets, string_literal("console_font"));
+           initialize_console_command_table(console, &game_state->permanent_arena);
        }
        
        {
@@ -763,29 +917,35 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
        
        game_state->editor_state = allocate_editor(game_state, render_commands);
        
-#if 0
        {
-           rnd_pcg_t pcg;
-           rnd_pcg_seed(&pcg, 0);
+           initialize_particle_simulation(&game_state->background_particles, &game_state->permanent_arena, BACKGROUND_PARTICLE_CAPACITY, 0.1f);
            
-           f32 aspect_ratio = get_aspect_ratio(&game_state->render_context);
-           game_state->background_particles = create_particle_system(&game_state->transient_arena, 1024);
-           ParticleSystem* bg_particles = &game_state->background_particles;
-           for (u32 particle_index = 0; particle_index < bg_particles->count; particle_index++) {
-               Particle particle;
-               particle.p = vec2(rnd_pcg_nextf(&pcg) - 0.5f, rnd_pcg_nextf(&pcg) - 0.5f)*vec2(30.0f*aspect_ratio, 30.0f);
-               particle.alpha = rnd_pcg_nextf(&pcg);
-               particle.depth = map_to_range(rnd_pcg_nextf(&pcg), 1.0f, 10.0f);
-               game_state->background_particles.particles[particle_index] = particle;
-           }
+           ParticleEmitter* emitter = &game_state->background_emitter;
+           emitter->particles_per_second = 2000.0f;
+           emitter->particles_per_note   = 1500.0f;
+           emitter->burst_radius         = 1.5f;
+           emitter->burst_speed          = 3.0f;
+           emitter->velocity             = vec2(0.0f, 0.5f);
+           emitter->velocity_spread      = vec2(0.25f, 0.25f);
+           emitter->min_lifetime         = 3.0f;
+           emitter->max_lifetime         = 8.0f;
+           emitter->min_alpha            = 0.1f;
+           emitter->max_alpha            = 0.6f;
+           emitter->min_depth            = 1.0f;
+           emitter->max_depth            = 10.0f;
        }
-#endif
        
        switch_game_mode(game_state, GameMode_Menu);
        
        memory->initialized = true;
    }
    
+   game_state->frame_index++;
+   MemoryArena* frame_arena = game_state->frame_arenas + (game_state->frame_index % ARRAY_COUNT(game_state->frame_arenas));
+   // @Note: If this fires, the platform started a frame before calling game_post_render on the frame that used this arena last
+   assert(frame_arena->used == 0);
+   render_commands->frame_arena = frame_arena;
+   
    game_state->audio_mixer.master_volume[0] = game_config->master_volume;
    game_state->audio_mixer.master_volume[1] = game_config->master_volume;
    
@@ -830,7 +990,7 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
        UILayoutContext layout_context;
        layout_context.rc = render_context;
        layout_context.assets = &game_state->assets;
-       layout_context.temp_arena = &game_state->transient_arena;
+       layout_context.text_cache = game_state->text_layout_cache;
        
        char* menu_items[32];
        u32 item_index = 0;
@@ -910,7 +1070,7 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
                if (menu->asking_for_quit_confirmation) {
                    if (menu->quit_timer <= 0.0f) {
                        menu->quit_timer = 1.0f;
-                       change_volume(menu->music, game_config->menu_quit_speed, vec2(0.0f, 0.0f));
+                       change_volume(&game_state->audio_mixer, menu->music, game_config->menu_quit_speed, vec2(0.0f, 0.0f));
                    } else {
                        play_the_sound = false;
                    }
@@ -936,12 +1096,12 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
                input->quit_requested = true;
            }
            f32 alpha = smoothstep(square_root(clamp01(1.1f*(1.0f - menu->quit_timer))));
-           push_shape(render_context, default_transform2d(), rectangle(aab_min_dim(vec2(0, 0), screen_dim)), vec4(0.0f, 0.0f, 0.0f, alpha));
+           push_shape(render_context, default_transform2d(), rectangle(aab_min_dim(vec2(0, 0), screen_dim)), vec4(0.0f, 0.0f, 0.0f, alpha), ShapeRenderMode_Fill, 10000.0f);
        }
        if (menu->fade_in_timer > 0.0f) {
            menu->fade_in_timer -= frame_dt / game_config->menu_fade_in_speed;
            f32 alpha = smoothstep(clamp01(1.1f*menu->fade_in_timer));
-           push_shape(render_context, default_transform2d(), rectangle(aab_min_dim(vec2(0, 0), screen_dim)), vec4(0.0f, 0.0f, 0.0f, alpha));
+           push_shape(render_context, default_transform2d(), rectangle(aab_min_dim(vec2(0, 0), screen_dim)), vec4(0.0f, 0.0f, 0.0f, alpha), ShapeRenderMode_Fill, 10000.0f);
        }
    } else {
        //
@@ -1094,9 +1254,22 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
            render_entities = game_state->active_level->entities;
        }
        
-       // push_particle_system(render_context, default_transform2d(), &game_state->background_particles, -1000.0f);
+       {
+           ParticleSimulation* background_particles = &game_state->background_particles;
+           v2 view_dim = vec2(get_aspect_ratio(render_context)*render_context->vertical_fov, render_context->vertical_fov);
+           AxisAlignedBox2 view = aab_center_dim(render_context->camera_p, view_dim);
+           
+           background_particles->max_count = render_commands->max_particle_count;
+           update_particle_emitter(background_particles, &game_state->background_emitter, view, render_context->camera_p, frame_dt);
+           simulate_particles(background_particles, frame_dt);
+           push_particles(render_context, background_particles, -1000.0f);
+       }
        
-       for (u32 entity_index = 1; entity_index < render_entity_count; entity_index++) {
+       StaticGeometryBake* static_geometry = update_static_geometry(&game_state->static_geometry, render_entities, render_entity_count, game_state->active_camera_zone, game_state->foreground_color);
+       push_static_geometry(render_context, static_geometry, vec2(0.0f, -game_config->background_pulse_world_shake_intensity*game_state->background_pulse_t));
+       
+       for (u32 dynamic_index = 0; dynamic_index < static_geometry->dynamic_entity_count; dynamic_index++) {
+           u32 entity_index = static_geometry->dynamic_entity_indices[dynamic_index];
            Entity* entity = render_entities + entity_index;
            assert(entity->type != EntityType_Null);
            
@@ -1155,8 +1328,8 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
                            INVALID_CODE_PATH;
                        }
                        if (editor->show_camera_zones) {
-                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), entity->active_region)), color, ShapeRenderMode_Outline, 1000.0f);
-                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), vec2(aspect_ratio*entity->view_region_height, entity->view_region_height))), color*vec4(1, 1, 1, 0.25f), ShapeRenderMode_Outline, 1000.0f);
+                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), entity->active_region)), color, ShapeRenderMode_Outline, EDITOR_OVERLAY_LAYER);
+                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), vec2(aspect_ratio*entity->view_region_height, entity->view_region_height))), color*vec4(1, 1, 1, 0.25f), ShapeRenderMode_Outline, EDITOR_OVERLAY_LAYER);
                        }
                    } break;
                    
@@ -1168,7 +1341,7 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
                            INVALID_CODE_PATH;
                        }
                        if (editor->show_checkpoint_zones) {
-                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), entity->checkpoint_zone)), game_state->last_activated_checkpoint == entity ? COLOR_GREEN : COLOR_RED, ShapeRenderMode_Outline, 1000.0f);
+                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), entity->checkpoint_zone)), game_state->last_activated_checkpoint == entity ? COLOR_GREEN : COLOR_RED, ShapeRenderMode_Outline, EDITOR_OVERLAY_LAYER);
                        }
                    } break;
                    
@@ -1180,8 +1353,8 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
                            INVALID_CODE_PATH;
                        }
                        if (editor->show_soundtrack_player_zones) {
-                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), entity->audible_zone + vec2(entity->horz_fade_region, entity->vert_fade_region))), vec4(COLOR_GREEN.rgb, 0.5f), ShapeRenderMode_Outline, 1000.0f);
-                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), entity->audible_zone)), COLOR_RED, ShapeRenderMode_Outline, 1000.0f);
+                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), entity->audible_zone + vec2(entity->horz_fade_region, entity->vert_fade_region))), vec4(COLOR_GREEN.rgb, 0.5f), ShapeRenderMode_Outline, EDITOR_OVERLAY_LAYER);
+                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), entity->audible_zone)), COLOR_RED, ShapeRenderMode_Outline, EDITOR_OVERLAY_LAYER);
                        }
                    } break;
                    
@@ -1201,7 +1374,7 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
                            } else if (entity->enveloping_player) {
                                color = COLOR_BLUE;
                            }
-                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), entity->trigger_zone)), color, ShapeRenderMode_Outline, 1000.0f);
+                           push_shape(render_context, transform, rectangle(aab_center_dim(vec2(0, 0), entity->trigger_zone)), color, ShapeRenderMode_Outline, EDITOR_OVERLAY_LAYER);
                        }
                    } break;
                    
@@ -1242,6 +1415,7 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
                // this breaks some stuff where the editor restores your camera position, or something. Bummer.)
                RenderContext rc_backup = *render_context;
                render_screenspace(render_context);
+               render_context->sort_key_bias += 10000.0f;
                push_rect(render_context, aab_min_dim(vec2(0, 0), screen_dim), vec4(0, 0, 0, game_state->level_intro_timer));
                *render_context = rc_backup;
            }
@@ -1273,12 +1447,13 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
                RenderContext rc_backup = *render_context;
                
                render_screenspace(render_context);
+               render_context->sort_key_bias += 10000.0f;
                push_rect(render_context, aab_min_dim(vec2(0, 0), screen_dim), vec4(0, 0, 0, smoothstep(fade_to_black_t)));
                
                UILayoutContext layout_context;
                layout_context.rc = render_context;
                layout_context.assets = &game_state->assets;
-               layout_context.temp_arena = &game_state->transient_arena;
+               layout_context.text_cache = game_state->text_layout_cache;
                
                UILayout outro_text = make_layout(layout_context, game_state->menu_state->big_font, 0.5f*screen_dim, Layout_CenterAlign);
                layout_print_line(&outro_text, vec4(COLOR_WHITE.rgb, text_alpha), "fin.");
@@ -1296,23 +1471,52 @@ internal GAME_UPDATE_AND_RENDER(game_update_and_render) {
            switch_game_mode(game_state, GameMode_Menu);
        }
    }
+   
+   if (game_state->capture_sort_keys) {
+       game_state->capture_sort_keys = false;
+       
+       TemporaryMemory scratch = get_scratch();
+       
+       u32 key_count = render_commands->sort_entry_count;
+       SortEntry* entries = cast(SortEntry*) render_commands->command_buffer;
+       u64* keys = push_array(scratch.arena, key_count, u64, no_clear());
+       for (u32 key_index = 0; key_index < key_count; key_index++) {
+           keys[key_index] = entries[key_index].sort_key;
+       }
+       
+       if (platform.write_entire_file(SORT_KEY_CAPTURE_FILE_NAME, cast(u32) (key_count*sizeof(u64)), keys)) {
+           log_print(LogLevel_Info, "Wrote %u render sort keys to '%s'", key_count, SORT_KEY_CAPTURE_FILE_NAME);
+       } else {
+           log_print(LogLevel_Error, "Could not write render sort keys to '%s'", SORT_KEY_CAPTURE_FILE_NAME);
+       }
+       
+       release_scratch(scratch);
+   }
+   
+   if (game_state->render_capture.frames_requested) {
+       capture_render_frame(&game_state->render_capture, render_commands, &game_state->assets);
+   }
 }
 
 internal GAME_GET_SOUND(game_get_sound) {
    assert(memory->initialized);
    GameState* game_state = cast(GameState*) memory->permanent_storage;
    
-   output_playing_sounds(&game_state->audio_mixer, sound_buffer, &game_state->transient_arena);
+   output_playing_sounds(&game_state->audio_mixer, sound_buffer);
 }
 
 internal GAME_POST_RENDER(game_post_render) {
    assert(memory->initialized);
    GameState* game_state = cast(GameState*) memory->permanent_storage;
    
-   // @Note: One day I'll use this... Or not. The idea of this function was to be able to purge temporary memory
-   // and such that I might want to use to send polygons generated during the frame to the renderer, but that
-   // temporary memory could also just be purged next time we enter game_update_and_render.
+   // @Note: The platform is done rendering and mixing the frame these commands came from, so anything they
+   // pointed into can go now.
+   if (render_commands->frame_arena) {
+       clear_arena(render_commands->frame_arena);
+       render_commands->frame_arena = 0;
+   }
    
    check_arena(&game_state->permanent_arena);
    check_arena(&game_state->transient_arena);
+   check_scratch_arenas();
 }
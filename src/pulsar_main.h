@@ -134,6 +134,8 @@
 
 #include "pulsar_common.h"
 #include "pulsar_platform_bridge.h"
+#include "pulsar_template_pool.h"
+#include "pulsar_template_hash_table.h"
 
 global GameConfig* game_config;
 
@@ -142,10 +144,15 @@ global GameConfig* game_config;
 #include "pulsar_opengl.h"
 
 #include "pulsar_assets.h"
+#include "pulsar_text_layout_cache.h"
+#include "pulsar_triangulation.h"
+#include "pulsar_render_capture.h"
 #include "pulsar_audio_mixer.h"
 #include "pulsar_gjk.h"
 #include "pulsar_entity.h"
 #include "pulsar_editor.h"
+#include "pulsar_static_geometry.h"
+#include "pulsar_particles.h"
 #include "pulsar_console.h"
 
 introspect() enum GameMode {
@@ -157,16 +164,11 @@ introspect() enum GameMode {
 };
 
 struct PlayingMidi {
-    union {
-        PlayingMidi* next;
-        PlayingMidi* next_free;
-    };
-
     Entity* source_soundtrack_player;
 
     // @Note: Without a sync sound, midi timing is going to be pretty rubbish.
     // With a sync sound however, it will be very good.
-    PlayingSound* sync_sound;
+    Handle<PlayingSound> sync_sound;
 
     f32 playback_rate;
     u32 tick_timer;
@@ -197,7 +199,7 @@ struct MenuState {
     Sound* select_sound;
     Sound* confirm_sound;
 
-    PlayingSound* music;
+    Handle<PlayingSound> music;
 
     u32 selected_item;
     f32 bob_t;
@@ -208,13 +210,28 @@ struct MenuState {
     f32 quit_timer;
 };
 
+#define SORT_KEY_CAPTURE_FILE_NAME "sort_keys.bin"
+
+// @Note: Room for a million particles, 32MB of the permanent arena, which is what the GL shader path is meant to draw.
+// How many there get to be is capped every frame by the backend's GameRenderCommands::max_particle_count.
+#define BACKGROUND_PARTICLE_CAPACITY (1 << 20)
+
 struct GameState {
     MemoryArena permanent_arena;
     MemoryArena transient_arena;
 
+    ThreadContext main_thread_context;
+
+    // @Note: The frame arenas alternate, so the next frame can be simulated while the previous one is still being
+    // rendered and mixed. Each one is cleared in game_post_render once the frame that filled it is done.
+    u32 frame_index;
+    MemoryArena frame_arenas[2];
+
     RenderContext render_context;
 
     Assets assets;
+    TextLayoutCache* text_layout_cache;
+    TriangulationCache* triangulation_cache;
 
     struct {
         Sound* player_land;
@@ -233,12 +250,15 @@ struct GameState {
     ConsoleState* console_state;
     EditorState* editor_state;
 
+    HashTable<String, u32> entity_serializable_table;
+
     v4 foreground_color;
     v4 background_color;
     f32 background_pulse_t;
     f32 background_pulse_dt;
 
-    ParticleSystem background_particles;
+    ParticleSimulation background_particles;
+    ParticleEmitter background_emitter;
 
     f32 player_respawn_timer;
     f32 player_self_destruct_timer;
@@ -258,6 +278,13 @@ struct GameState {
 
     String desired_level;
 
+    // @Note: Set by the capture_sort_keys console command, the next frame's render sort keys get written out in push
+    // order for pulsar_sort_benchmark.
+    b32 capture_sort_keys;
+
+    // @Note: Started by the capture_frames console command, for pulsar_render_replay
+    RenderCapture render_capture;
+
     Level* background_level;
     Level* active_level;
 
@@ -265,8 +292,7 @@ struct GameState {
     f32 level_outro_timer;
 
     b32 midi_paused;
-    PlayingMidi* first_playing_midi;
-    PlayingMidi* first_free_playing_midi;
+    Pool<PlayingMidi> playing_midis;
 
     u32 midi_event_buffer_count;
     ActiveMidiEvent midi_event_buffer[256];
@@ -275,6 +301,13 @@ struct GameState {
     u32 entity_type_counts [EntityType_Count];
     u32 entity_type_offsets[EntityType_Count];
     Entity entities[MAX_ENTITY_COUNT];
+
+    StaticGeometry static_geometry;
+
+    // @Note: play_level's sort by type, which mostly gets redone after the editor added or removed a single entity
+    CoherentSortState entity_sort;
+    u32 entity_sort_permutation[MAX_ENTITY_COUNT];
+    u32 entity_sort_indices[MAX_ENTITY_COUNT];
 };
 
 inline Entity* get_entities_for_type(GameState* game_state, EntityType type, u32* count = 0) {
@@ -298,7 +331,7 @@ inline Entity* get_entities_for_type(GameState* game_state, EntityType type, u32
          it < it##_loop_end;                                                  \
          ++it)
 
-inline PlayingSound* play_soundtrack(GameState* game_state, Entity* soundtrack_player, u32 flags = 0);
+inline Handle<PlayingSound> play_soundtrack(GameState* game_state, Entity* soundtrack_player, u32 flags = 0);
 
 inline void switch_game_mode(GameState* game_state, GameMode game_mode);
 internal void write_level_to_disk(GameState* game_state, Level* level, String level_name);
@@ -1,6 +1,8 @@
 #ifndef PULSAR_MEMORY_H
 #define PULSAR_MEMORY_H
 
+#include "pulsar_memory_kernels.h"
+
 enum AllocateFlag {
     AllocateFlag_ClearToZero = 0x1,
 };
@@ -19,6 +21,14 @@ struct Allocator {
     void* user_data;
 };
 
+// @Note: Hooks for arenas that reserve their address space up front and commit pages on demand.
+// The platform hands these out through PlatformAPI, since the shared headers can't talk to the OS.
+#define COMMIT_MEMORY(name) b32 name(void* address, size_t size)
+typedef COMMIT_MEMORY(CommitMemoryFunction);
+
+#define DECOMMIT_MEMORY(name) void name(void* address, size_t size)
+typedef DECOMMIT_MEMORY(DecommitMemoryFunction);
+
 inline Allocator allocator(AllocatorFunction* function, void* user_data) {
     Allocator result;
     result.alloc = function;
@@ -79,10 +89,10 @@ inline void deallocate(Allocator allocator, void* memory, AllocateParams params
     allocator.alloc(0, 0, memory, allocator.user_data, params);
 }
 
+// @Note: source and dest must not overlap
 inline void copy(size_t size, void* source_init, void* dest_init) {
-    u8* source = (u8*)source_init;
-    u8* dest = (u8*)dest_init;
-    while (size--) { *dest++= *source++; }
+    assert(cast(u8*) dest_init + size <= cast(u8*) source_init || cast(u8*) source_init + size <= cast(u8*) dest_init);
+    memory_kernels.copy(size, source_init, dest_init);
 }
 
 #if PULSAR_MEMORY_MALLOC_ALLOCATOR
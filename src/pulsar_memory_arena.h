@@ -2,6 +2,7 @@
 #define PULSAR_MEMORY_ARENA_H
 
 #define MEMORY_ARENA_DEFAULT_ALIGN 4
+#define MEMORY_ARENA_COMMIT_GRANULARITY KILOBYTES(64)
 
 struct MemoryArena {
     size_t size;
@@ -10,19 +11,192 @@ struct MemoryArena {
 
     s32 temp_count;
     void* active_linear_buffer;
+
+    // @Note: For growable arenas, size is the reserved address range and only the first `committed` bytes are backed
+    // by actual pages. Fixed arenas have committed == size and no commit function.
+    size_t committed;
+    size_t decommit_threshold;
+    CommitMemoryFunction* commit;
+    DecommitMemoryFunction* decommit;
+
+#if PULSAR_ARENA_INSTRUMENTATION
+    char* debug_name;
+    size_t high_water;
+    size_t temp_high_water;
+#endif
+};
+
+#if PULSAR_ARENA_INSTRUMENTATION
+enum ArenaCallSiteKind {
+    ArenaCallSite_Push,
+    ArenaCallSite_Temp,
+};
+
+struct ArenaCallSite {
+    ArenaCallSiteKind kind;
+    char* file;
+    u32 line;
+
+    u64 count;
+    u64 bytes;      // @Note: For temporary memory, this is the sum of the peak usage of each block
+    u64 peak_bytes;
 };
+#endif
 
 struct TemporaryMemory {
     MemoryArena* arena;
     size_t used;
+
+#if PULSAR_ARENA_INSTRUMENTATION
+    ArenaCallSite* call_site;
+    size_t outer_temp_high_water;
+#endif
 };
 
+//
+// Instrumentation
+//
+
+// @Note: With PULSAR_ARENA_INSTRUMENTATION, push_size_, begin_temporary_memory and get_scratch record where they were
+// called from. Arenas track their high-water marks, and allocation counts and bytes get accumulated per call site in
+// arena_instrumentation, which isn't thread safe.
+#if PULSAR_ARENA_INSTRUMENTATION
+#define ARENA_SOURCE_LOCATION_PARAMS char* source_file, u32 source_line,
+#define ARENA_FORWARD_SOURCE_LOCATION source_file, source_line,
+
+#define MAX_INSTRUMENTED_ARENAS 64
+#define MAX_ARENA_CALL_SITES 1024
+
+struct ArenaInstrumentation {
+    u32 arena_count;
+    MemoryArena* arenas[MAX_INSTRUMENTED_ARENAS];
+
+    u32 call_site_count;
+    ArenaCallSite call_sites[MAX_ARENA_CALL_SITES];
+};
+
+global ArenaInstrumentation arena_instrumentation;
+
+inline void register_instrumented_arena(MemoryArena* arena) {
+    b32 already_registered = false;
+    for (u32 arena_index = 0; arena_index < arena_instrumentation.arena_count; arena_index++) {
+        if (arena_instrumentation.arenas[arena_index] == arena) {
+            already_registered = true;
+            break;
+        }
+    }
+
+    if (!already_registered && arena_instrumentation.arena_count < MAX_INSTRUMENTED_ARENAS) {
+        arena_instrumentation.arenas[arena_instrumentation.arena_count++] = arena;
+    }
+}
+
+inline b32 source_files_are_equal(char* a, char* b) {
+    b32 result = (a == b);
+    if (!result) {
+        while (*a && *a == *b) {
+            a++;
+            b++;
+        }
+        result = (*a == *b);
+    }
+    return result;
+}
+
+inline ArenaCallSite* get_arena_call_site(ArenaCallSiteKind kind, char* file, u32 line) {
+    ArenaCallSite* result = 0;
+
+    u32 hash = (cast(u32) (cast(size_t) file) >> 4)*31 + line*2 + kind;
+    for (u32 probe = 0; probe < MAX_ARENA_CALL_SITES; probe++) {
+        ArenaCallSite* site = arena_instrumentation.call_sites + ((hash + probe) & (MAX_ARENA_CALL_SITES - 1));
+        if (!site->file) {
+            site->kind = kind;
+            site->file = file;
+            site->line = line;
+            arena_instrumentation.call_site_count++;
+            result = site;
+            break;
+        } else if (site->line == line && site->kind == kind && source_files_are_equal(site->file, file)) {
+            result = site;
+            break;
+        }
+    }
+
+    return result;
+}
+#else
+#define ARENA_SOURCE_LOCATION_PARAMS
+#define ARENA_FORWARD_SOURCE_LOCATION
+#endif
+
+inline void name_arena(MemoryArena* arena, char* name) {
+#if PULSAR_ARENA_INSTRUMENTATION
+    arena->debug_name = name;
+#endif
+}
+
 inline void initialize_arena(MemoryArena* arena, size_t size, void* base_ptr) {
     arena->size = size;
     arena->base_ptr = (u8*)base_ptr;
     arena->used = 0;
     arena->temp_count = 0;
     arena->active_linear_buffer = 0;
+
+    arena->committed = size;
+    arena->decommit_threshold = size;
+    arena->commit = 0;
+    arena->decommit = 0;
+
+#if PULSAR_ARENA_INSTRUMENTATION
+    arena->debug_name = 0;
+    arena->high_water = 0;
+    arena->temp_high_water = 0;
+    register_instrumented_arena(arena);
+#endif
+}
+
+// @Note: base_ptr is expected to point at reserved (but not necessarily committed) address space of reserve_size bytes.
+// Pages get committed as the arena grows, and anything committed past decommit_threshold is handed back to the OS
+// when the arena is cleared or a temporary memory block ends.
+inline void initialize_growable_arena(MemoryArena* arena, size_t reserve_size, void* base_ptr, CommitMemoryFunction* commit, DecommitMemoryFunction* decommit, size_t decommit_threshold) {
+    initialize_arena(arena, reserve_size, base_ptr);
+
+    assert(commit);
+    arena->committed = 0;
+    arena->decommit_threshold = decommit_threshold;
+    arena->commit = commit;
+    arena->decommit = decommit;
+}
+
+inline void commit_arena_up_to(MemoryArena* arena, size_t end) {
+    assert(arena->commit);
+    assert(end <= arena->size);
+
+    // @Note: Commit boundaries are aligned in absolute address space so that decommitting never touches a page
+    // that still holds part of a live allocation.
+    size_t base = cast(size_t) arena->base_ptr;
+    size_t new_committed = align_pow2(base + end, MEMORY_ARENA_COMMIT_GRANULARITY) - base;
+    if (new_committed > arena->size) {
+        new_committed = arena->size;
+    }
+
+    b32 commit_succeeded = arena->commit(arena->base_ptr + arena->committed, new_committed - arena->committed);
+    assert(commit_succeeded);
+
+    arena->committed = new_committed;
+}
+
+inline void decommit_arena_excess(MemoryArena* arena) {
+    if (arena->decommit && arena->committed > arena->decommit_threshold) {
+        size_t keep = MAX(arena->used, arena->decommit_threshold);
+
+        size_t base = cast(size_t) arena->base_ptr;
+        size_t decommit_start = align_pow2(base + keep, MEMORY_ARENA_COMMIT_GRANULARITY) - base;
+        if (decommit_start < arena->committed) {
+            arena->decommit(arena->base_ptr + decommit_start, arena->committed - decommit_start);
+            arena->committed = decommit_start;
+        }
+    }
 }
 
 inline size_t get_alignment_offset(MemoryArena* arena, size_t align, size_t at) {
@@ -50,11 +224,7 @@ inline size_t get_arena_size_remaining(MemoryArena* arena, AllocateParams params
 #define zero_struct(instance) zero_size(sizeof(instance), &(instance))
 #define zero_array(count, pointer) zero_size(count*sizeof((pointer)[0]), pointer)
 inline void* zero_size(size_t size, void* ptr) {
-    // TODO: Check this for performance
-    u8* byte = (u8*)ptr;
-    while (size--) {
-        *byte++ = 0;
-    }
+    memory_kernels.zero(size, ptr);
     return ptr;
 }
 
@@ -70,6 +240,12 @@ inline b32 arena_has_room_for(MemoryArena* arena, size_t size, AllocateParams pa
     return result;
 }
 
+inline b32 arena_owns_address(MemoryArena* arena, void* address) {
+    u8* at = cast(u8*) address;
+    b32 result = at >= arena->base_ptr && at < arena->base_ptr + arena->used;
+    return result;
+}
+
 inline void* get_next_allocation_location(MemoryArena* arena, size_t align = MEMORY_ARENA_DEFAULT_ALIGN) {
     size_t align_offset = get_alignment_offset(arena, align);
     void* result = cast(void*) (arena->base_ptr + arena->used + align_offset);
@@ -80,7 +256,12 @@ inline void* get_next_allocation_location(MemoryArena* arena, size_t align = MEM
 #define push_struct(arena, type, ...) (type*)push_size_(arena, sizeof(type), ##__VA_ARGS__)
 #define push_array(arena, count, type, ...) (type*)push_size_(arena, sizeof(type) * (count), ##__VA_ARGS__)
 #define push_size(arena, size, ...) push_size_(arena, size, ##__VA_ARGS__)
-inline void* push_size_(MemoryArena* arena, size_t size_init, AllocateParams params = default_allocate_params(), void* lb = 0) {
+#if PULSAR_ARENA_INSTRUMENTATION
+#define push_size_(arena, size, ...) push_size_at(__FILE__, __LINE__, arena, size, ##__VA_ARGS__)
+#else
+#define push_size_(arena, size, ...) push_size_at(arena, size, ##__VA_ARGS__)
+#endif
+inline void* push_size_at(ARENA_SOURCE_LOCATION_PARAMS MemoryArena* arena, size_t size_init, AllocateParams params = default_allocate_params(), void* lb = 0) {
     assert(arena->active_linear_buffer == lb);
 
     s32 align = align_or(params, MEMORY_ARENA_DEFAULT_ALIGN);
@@ -88,10 +269,26 @@ inline void* push_size_(MemoryArena* arena, size_t size_init, AllocateParams par
     size_t size = get_effective_size_for(arena, size_init, params);
 
     assert((arena->used + size) <= arena->size);
+    if ((arena->used + size) > arena->committed) {
+        commit_arena_up_to(arena, arena->used + size);
+    }
+
     size_t align_offset = get_alignment_offset(arena, align);
     void* result = (arena->base_ptr + arena->used + align_offset);
     arena->used += size;
 
+#if PULSAR_ARENA_INSTRUMENTATION
+    if (arena->used > arena->high_water)      arena->high_water      = arena->used;
+    if (arena->used > arena->temp_high_water) arena->temp_high_water = arena->used;
+
+    ArenaCallSite* site = get_arena_call_site(ArenaCallSite_Push, source_file, source_line);
+    if (site) {
+        site->count++;
+        site->bytes += size;
+        if (size > site->peak_bytes) site->peak_bytes = size;
+    }
+#endif
+
     if (params.flags & AllocateFlag_ClearToZero) {
         zero_size(size_init, result);
     }
@@ -151,6 +348,136 @@ inline void end_linear_buffer(LinearBuffer<T>* buf) {
     buf->arena = 0;
 }
 
+// @Note: Unlike LinearBuffer, a ChunkedBuffer doesn't claim the arena while it's open, so any number of them can be
+// written to at the same time, interleaved with regular allocations. The data lives in a chain of chunks. As long as
+// nothing else gets pushed in the meantime the last chunk simply grows in place, so a buffer that was written in one
+// go ends up as a single contiguous chunk.
+struct BufferChunk {
+    BufferChunk* next;
+    size_t count;
+    size_t capacity;
+};
+
+template <typename T>
+struct ChunkedBuffer {
+    MemoryArena* arena;
+    u32 flags;
+    size_t min_chunk_capacity;
+    size_t count;
+    size_t chunk_count;
+    BufferChunk* first_chunk;
+    BufferChunk* last_chunk;
+};
+
+template <typename T>
+inline T* chunk_data(BufferChunk* chunk) {
+    T* result = cast(T*) (chunk + 1);
+    return result;
+}
+
+template <typename T>
+inline ChunkedBuffer<T>* begin_chunked_buffer(MemoryArena* arena, size_t min_chunk_capacity = 64, AllocateParams params = no_clear()) {
+    ChunkedBuffer<T>* buf = push_struct(arena, ChunkedBuffer<T>);
+    buf->arena = arena;
+    buf->flags = params.flags;
+    buf->min_chunk_capacity = min_chunk_capacity ? min_chunk_capacity : 1;
+    return buf;
+}
+
+template <typename T>
+inline T* cb_push_n(ChunkedBuffer<T>* buf, size_t n) {
+    MemoryArena* arena = buf->arena;
+    assert(arena);
+
+    BufferChunk* chunk = buf->last_chunk;
+    if (chunk && (chunk->count + n) > chunk->capacity) {
+        u8* chunk_end = cast(u8*) (chunk_data<T>(chunk) + chunk->capacity);
+        size_t grow_count = MAX(chunk->count + n - chunk->capacity, chunk->capacity);
+        if (!arena->active_linear_buffer &&
+            chunk_end == get_next_allocation_location(arena, 1) &&
+            arena_has_room_for(arena, grow_count*sizeof(T), align(1, false)))
+        {
+            // @Note: Nothing was allocated after this chunk, so we can just extend it
+            push_size_(arena, grow_count*sizeof(T), align_flags(1, buf->flags));
+            chunk->capacity += grow_count;
+        } else {
+            chunk = 0;
+        }
+    }
+
+    if (!chunk) {
+        size_t capacity = MAX(MAX(n, buf->min_chunk_capacity), buf->count);
+        chunk = cast(BufferChunk*) push_size_(arena, sizeof(BufferChunk) + capacity*sizeof(T), align_flags(alignof(BufferChunk), buf->flags));
+        chunk->next = 0;
+        chunk->count = 0;
+        chunk->capacity = capacity;
+
+        if (buf->last_chunk) {
+            buf->last_chunk->next = chunk;
+        } else {
+            buf->first_chunk = chunk;
+        }
+        buf->last_chunk = chunk;
+        buf->chunk_count++;
+    }
+
+    T* result = chunk_data<T>(chunk) + chunk->count;
+    chunk->count += n;
+    buf->count += n;
+
+    return result;
+}
+
+template <typename T>
+inline T* cb_push(ChunkedBuffer<T>* buf) {
+    T* result = cb_push_n(buf, 1);
+    return result;
+}
+
+template <typename T>
+inline T* cb_add(ChunkedBuffer<T>* buf, T item) {
+    T* result = cb_push(buf);
+    *result = item;
+    return result;
+}
+
+template <typename T>
+inline T* cb_write(ChunkedBuffer<T>* buf, size_t n, T* source) {
+    T* result = cb_push_n(buf, n);
+    copy(n*sizeof(T), source, result);
+    return result;
+}
+
+template <typename T>
+inline b32 cb_is_contiguous(ChunkedBuffer<T>* buf) {
+    b32 result = buf->chunk_count <= 1;
+    return result;
+}
+
+// @Note: Returns the buffer's data as one span. If the buffer is still a single chunk that's just a pointer into it,
+// otherwise the chunks get gathered into a fresh block on the arena. If you want to avoid that copy, walk the chunks
+// with first_chunk/next instead.
+template <typename T>
+inline T* cb_get_contiguous(ChunkedBuffer<T>* buf) {
+    T* result = 0;
+    if (buf->chunk_count == 1) {
+        result = chunk_data<T>(buf->first_chunk);
+    } else if (buf->chunk_count > 1) {
+        result = push_array(buf->arena, buf->count, T, no_clear());
+        T* at = result;
+        for (BufferChunk* chunk = buf->first_chunk; chunk; chunk = chunk->next) {
+            copy(chunk->count*sizeof(T), chunk_data<T>(chunk), at);
+            at += chunk->count;
+        }
+    }
+    return result;
+}
+
+template <typename T>
+inline void end_chunked_buffer(ChunkedBuffer<T>* buf) {
+    buf->arena = 0;
+}
+
 inline char* push_string(MemoryArena* arena, size_t length, char* source) {
     assert((arena->used + length) <= arena->size);
 
@@ -174,9 +501,27 @@ inline void sub_arena(MemoryArena* result, MemoryArena* arena, size_t size, Allo
     result->base_ptr = (u8*)push_size_(arena, size, params);
     result->used = 0;
     result->temp_count = 0;
+
+    // @Note: push_size_ committed the whole block, so sub arenas are always fixed
+    result->committed = size;
+    result->decommit_threshold = size;
+    result->commit = 0;
+    result->decommit = 0;
+
+#if PULSAR_ARENA_INSTRUMENTATION
+    result->debug_name = 0;
+    result->high_water = 0;
+    result->temp_high_water = 0;
+    register_instrumented_arena(result);
+#endif
 }
 
-inline TemporaryMemory begin_temporary_memory(MemoryArena* arena) {
+#if PULSAR_ARENA_INSTRUMENTATION
+#define begin_temporary_memory(arena) begin_temporary_memory_at(__FILE__, __LINE__, arena)
+#else
+#define begin_temporary_memory(arena) begin_temporary_memory_at(arena)
+#endif
+inline TemporaryMemory begin_temporary_memory_at(ARENA_SOURCE_LOCATION_PARAMS MemoryArena* arena) {
     TemporaryMemory result;
 
     result.arena = arena;
@@ -184,18 +529,41 @@ inline TemporaryMemory begin_temporary_memory(MemoryArena* arena) {
 
     arena->temp_count++;
 
+#if PULSAR_ARENA_INSTRUMENTATION
+    result.call_site = get_arena_call_site(ArenaCallSite_Temp, source_file, source_line);
+    result.outer_temp_high_water = arena->temp_high_water;
+    arena->temp_high_water = arena->used;
+#endif
+
     return result;
 }
 
 inline void end_temporary_memory(TemporaryMemory temp_mem) {
     MemoryArena* arena = temp_mem.arena;
+
+#if PULSAR_ARENA_INSTRUMENTATION
+    size_t temp_bytes = arena->temp_high_water - temp_mem.used;
+    if (temp_mem.call_site) {
+        temp_mem.call_site->count++;
+        temp_mem.call_site->bytes += temp_bytes;
+        if (temp_bytes > temp_mem.call_site->peak_bytes) temp_mem.call_site->peak_bytes = temp_bytes;
+    }
+    arena->temp_high_water = MAX(arena->temp_high_water, temp_mem.outer_temp_high_water);
+#endif
+
     arena->used = temp_mem.used;
     assert(arena->temp_count > 0);
     arena->temp_count--;
+
+    decommit_arena_excess(arena);
 }
 
 inline void clear_arena(MemoryArena* arena) {
-    initialize_arena(arena, arena->size, arena->base_ptr);
+    arena->used = 0;
+    arena->temp_count = 0;
+    arena->active_linear_buffer = 0;
+
+    decommit_arena_excess(arena);
 }
 
 inline void check_arena(MemoryArena* arena) {
@@ -203,6 +571,78 @@ inline void check_arena(MemoryArena* arena) {
     assert(arena->active_linear_buffer == 0);
 }
 
+// @Note: Scratch arenas are per-thread arenas for short lived temporary memory. get_scratch hands out one that isn't
+// any of the given conflicts, which matters when the caller is itself allocating its results on a scratch arena it got
+// from further up the stack. Every thread that wants scratch memory needs its own ThreadContext set up first.
+#define SCRATCH_ARENA_COUNT 2
+
+struct ThreadContext {
+    MemoryArena scratch_arenas[SCRATCH_ARENA_COUNT];
+};
+
+global thread_local ThreadContext* thread_context;
+
+inline void initialize_thread_context(ThreadContext* context, size_t scratch_arena_size, void* reserved_memory, CommitMemoryFunction* commit, DecommitMemoryFunction* decommit, size_t decommit_threshold) {
+    // @Note: reserved_memory is expected to hold SCRATCH_ARENA_COUNT*scratch_arena_size bytes of reserved address space
+    for (u32 arena_index = 0; arena_index < SCRATCH_ARENA_COUNT; arena_index++) {
+        void* base_ptr = cast(u8*) reserved_memory + arena_index*scratch_arena_size;
+        initialize_growable_arena(context->scratch_arenas + arena_index, scratch_arena_size, base_ptr, commit, decommit, decommit_threshold);
+        name_arena(context->scratch_arenas + arena_index, "Scratch");
+    }
+}
+
+inline void set_thread_context(ThreadContext* context) {
+    thread_context = context;
+}
+
+#if PULSAR_ARENA_INSTRUMENTATION
+#define get_scratch(...) get_scratch_at(__FILE__, __LINE__, ##__VA_ARGS__)
+#else
+#define get_scratch(...) get_scratch_at(__VA_ARGS__)
+#endif
+inline TemporaryMemory get_scratch_at(ARENA_SOURCE_LOCATION_PARAMS u32 conflict_count, MemoryArena** conflicts) {
+    assert(thread_context);
+
+    MemoryArena* arena = 0;
+    for (u32 arena_index = 0; arena_index < SCRATCH_ARENA_COUNT; arena_index++) {
+        MemoryArena* candidate = thread_context->scratch_arenas + arena_index;
+
+        b32 conflicts_with_candidate = false;
+        for (u32 conflict_index = 0; conflict_index < conflict_count; conflict_index++) {
+            if (conflicts[conflict_index] == candidate) {
+                conflicts_with_candidate = true;
+                break;
+            }
+        }
+
+        if (!conflicts_with_candidate) {
+            arena = candidate;
+            break;
+        }
+    }
+
+    assert(arena);
+    TemporaryMemory result = begin_temporary_memory_at(ARENA_FORWARD_SOURCE_LOCATION arena);
+    return result;
+}
+
+inline TemporaryMemory get_scratch_at(ARENA_SOURCE_LOCATION_PARAMS MemoryArena* conflict = 0) {
+    TemporaryMemory result = get_scratch_at(ARENA_FORWARD_SOURCE_LOCATION conflict ? 1 : 0, &conflict);
+    return result;
+}
+
+inline void release_scratch(TemporaryMemory scratch) {
+    end_temporary_memory(scratch);
+}
+
+inline void check_scratch_arenas() {
+    if (thread_context) {
+        for (u32 arena_index = 0; arena_index < SCRATCH_ARENA_COUNT; arena_index++) {
+            check_arena(thread_context->scratch_arenas + arena_index);
+        }
+    }
+}
+
 // @Note: A good citizen would put this in a .cpp
 internal ALLOCATOR(arena_allocator) {
     MemoryArena* arena = cast(MemoryArena*) user_data;
@@ -0,0 +1,184 @@
+#include <windows.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <assert.h>
+
+#include "pulsar_common.h"
+
+// @Note: Measures the copy() and zero_size() kernels against the byte loops they replaced, for block sizes from 16 bytes
+// to 64 megabytes. Every kernel is checked against the byte loops first, over all small sizes and misalignments.
+
+#define BENCHMARK_MIN_SIZE 16
+#define BENCHMARK_MAX_SIZE MEGABYTES(64)
+#define BENCHMARK_BYTES_PER_RUN MEGABYTES(256)
+#define BENCHMARK_RUNS 5
+
+global s64 perf_count_frequency;
+
+inline LARGE_INTEGER win32_get_clock() {
+    LARGE_INTEGER result;
+    QueryPerformanceCounter(&result);
+    return result;
+}
+
+inline f64 win32_get_seconds_elapsed(LARGE_INTEGER start, LARGE_INTEGER end) {
+    f64 result = cast(f64) (end.QuadPart - start.QuadPart) / cast(f64) perf_count_frequency;
+    return result;
+}
+
+inline void win32_initialize_perf_counter() {
+    LARGE_INTEGER perf_count_frequency_result;
+    QueryPerformanceFrequency(&perf_count_frequency_result);
+    perf_count_frequency = perf_count_frequency_result.QuadPart;
+}
+
+internal COPY_KERNEL(copy_byte_loop) {
+    u8* source = cast(u8*) source_init;
+    u8* dest = cast(u8*) dest_init;
+    while (size--) { *dest++= *source++; }
+}
+
+internal ZERO_KERNEL(zero_byte_loop) {
+    u8* byte = cast(u8*) ptr;
+    while (size--) {
+        *byte++ = 0;
+    }
+}
+
+struct BenchmarkKernel {
+    char* name;
+    CopyKernel* copy;
+    ZeroKernel* zero;
+};
+
+internal b32 validate_kernel(BenchmarkKernel* kernel, u8* source, u8* dest, u8* expected) {
+    for (size_t size = 0; size <= 1024; size++) {
+        for (size_t source_offset = 0; source_offset < 64; source_offset += 7) {
+            for (size_t dest_offset = 0; dest_offset < 64; dest_offset++) {
+                memset(dest, 0xCD, size + 128);
+                memset(expected, 0xCD, size + 128);
+                copy_byte_loop(size, source + source_offset, expected + dest_offset);
+                kernel->copy(size, source + source_offset, dest + dest_offset);
+                if (memcmp(dest, expected, size + 128) != 0) {
+                    fprintf(stderr, "%s copy failed: size %zu, source offset %zu, dest offset %zu\n", kernel->name, size, source_offset, dest_offset);
+                    return false;
+                }
+
+                memset(dest, 0xCD, size + 128);
+                memset(expected, 0xCD, size + 128);
+                zero_byte_loop(size, expected + dest_offset);
+                kernel->zero(size, dest + dest_offset);
+                if (memcmp(dest, expected, size + 128) != 0) {
+                    fprintf(stderr, "%s zero failed: size %zu, dest offset %zu\n", kernel->name, size, dest_offset);
+                    return false;
+                }
+            }
+        }
+    }
+
+    // @Note: One big misaligned block to cover the non-temporal path
+    size_t size = MEMORY_KERNEL_NON_TEMPORAL_THRESHOLD + 12345;
+    memset(dest, 0xCD, size + 128);
+    memset(expected, 0xCD, size + 128);
+    copy_byte_loop(size, source + 3, expected + 5);
+    kernel->copy(size, source + 3, dest + 5);
+    if (memcmp(dest, expected, size + 128) != 0) {
+        fprintf(stderr, "%s copy failed: size %zu\n", kernel->name, size);
+        return false;
+    }
+
+    zero_byte_loop(size, expected + 5);
+    kernel->zero(size, dest + 5);
+    if (memcmp(dest, expected, size + 128) != 0) {
+        fprintf(stderr, "%s zero failed: size %zu\n", kernel->name, size);
+        return false;
+    }
+
+    return true;
+}
+
+// @Note: Returns the best of BENCHMARK_RUNS in gigabytes per second
+internal f64 time_kernel(BenchmarkKernel* kernel, b32 zero, size_t size, u8* source, u8* dest) {
+    size_t iterations = MAX(BENCHMARK_BYTES_PER_RUN / size, 4);
+
+    f64 best_seconds = DBL_MAX;
+    for (u32 run = 0; run < BENCHMARK_RUNS; run++) {
+        LARGE_INTEGER start = win32_get_clock();
+        if (zero) {
+            for (size_t iteration = 0; iteration < iterations; iteration++) {
+                kernel->zero(size, dest);
+            }
+        } else {
+            for (size_t iteration = 0; iteration < iterations; iteration++) {
+                kernel->copy(size, source, dest);
+            }
+        }
+        LARGE_INTEGER end = win32_get_clock();
+
+        f64 seconds = win32_get_seconds_elapsed(start, end);
+        best_seconds = MIN(best_seconds, seconds);
+    }
+
+    f64 result = (cast(f64) iterations*cast(f64) size) / (best_seconds*1.0e9);
+    return result;
+}
+
+int main(int argument_count, char** arguments) {
+    win32_initialize_perf_counter();
+    initialize_memory_kernels();
+
+    size_t buffer_size = BENCHMARK_MAX_SIZE + 128;
+    u8* source   = cast(u8*) _aligned_malloc(buffer_size, 64);
+    u8* dest     = cast(u8*) _aligned_malloc(buffer_size, 64);
+    u8* expected = cast(u8*) _aligned_malloc(buffer_size, 64);
+
+    for (size_t byte_index = 0; byte_index < buffer_size; byte_index++) {
+        source[byte_index] = cast(u8) (byte_index*31 + 7);
+    }
+    memset(dest, 0, buffer_size);
+
+    BenchmarkKernel kernels[3];
+    u32 kernel_count = 0;
+    kernels[kernel_count++] = { "byte loop", copy_byte_loop, zero_byte_loop };
+    kernels[kernel_count++] = { "SSE2", copy_sse2, zero_sse2 };
+    if (cpu_supports_avx2()) {
+        kernels[kernel_count++] = { "AVX2", copy_avx2, zero_avx2 };
+    } else {
+        fprintf(stderr, "AVX2 isn't available on this machine, skipping it\n");
+    }
+
+    for (u32 kernel_index = 1; kernel_index < kernel_count; kernel_index++) {
+        if (!validate_kernel(kernels + kernel_index, source, dest, expected)) {
+            return 1;
+        }
+    }
+
+    fprintf(stdout, "Dispatch picked the %s kernels, non-temporal stores from %zu bytes\n\n", memory_kernels.name, cast(size_t) MEMORY_KERNEL_NON_TEMPORAL_THRESHOLD);
+
+    for (u32 zero = 0; zero < 2; zero++) {
+        fprintf(stdout, "%s (GB/s)\n", zero ? "zero_size" : "copy");
+        fprintf(stdout, "%12s", "size");
+        for (u32 kernel_index = 0; kernel_index < kernel_count; kernel_index++) {
+            fprintf(stdout, "%12s", kernels[kernel_index].name);
+        }
+        fprintf(stdout, "\n");
+
+        for (size_t size = BENCHMARK_MIN_SIZE; size <= BENCHMARK_MAX_SIZE; size *= 2) {
+            fprintf(stdout, "%12zu", size);
+            for (u32 kernel_index = 0; kernel_index < kernel_count; kernel_index++) {
+                f64 gigabytes_per_second = time_kernel(kernels + kernel_index, zero, size, source, dest);
+                fprintf(stdout, "%12.2f", gigabytes_per_second);
+            }
+            fprintf(stdout, "\n");
+        }
+        fprintf(stdout, "\n");
+    }
+
+    _aligned_free(source);
+    _aligned_free(dest);
+    _aligned_free(expected);
+
+    return 0;
+}
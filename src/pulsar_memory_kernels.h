@@ -0,0 +1,305 @@
+#ifndef PULSAR_MEMORY_KERNELS_H
+#define PULSAR_MEMORY_KERNELS_H
+
+// @Note: Bulk copy and clear kernels behind copy() and zero_size(). Every x64 cpu has SSE2, so that's the default,
+// and initialize_memory_kernels() switches to the AVX2 versions once at startup if cpuid and the OS say YMM state is
+// usable. Blocks past MEMORY_KERNEL_NON_TEMPORAL_THRESHOLD are written with streaming stores, so clearing or copying
+// something like the command buffer doesn't evict everything else from the cache on the way.
+
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define MEMORY_KERNEL_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define MEMORY_KERNEL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#define MEMORY_KERNEL_NON_TEMPORAL_THRESHOLD MEGABYTES(2)
+
+#define COPY_KERNEL(name) void name(size_t size, void* source_init, void* dest_init)
+typedef COPY_KERNEL(CopyKernel);
+
+#define ZERO_KERNEL(name) void name(size_t size, void* ptr)
+typedef ZERO_KERNEL(ZeroKernel);
+
+// @Note: Blocks smaller than a vector. Copies and clears 8, 4 and 1 bytes at a time.
+inline void copy_small(size_t size, u8* source, u8* dest) {
+    while (size >= 8) {
+        _mm_storel_epi64(cast(__m128i*) dest, _mm_loadl_epi64(cast(__m128i*) source));
+        source += 8;
+        dest += 8;
+        size -= 8;
+    }
+    while (size--) {
+        *dest++ = *source++;
+    }
+}
+
+inline void zero_small(size_t size, u8* dest) {
+    while (size >= 8) {
+        _mm_storel_epi64(cast(__m128i*) dest, _mm_setzero_si128());
+        dest += 8;
+        size -= 8;
+    }
+    while (size--) {
+        *dest++ = 0;
+    }
+}
+
+internal COPY_KERNEL(copy_sse2) {
+    u8* source = cast(u8*) source_init;
+    u8* dest = cast(u8*) dest_init;
+
+    if (size < 16) {
+        copy_small(size, source, dest);
+        return;
+    }
+
+    // @Note: The head and tail are done with unaligned vectors that may overlap the aligned body, which saves a
+    // scalar prologue and epilogue.
+    __m128i head = _mm_loadu_si128(cast(__m128i*) source);
+    __m128i tail = _mm_loadu_si128(cast(__m128i*) (source + size - 16));
+
+    size_t prologue = (16 - (cast(size_t) dest & 15)) & 15;
+    u8* at = dest + prologue;
+    u8* from = source + prologue;
+    size_t body = (size - prologue) & ~cast(size_t) 63;
+
+    if (size >= MEMORY_KERNEL_NON_TEMPORAL_THRESHOLD) {
+        for (u8* end = at + body; at < end; at += 64, from += 64) {
+            __m128i a = _mm_loadu_si128(cast(__m128i*) (from + 0));
+            __m128i b = _mm_loadu_si128(cast(__m128i*) (from + 16));
+            __m128i c = _mm_loadu_si128(cast(__m128i*) (from + 32));
+            __m128i d = _mm_loadu_si128(cast(__m128i*) (from + 48));
+            _mm_stream_si128(cast(__m128i*) (at + 0), a);
+            _mm_stream_si128(cast(__m128i*) (at + 16), b);
+            _mm_stream_si128(cast(__m128i*) (at + 32), c);
+            _mm_stream_si128(cast(__m128i*) (at + 48), d);
+        }
+        _mm_sfence();
+    } else {
+        for (u8* end = at + body; at < end; at += 64, from += 64) {
+            __m128i a = _mm_loadu_si128(cast(__m128i*) (from + 0));
+            __m128i b = _mm_loadu_si128(cast(__m128i*) (from + 16));
+            __m128i c = _mm_loadu_si128(cast(__m128i*) (from + 32));
+            __m128i d = _mm_loadu_si128(cast(__m128i*) (from + 48));
+            _mm_store_si128(cast(__m128i*) (at + 0), a);
+            _mm_store_si128(cast(__m128i*) (at + 16), b);
+            _mm_store_si128(cast(__m128i*) (at + 32), c);
+            _mm_store_si128(cast(__m128i*) (at + 48), d);
+        }
+    }
+
+    for (u8* end = dest + size - 16; at < end; at += 16, from += 16) {
+        _mm_store_si128(cast(__m128i*) at, _mm_loadu_si128(cast(__m128i*) from));
+    }
+
+    _mm_storeu_si128(cast(__m128i*) dest, head);
+    _mm_storeu_si128(cast(__m128i*) (dest + size - 16), tail);
+}
+
+internal ZERO_KERNEL(zero_sse2) {
+    u8* dest = cast(u8*) ptr;
+
+    if (size < 16) {
+        zero_small(size, dest);
+        return;
+    }
+
+    __m128i zero = _mm_setzero_si128();
+    _mm_storeu_si128(cast(__m128i*) dest, zero);
+
+    u8* at = dest + ((16 - (cast(size_t) dest & 15)) & 15);
+    size_t body = (size - (at - dest)) & ~cast(size_t) 63;
+
+    if (size >= MEMORY_KERNEL_NON_TEMPORAL_THRESHOLD) {
+        for (u8* end = at + body; at < end; at += 64) {
+            _mm_stream_si128(cast(__m128i*) (at + 0), zero);
+            _mm_stream_si128(cast(__m128i*) (at + 16), zero);
+            _mm_stream_si128(cast(__m128i*) (at + 32), zero);
+            _mm_stream_si128(cast(__m128i*) (at + 48), zero);
+        }
+        _mm_sfence();
+    } else {
+        for (u8* end = at + body; at < end; at += 64) {
+            _mm_store_si128(cast(__m128i*) (at + 0), zero);
+            _mm_store_si128(cast(__m128i*) (at + 16), zero);
+            _mm_store_si128(cast(__m128i*) (at + 32), zero);
+            _mm_store_si128(cast(__m128i*) (at + 48), zero);
+        }
+    }
+
+    for (u8* end = dest + size - 16; at < end; at += 16) {
+        _mm_store_si128(cast(__m128i*) at, zero);
+    }
+
+    _mm_storeu_si128(cast(__m128i*) (dest + size - 16), zero);
+}
+
+MEMORY_KERNEL_TARGET_AVX2 internal COPY_KERNEL(copy_avx2) {
+    u8* source = cast(u8*) source_init;
+    u8* dest = cast(u8*) dest_init;
+
+    if (size < 32) {
+        if (size >= 16) {
+            __m128i head = _mm_loadu_si128(cast(__m128i*) source);
+            __m128i tail = _mm_loadu_si128(cast(__m128i*) (source + size - 16));
+            _mm_storeu_si128(cast(__m128i*) dest, head);
+            _mm_storeu_si128(cast(__m128i*) (dest + size - 16), tail);
+        } else {
+            copy_small(size, source, dest);
+        }
+        return;
+    }
+
+    __m256i head = _mm256_loadu_si256(cast(__m256i*) source);
+    __m256i tail = _mm256_loadu_si256(cast(__m256i*) (source + size - 32));
+
+    size_t prologue = (32 - (cast(size_t) dest & 31)) & 31;
+    u8* at = dest + prologue;
+    u8* from = source + prologue;
+    size_t body = (size - prologue) & ~cast(size_t) 127;
+
+    if (size >= MEMORY_KERNEL_NON_TEMPORAL_THRESHOLD) {
+        for (u8* end = at + body; at < end; at += 128, from += 128) {
+            __m256i a = _mm256_loadu_si256(cast(__m256i*) (from + 0));
+            __m256i b = _mm256_loadu_si256(cast(__m256i*) (from + 32));
+            __m256i c = _mm256_loadu_si256(cast(__m256i*) (from + 64));
+            __m256i d = _mm256_loadu_si256(cast(__m256i*) (from + 96));
+            _mm256_stream_si256(cast(__m256i*) (at + 0), a);
+            _mm256_stream_si256(cast(__m256i*) (at + 32), b);
+            _mm256_stream_si256(cast(__m256i*) (at + 64), c);
+            _mm256_stream_si256(cast(__m256i*) (at + 96), d);
+        }
+        _mm_sfence();
+    } else {
+        for (u8* end = at + body; at < end; at += 128, from += 128) {
+            __m256i a = _mm256_loadu_si256(cast(__m256i*) (from + 0));
+            __m256i b = _mm256_loadu_si256(cast(__m256i*) (from + 32));
+            __m256i c = _mm256_loadu_si256(cast(__m256i*) (from + 64));
+            __m256i d = _mm256_loadu_si256(cast(__m256i*) (from + 96));
+            _mm256_store_si256(cast(__m256i*) (at + 0), a);
+            _mm256_store_si256(cast(__m256i*) (at + 32), b);
+            _mm256_store_si256(cast(__m256i*) (at + 64), c);
+            _mm256_store_si256(cast(__m256i*) (at + 96), d);
+        }
+    }
+
+    for (u8* end = dest + size - 32; at < end; at += 32, from += 32) {
+        _mm256_store_si256(cast(__m256i*) at, _mm256_loadu_si256(cast(__m256i*) from));
+    }
+
+    _mm256_storeu_si256(cast(__m256i*) dest, head);
+    _mm256_storeu_si256(cast(__m256i*) (dest + size - 32), tail);
+
+    // @Note: Avoid the AVX-SSE transition penalty in whatever SSE code runs next
+    _mm256_zeroupper();
+}
+
+MEMORY_KERNEL_TARGET_AVX2 internal ZERO_KERNEL(zero_avx2) {
+    u8* dest = cast(u8*) ptr;
+
+    if (size < 32) {
+        if (size >= 16) {
+            _mm_storeu_si128(cast(__m128i*) dest, _mm_setzero_si128());
+            _mm_storeu_si128(cast(__m128i*) (dest + size - 16), _mm_setzero_si128());
+        } else {
+            zero_small(size, dest);
+        }
+        return;
+    }
+
+    __m256i zero = _mm256_setzero_si256();
+    _mm256_storeu_si256(cast(__m256i*) dest, zero);
+
+    u8* at = dest + ((32 - (cast(size_t) dest & 31)) & 31);
+    size_t body = (size - (at - dest)) & ~cast(size_t) 127;
+
+    if (size >= MEMORY_KERNEL_NON_TEMPORAL_THRESHOLD) {
+        for (u8* end = at + body; at < end; at += 128) {
+            _mm256_stream_si256(cast(__m256i*) (at + 0), zero);
+            _mm256_stream_si256(cast(__m256i*) (at + 32), zero);
+            _mm256_stream_si256(cast(__m256i*) (at + 64), zero);
+            _mm256_stream_si256(cast(__m256i*) (at + 96), zero);
+        }
+        _mm_sfence();
+    } else {
+        for (u8* end = at + body; at < end; at += 128) {
+            _mm256_store_si256(cast(__m256i*) (at + 0), zero);
+            _mm256_store_si256(cast(__m256i*) (at + 32), zero);
+            _mm256_store_si256(cast(__m256i*) (at + 64), zero);
+            _mm256_store_si256(cast(__m256i*) (at + 96), zero);
+        }
+    }
+
+    for (u8* end = dest + size - 32; at < end; at += 32) {
+        _mm256_store_si256(cast(__m256i*) at, zero);
+    }
+
+    _mm256_storeu_si256(cast(__m256i*) (dest + size - 32), zero);
+
+    _mm256_zeroupper();
+}
+
+struct MemoryKernels {
+    CopyKernel* copy;
+    ZeroKernel* zero;
+    char* name;
+};
+
+global MemoryKernels memory_kernels = { copy_sse2, zero_sse2, "SSE2" };
+
+inline b32 cpu_supports_avx2() {
+    u32 leaf1[4] = {};
+    u32 leaf7[4] = {};
+
+#if defined(_MSC_VER)
+    __cpuid(cast(int*) leaf1, 1);
+    if (leaf1[0] >= 7) {
+        __cpuidex(cast(int*) leaf7, 7, 0);
+    }
+#else
+    u32 max_leaf = __get_cpuid_max(0, 0);
+    __cpuid(1, leaf1[0], leaf1[1], leaf1[2], leaf1[3]);
+    if (max_leaf >= 7) {
+        __cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]);
+    }
+#endif
+
+    b32 result = false;
+
+    b32 os_uses_xsave = leaf1[2] & (1 << 27);
+    b32 cpu_has_avx   = leaf1[2] & (1 << 28);
+    if (os_uses_xsave && cpu_has_avx) {
+        // @Note: The cpu having AVX doesn't mean the OS saves the YMM registers on a context switch, so ask XCR0 too
+#if defined(_MSC_VER)
+        u64 xcr0 = _xgetbv(0);
+#else
+        u32 xcr0_lo, xcr0_hi;
+        __asm__ volatile ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        u64 xcr0 = (cast(u64) xcr0_hi << 32) | xcr0_lo;
+#endif
+        b32 os_saves_ymm = (xcr0 & 0x6) == 0x6;
+        b32 cpu_has_avx2 = leaf7[1] & (1 << 5);
+        result = os_saves_ymm && cpu_has_avx2;
+    }
+
+    return result;
+}
+
+inline void initialize_memory_kernels() {
+    if (cpu_supports_avx2()) {
+        memory_kernels.copy = copy_avx2;
+        memory_kernels.zero = zero_avx2;
+        memory_kernels.name = "AVX2";
+    } else {
+        memory_kernels.copy = copy_sse2;
+        memory_kernels.zero = zero_sse2;
+        memory_kernels.name = "SSE2";
+    }
+}
+
+#endif /* PULSAR_MEMORY_KERNELS_H */
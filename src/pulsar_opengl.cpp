@@ -11,9 +11,8 @@ inline void opengl_set_screenspace(u32 width, u32 height) {
     glLoadMatrixf(projection_matrix);
 }
 
-inline void opengl_rectangle(v2 min_p, v2 x_axis, v2 y_axis, v4 color, GLuint render_mode, v2 min_uv = vec2(0, 0), v2 max_uv = vec2(0, 0)) {
-    glBegin(render_mode);
-
+// @Note: Has to be called between glBegin(GL_TRIANGLES) and glEnd
+inline void opengl_quad_vertices(v2 min_p, v2 x_axis, v2 y_axis, v4 color, v2 min_uv, v2 max_uv) {
     glColor4fv(color.e);
 
     v2 min_x_min_y = min_p;
@@ -36,7 +35,11 @@ inline void opengl_rectangle(v2 min_p, v2 x_axis, v2 y_axis, v4 color, GLuint re
     glVertex2fv(max_x_max_y.e);
     glTexCoord2f(min_uv.x, max_uv.y);
     glVertex2fv(min_x_max_y.e);
+}
 
+inline void opengl_rectangle(v2 min_p, v2 x_axis, v2 y_axis, v4 color, GLuint render_mode, v2 min_uv = vec2(0, 0), v2 max_uv = vec2(0, 0)) {
+    glBegin(render_mode);
+    opengl_quad_vertices(min_p, x_axis, y_axis, color, min_uv, max_uv);
     glEnd();
 }
 
@@ -57,6 +60,45 @@ inline void opengl_texture(GLuint handle, AxisAlignedBox2 aab, v4 color = vec4(1
     opengl_texture(handle, get_min_corner(aab), vec2(dim.x, 0.0f), vec2(0.0f, dim.y), color, min_uv, max_uv);
 }
 
+inline void opengl_end_batch(OpenGLBatch* batch) {
+    if (batch->open) {
+        glEnd();
+        batch->open = false;
+    }
+}
+
+inline void opengl_set_batch_texture(OpenGLBatch* batch, GLuint texture) {
+    if (batch->texture != texture) {
+        opengl_end_batch(batch);
+        if (texture) {
+            if (!batch->texture) {
+                glEnable(GL_TEXTURE_2D);
+            }
+            glBindTexture(GL_TEXTURE_2D, texture);
+        } else {
+            glDisable(GL_TEXTURE_2D);
+        }
+        batch->texture = texture;
+    }
+}
+
+// @Note: Makes sure a GL_TRIANGLES batch with the given texture is open, only starting a new one if it has to
+inline void opengl_begin_triangles(OpenGLBatch* batch, GLuint texture) {
+    opengl_set_batch_texture(batch, texture);
+    if (!batch->open) {
+        glBegin(GL_TRIANGLES);
+        batch->open = true;
+        batch->batch_count++;
+    }
+}
+
+// @Note: For anything that draws outside of a batch, with its own glBegin/glEnd
+inline void opengl_begin_unbatched(OpenGLBatch* batch) {
+    opengl_end_batch(batch);
+    opengl_set_batch_texture(batch, 0);
+    batch->batch_count++;
+}
+
 internal GLuint opengl_load_texture(OpenGLInfo* opengl_info, u32 w, u32 h, void* pixels) {
     // @TODO: Ponder different texture formats
     GLuint texture_handle;
@@ -75,9 +117,12 @@ internal GLuint opengl_load_texture(OpenGLInfo* opengl_info, u32 w, u32 h, void*
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    if (!opengl_info->core_profile) {
+        // @Note: Texture environments are fixed function only, the shader path does the modulate itself
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    }
 
     glBindTexture(GL_TEXTURE_2D, 0);
     glFlush();
@@ -95,11 +140,13 @@ inline void opengl_check_extension(OpenGLInfo* info, String extension) {
     else if GL_CHECK_EXTENSION(GL_EXT_framebuffer_sRGB)
     else if GL_CHECK_EXTENSION(GL_ARB_framebuffer_sRGB)
     else if GL_CHECK_EXTENSION(GL_ARB_multisample)
+    else if GL_CHECK_EXTENSION(GL_ARB_buffer_storage)
 #undef GL_CHECK_EXTENSION
 }
 
-internal void opengl_get_info(b32 modern_context, OpenGLInfo* info) {
+internal void opengl_get_info(b32 modern_context, b32 core_profile, OpenGLInfo* info) {
     info->modern_context = modern_context;
+    info->core_profile = core_profile;
     info->vendor = (char*)glGetString(GL_VENDOR);
     info->renderer = (char*)glGetString(GL_RENDERER);
     info->version = (char*)glGetString(GL_VERSION);
@@ -109,7 +156,8 @@ internal void opengl_get_info(b32 modern_context, OpenGLInfo* info) {
         info->shading_language_version = "(none)";
     }
 
-    info->extensions = (char*)glGetString(GL_EXTENSIONS);
+    // @Note: Core profiles don't have the one big extension string anymore
+    info->extensions = core_profile ? "" : (char*)glGetString(GL_EXTENSIONS);
 
     if (modern_context && glGetStringi) {
         GLint num_extensions;
@@ -139,20 +187,436 @@ internal void opengl_get_info(b32 modern_context, OpenGLInfo* info) {
     }
 }
 
-internal void opengl_init(b32 modern_context, OpenGLInfo* info) {
-    opengl_get_info(modern_context, info);
+internal void opengl_init(b32 modern_context, b32 core_profile, OpenGLInfo* info) {
+    opengl_get_info(modern_context, core_profile, info);
 
     info->default_internal_texture_format = GL_RGBA8;
-    if ((info->GL_EXT_framebuffer_sRGB || info->GL_ARB_framebuffer_sRGB) && (info->GL_EXT_texture_sRGB)) {
+    // @Note: sRGB textures and framebuffers are core since 3.0, so core profiles don't necessarily list the extensions
+    if (core_profile || ((info->GL_EXT_framebuffer_sRGB || info->GL_ARB_framebuffer_sRGB) && (info->GL_EXT_texture_sRGB))) {
         info->default_internal_texture_format = GL_SRGB8_ALPHA8;
         glEnable(GL_FRAMEBUFFER_SRGB);
     }
-    if (info->GL_ARB_multisample) {
+    if (core_profile || info->GL_ARB_multisample) {
         glEnable(GL_MULTISAMPLE_ARB);
     }
 }
 
-internal void opengl_render_commands(GameRenderCommands* commands) {
+//
+// Shader path
+//
+
+global char* opengl_vertex_shader_source = R"GLSL(
+#version 330 core
+
+uniform vec2 screen_scale;
+
+in vec2 in_p;
+in vec2 in_uv;
+in vec4 in_color;
+
+out vec2 uv;
+out vec4 color;
+
+void main() {
+    gl_Position = vec4(in_p*screen_scale - 1.0, 0.0, 1.0);
+    uv = in_uv;
+    color = in_color;
+}
+)GLSL";
+
+global char* opengl_fragment_shader_source = R"GLSL(
+#version 330 core
+
+uniform sampler2D texture_sampler;
+
+in vec2 uv;
+in vec4 color;
+
+out vec4 out_color;
+
+void main() {
+    out_color = color*texture(texture_sampler, uv);
+}
+)GLSL";
+
+// @Note: The quad's corners come from gl_VertexID, and everything else about the particle from its instance
+global char* opengl_particle_vertex_shader_source = R"GLSL(
+#version 330 core
+
+uniform vec2 screen_scale;
+uniform vec2 origin;
+uniform vec2 x_axis;
+uniform vec2 half_size;
+
+in float in_x;
+in float in_y;
+in float in_alpha;
+
+out vec2 uv;
+out vec4 color;
+
+const vec2 corners[6] = vec2[6](vec2(-1, -1), vec2(1, -1), vec2(1, 1), vec2(-1, -1), vec2(1, 1), vec2(-1, 1));
+
+void main() {
+    vec2 y_axis = vec2(-x_axis.y, x_axis.x);
+    vec2 p = origin + x_axis*in_x + y_axis*in_y + corners[gl_VertexID]*half_size;
+    gl_Position = vec4(p*screen_scale - 1.0, 0.0, 1.0);
+    uv = vec2(0.0, 0.0);
+    color = vec4(in_alpha);
+}
+)GLSL";
+
+enum OpenGLVertexAttribute {
+    OpenGLVertexAttribute_P,
+    OpenGLVertexAttribute_UV,
+    OpenGLVertexAttribute_Color,
+};
+
+enum OpenGLParticleAttribute {
+    OpenGLParticleAttribute_X,
+    OpenGLParticleAttribute_Y,
+    OpenGLParticleAttribute_Alpha,
+};
+
+internal GLuint opengl_compile_shader(OpenGLInfo* info, GLenum type, char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, 0);
+    glCompileShader(shader);
+
+    GLint compiled = false;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        glGetShaderInfoLog(shader, sizeof(info->shader_log), 0, info->shader_log);
+        glDeleteShader(shader);
+        shader = 0;
+    }
+
+    return shader;
+}
+
+// @Note: Returns true if the program linked, the buffers got made and the shader path is good to go
+internal b32 opengl_init_shader_path(OpenGLInfo* info) {
+#define GL_CHECK_FUNCTION(name) if (!name) { stbsp_snprintf(info->shader_log, sizeof(info->shader_log), "Missing " #name); return false; }
+    OPENGL_SHADER_PATH_FUNCTIONS(GL_CHECK_FUNCTION)
+#undef GL_CHECK_FUNCTION
+
+    OpenGLStream* stream = &info->stream;
+    zero_struct(*stream);
+
+    GLuint vertex_shader = opengl_compile_shader(info, GL_VERTEX_SHADER, opengl_vertex_shader_source);
+    GLuint particle_vertex_shader = opengl_compile_shader(info, GL_VERTEX_SHADER, opengl_particle_vertex_shader_source);
+    GLuint fragment_shader = opengl_compile_shader(info, GL_FRAGMENT_SHADER, opengl_fragment_shader_source);
+    if (!vertex_shader || !particle_vertex_shader || !fragment_shader) {
+        return false;
+    }
+
+    stream->program = glCreateProgram();
+    glAttachShader(stream->program, vertex_shader);
+    glAttachShader(stream->program, fragment_shader);
+    glBindAttribLocation(stream->program, OpenGLVertexAttribute_P, "in_p");
+    glBindAttribLocation(stream->program, OpenGLVertexAttribute_UV, "in_uv");
+    glBindAttribLocation(stream->program, OpenGLVertexAttribute_Color, "in_color");
+    glLinkProgram(stream->program);
+
+    stream->particle_program = glCreateProgram();
+    glAttachShader(stream->particle_program, particle_vertex_shader);
+    glAttachShader(stream->particle_program, fragment_shader);
+    glBindAttribLocation(stream->particle_program, OpenGLParticleAttribute_X, "in_x");
+    glBindAttribLocation(stream->particle_program, OpenGLParticleAttribute_Y, "in_y");
+    glBindAttribLocation(stream->particle_program, OpenGLParticleAttribute_Alpha, "in_alpha");
+    glLinkProgram(stream->particle_program);
+
+    glDeleteShader(vertex_shader);
+    glDeleteShader(particle_vertex_shader);
+    glDeleteShader(fragment_shader);
+
+    GLint linked = false;
+    GLint particle_linked = false;
+    glGetProgramiv(stream->program, GL_LINK_STATUS, &linked);
+    glGetProgramiv(stream->particle_program, GL_LINK_STATUS, &particle_linked);
+    if (!linked || !particle_linked) {
+        glGetProgramInfoLog(linked ? stream->particle_program : stream->program, sizeof(info->shader_log), 0, info->shader_log);
+        glDeleteProgram(stream->program);
+        glDeleteProgram(stream->particle_program);
+        return false;
+    }
+
+    stream->screen_scale_location = glGetUniformLocation(stream->program, "screen_scale");
+    stream->texture_location = glGetUniformLocation(stream->program, "texture_sampler");
+
+    stream->particle_screen_scale_location = glGetUniformLocation(stream->particle_program, "screen_scale");
+    stream->particle_origin_location = glGetUniformLocation(stream->particle_program, "origin");
+    stream->particle_x_axis_location = glGetUniformLocation(stream->particle_program, "x_axis");
+    stream->particle_half_size_location = glGetUniformLocation(stream->particle_program, "half_size");
+
+    glGenVertexArrays(1, &stream->vertex_array);
+    glBindVertexArray(stream->vertex_array);
+
+    glGenBuffers(1, &stream->vertex_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, stream->vertex_buffer);
+
+    GLsizeiptr buffer_size = sizeof(OpenGLVertex)*OPENGL_STREAM_SEGMENT_COUNT*OPENGL_STREAM_SEGMENT_VERTEX_COUNT;
+    if (info->GL_ARB_buffer_storage && glBufferStorage) {
+        GLbitfield flags = GL_MAP_WRITE_BIT|GL_MAP_PERSISTENT_BIT|GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, buffer_size, 0, flags);
+        stream->mapped = cast(OpenGLVertex*) glMapBufferRange(GL_ARRAY_BUFFER, 0, buffer_size, flags);
+        stream->persistent = (stream->mapped != 0);
+    }
+
+    if (!stream->persistent) {
+        if (info->GL_ARB_buffer_storage && glBufferStorage) {
+            // @Note: Buffer storage is immutable, so if mapping it failed the buffer has to be made again
+            glDeleteBuffers(1, &stream->vertex_buffer);
+            glGenBuffers(1, &stream->vertex_buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, stream->vertex_buffer);
+        }
+        glBufferData(GL_ARRAY_BUFFER, buffer_size, 0, GL_STREAM_DRAW);
+        stream->mapped = 0;
+    }
+
+    glEnableVertexAttribArray(OpenGLVertexAttribute_P);
+    glEnableVertexAttribArray(OpenGLVertexAttribute_UV);
+    glEnableVertexAttribArray(OpenGLVertexAttribute_Color);
+    glVertexAttribPointer(OpenGLVertexAttribute_P, 2, GL_FLOAT, GL_FALSE, sizeof(OpenGLVertex), cast(void*) offsetof(OpenGLVertex, p));
+    glVertexAttribPointer(OpenGLVertexAttribute_UV, 2, GL_FLOAT, GL_FALSE, sizeof(OpenGLVertex), cast(void*) offsetof(OpenGLVertex, uv));
+    glVertexAttribPointer(OpenGLVertexAttribute_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(OpenGLVertex), cast(void*) offsetof(OpenGLVertex, color));
+
+    // @Note: The particle attributes point at wherever each chunk got streamed to, so they get set when it's drawn
+    glGenVertexArrays(1, &stream->particle_vertex_array);
+    glBindVertexArray(stream->particle_vertex_array);
+    glEnableVertexAttribArray(OpenGLParticleAttribute_X);
+    glEnableVertexAttribArray(OpenGLParticleAttribute_Y);
+    glEnableVertexAttribArray(OpenGLParticleAttribute_Alpha);
+    glVertexAttribDivisor(OpenGLParticleAttribute_X, 1);
+    glVertexAttribDivisor(OpenGLParticleAttribute_Y, 1);
+    glVertexAttribDivisor(OpenGLParticleAttribute_Alpha, 1);
+
+    glBindVertexArray(0);
+
+    u32 white = 0xFFFFFFFF;
+    stream->white_texture = opengl_load_texture(info, 1, 1, &white);
+
+    info->shader_path = true;
+    return true;
+}
+
+inline u32 opengl_pack_color(v4 color) {
+    u32 r = cast(u32) (255.0f*clamp01(color.r) + 0.5f);
+    u32 g = cast(u32) (255.0f*clamp01(color.g) + 0.5f);
+    u32 b = cast(u32) (255.0f*clamp01(color.b) + 0.5f);
+    u32 a = cast(u32) (255.0f*clamp01(color.a) + 0.5f);
+    u32 result = r | (g << 8) | (b << 16) | (a << 24);
+    return result;
+}
+
+inline void opengl_stream_flush(OpenGLStream* stream) {
+    if (stream->vertex_cursor > stream->batch_first_vertex) {
+        if (!stream->persistent && stream->mapped) {
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            stream->mapped = 0;
+        }
+
+        glDrawArrays(GL_TRIANGLES, stream->batch_first_vertex, stream->vertex_cursor - stream->batch_first_vertex);
+        stream->batch_first_vertex = stream->vertex_cursor;
+        stream->batch_count++;
+    }
+}
+
+internal void opengl_stream_next_segment(OpenGLStream* stream) {
+    opengl_stream_flush(stream);
+
+    if (!stream->persistent && stream->mapped) {
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        stream->mapped = 0;
+    }
+
+    GLsync* fence = stream->segment_fences + stream->segment_index;
+    if (*fence) {
+        glDeleteSync(*fence);
+    }
+    *fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    stream->segment_index = (stream->segment_index + 1) % OPENGL_STREAM_SEGMENT_COUNT;
+    stream->vertex_cursor = stream->segment_index*OPENGL_STREAM_SEGMENT_VERTEX_COUNT;
+    stream->batch_first_vertex = stream->vertex_cursor;
+
+    fence = stream->segment_fences + stream->segment_index;
+    if (*fence) {
+        GLenum wait_result;
+        do {
+            wait_result = glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        } while (wait_result == GL_TIMEOUT_EXPIRED);
+        assert(wait_result != GL_WAIT_FAILED);
+
+        glDeleteSync(*fence);
+        *fence = 0;
+    }
+}
+
+// @Note: Returns room for vertex_count vertices, which go into the current batch
+inline OpenGLVertex* opengl_stream_reserve(OpenGLStream* stream, u32 vertex_count) {
+    assert(vertex_count <= OPENGL_STREAM_SEGMENT_VERTEX_COUNT);
+
+    u32 segment_end = (stream->segment_index + 1)*OPENGL_STREAM_SEGMENT_VERTEX_COUNT;
+    if (stream->vertex_cursor + vertex_count > segment_end) {
+        opengl_stream_next_segment(stream);
+        segment_end = (stream->segment_index + 1)*OPENGL_STREAM_SEGMENT_VERTEX_COUNT;
+    }
+
+    if (!stream->mapped) {
+        // @Note: Nothing past the cursor in this segment is in use by the GPU, the fences made sure of that
+        GLbitfield access = GL_MAP_WRITE_BIT|GL_MAP_UNSYNCHRONIZED_BIT|GL_MAP_INVALIDATE_RANGE_BIT;
+        stream->mapped = cast(OpenGLVertex*) glMapBufferRange(GL_ARRAY_BUFFER,
+            sizeof(OpenGLVertex)*stream->vertex_cursor, sizeof(OpenGLVertex)*(segment_end - stream->vertex_cursor), access
+        );
+        stream->mapped_first_vertex = stream->vertex_cursor;
+    }
+
+    OpenGLVertex* result = stream->mapped + (stream->vertex_cursor - stream->mapped_first_vertex);
+    stream->vertex_cursor += vertex_count;
+    return result;
+}
+
+inline void opengl_stream_set_texture(OpenGLStream* stream, GLuint texture) {
+    if (!texture) {
+        texture = stream->white_texture;
+    }
+
+    if (stream->texture != texture) {
+        opengl_stream_flush(stream);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        stream->texture = texture;
+    }
+}
+
+inline void opengl_stream_triangle(OpenGLStream* stream, v2 a, v2 b, v2 c, u32 color) {
+    OpenGLVertex* v = opengl_stream_reserve(stream, 3);
+    v[0] = { a, vec2(0, 0), color };
+    v[1] = { b, vec2(0, 0), color };
+    v[2] = { c, vec2(0, 0), color };
+}
+
+inline void opengl_stream_quad(OpenGLStream* stream, v2 p00, v2 p10, v2 p11, v2 p01, u32 color, v2 min_uv = vec2(0, 0), v2 max_uv = vec2(0, 0)) {
+    OpenGLVertex* v = opengl_stream_reserve(stream, 6);
+    v[0] = { p00, vec2(min_uv.x, min_uv.y), color };
+    v[1] = { p10, vec2(max_uv.x, min_uv.y), color };
+    v[2] = { p11, vec2(max_uv.x, max_uv.y), color };
+    v[3] = { p00, vec2(min_uv.x, min_uv.y), color };
+    v[4] = { p11, vec2(max_uv.x, max_uv.y), color };
+    v[5] = { p01, vec2(min_uv.x, max_uv.y), color };
+}
+
+// @Note: Core profiles don't do wide lines, so lines are quads. Square caps close the corners of outlines.
+inline void opengl_stream_line(OpenGLStream* stream, v2 a, v2 b, f32 line_width, u32 color, b32 square_caps) {
+    v2 along = 0.5f*line_width*normalize_or_zero(b - a);
+    v2 across = perp(along);
+    if (square_caps) {
+        a -= along;
+        b += along;
+    }
+    opengl_stream_quad(stream, a - across, b - across, b + across, a + across, color);
+}
+
+inline void opengl_image(OpenGLBatch* batch, RenderCommandImage* command) {
+    Transform2D t = command->transform;
+    v2 x_axis = t.rotation_arm*t.scale;
+    v2 y_axis = perp(x_axis);
+    v2 align = command->align*command->dim;
+    v2 min_p = t.offset - x_axis*align.x - y_axis*align.y;
+
+    opengl_begin_triangles(batch, cast(GLuint) command->image->handle);
+    opengl_quad_vertices(min_p, x_axis*command->dim.x, y_axis*command->dim.y, command->color, command->min_uv, command->max_uv);
+}
+
+// @Note: Filled rectangles go into the open batch, outlines get a glBegin of their own
+inline void opengl_rectangle_shape(OpenGLBatch* batch, Transform2D* transform, AxisAlignedBox2 aab, ShapeRenderMode render_mode, f32 line_width, v4 color) {
+    v2 p00, p10, p11, p01;
+    get_rectangle_corners(transform, aab, render_mode, line_width, &p00, &p10, &p11, &p01);
+
+    if (render_mode == ShapeRenderMode_Outline) {
+        opengl_begin_unbatched(batch);
+
+        glBegin(GL_LINE_LOOP);
+        glColor4fv(color.e);
+
+        glVertex2fv(p00.e);
+        glVertex2fv(p10.e);
+        glVertex2fv(p11.e);
+        glVertex2fv(p01.e);
+
+        glEnd();
+    } else {
+        opengl_begin_triangles(batch, 0);
+
+        glColor4fv(color.e);
+
+        glVertex2fv(p00.e);
+        glVertex2fv(p10.e);
+        glVertex2fv(p11.e);
+
+        glVertex2fv(p00.e);
+        glVertex2fv(p11.e);
+        glVertex2fv(p01.e);
+    }
+}
+
+// @Note: Particles don't go through glBegin, seven calls each would be far too many. They get written out as quads a
+// chunk at a time and drawn from a client side vertex array, which is in GL 1.1 and counts as one batch per chunk.
+internal void opengl_particle_system_fixed_function(OpenGLBatch* batch, RenderCommandParticleSystem* command) {
+    opengl_end_batch(batch);
+    opengl_set_batch_texture(batch, 0);
+
+    Transform2D t = command->transform;
+    ParticleSystem* system = command->system;
+
+    v2 x_axis = t.rotation_arm*t.scale;
+    v2 y_axis = perp(x_axis);
+    v2 half_size = t.scale*system->half_size;
+
+    OpenGLVertex vertices[4*OPENGL_FIXED_FUNCTION_PARTICLE_CHUNK_SIZE];
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(OpenGLVertex), &vertices[0].p);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(OpenGLVertex), &vertices[0].color);
+
+    u32 vertex_count = 0;
+    for (u32 particle_index = 0; particle_index < system->count; particle_index++) {
+        f32 alpha = system->alpha[particle_index];
+        if (alpha <= 0.0f) {
+            continue;
+        }
+
+        v2 transformed = t.offset + x_axis*system->x[particle_index] + y_axis*system->y[particle_index];
+        v2 min_p = transformed - half_size;
+        v2 max_p = transformed + half_size;
+        u32 color = opengl_pack_color(vec4(alpha, alpha, alpha, alpha));
+
+        OpenGLVertex* quad = vertices + vertex_count;
+        quad[0].p = min_p;
+        quad[1].p = vec2(max_p.x, min_p.y);
+        quad[2].p = max_p;
+        quad[3].p = vec2(min_p.x, max_p.y);
+        quad[0].color = quad[1].color = quad[2].color = quad[3].color = color;
+        vertex_count += 4;
+
+        if (vertex_count == ARRAY_COUNT(vertices)) {
+            glDrawArrays(GL_QUADS, 0, vertex_count);
+            batch->batch_count++;
+            vertex_count = 0;
+        }
+    }
+
+    if (vertex_count) {
+        glDrawArrays(GL_QUADS, 0, vertex_count);
+        batch->batch_count++;
+    }
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+// @Note: Returns how many batches it took, where every glBegin outside of a batch counts as one too
+internal u32 opengl_render_commands_fixed_function(GameRenderCommands* commands) {
     u32 width = commands->width;
     u32 height = commands->height;
 
@@ -162,6 +626,12 @@ internal void opengl_render_commands(GameRenderCommands* commands) {
     glEnable(GL_BLEND);
     glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
+    // @Note: Line width can't change inside a glBegin/glEnd, and it never changes anyway
+    f32 line_width = 2.0f;
+    glLineWidth(line_width);
+
+    OpenGLBatch batch = {};
+
     for (u32 sort_entry_index = 0; sort_entry_index < commands->sort_entry_count; sort_entry_index++) {
         SortEntry* entry = cast(SortEntry*) commands->command_buffer + sort_entry_index;
         u8* at = commands->command_buffer + entry->index;
@@ -174,6 +644,7 @@ internal void opengl_render_commands(GameRenderCommands* commands) {
                 RenderCommandClear* command = cast(RenderCommandClear*) at;
                 at += sizeof(*command);
 
+                opengl_end_batch(&batch);
                 glClearColor(command->color.r, command->color.g, command->color.b, command->color.a);
                 glClear(GL_COLOR_BUFFER_BIT);
             } break;
@@ -182,26 +653,13 @@ internal void opengl_render_commands(GameRenderCommands* commands) {
                 RenderCommandShape* command = cast(RenderCommandShape*) at;
                 at += sizeof(*command);
 
-                f32 line_width = 2.0f;
-                glLineWidth(line_width);
-
                 Transform2D* transform = &command->transform;
                 Shape2D* shape = &command->shape;
+                b32 fill = (command->render_mode == ShapeRenderMode_Fill);
 
-                u32 circle_quality = 256;
-
-                GLuint render_mode = GL_POLYGON;
-                switch (command->render_mode) {
-                    case ShapeRenderMode_Fill: {
-                        if (shape->type == Shape_Rectangle) {
-                            render_mode = GL_TRIANGLES;
-                        } else {
-                            render_mode = GL_POLYGON;
-                        }
-                    } break;
-                    case ShapeRenderMode_Outline: {
-                        render_mode = GL_LINE_LOOP;
-                    } break;
+                // @Note: Fills go into the open batch as triangles, lines and outlines get a glBegin of their own
+                if (shape->type == Shape_Line || (!fill && shape->type != Shape_Rectangle)) {
+                    opengl_begin_unbatched(&batch);
                 }
 
                 switch (shape->type) {
@@ -216,136 +674,356 @@ internal void opengl_render_commands(GameRenderCommands* commands) {
                     } break;
 
                     case Shape_Polygon: {
-                        glBegin(render_mode);
-                        glColor4fv(command->color.e);
+                        if (fill) {
+                            opengl_begin_triangles(&batch, 0);
+                            glColor4fv(command->color.e);
+
+                            for (u32 corner_index = 0; corner_index < 3*command->triangle_count; corner_index++) {
+                                v2 v = rotate(transform->scale*shape->vertices[command->triangle_indices[corner_index]], transform->rotation_arm) + transform->offset;
+                                glVertex2fv(v.e);
+                            }
+                        } else {
+                            glBegin(GL_LINE_LOOP);
+                            glColor4fv(command->color.e);
 
-                        for (u32 vertex_index = 0; vertex_index < shape->vert_count; vertex_index++) {
-                            v2 v = rotate(transform->scale*shape->vertices[vertex_index], transform->rotation_arm) + transform->offset;
-                            glVertex2fv(v.e);
-                        }
+                            for (u32 vertex_index = 0; vertex_index < shape->vert_count; vertex_index++) {
+                                v2 v = rotate(transform->scale*shape->vertices[vertex_index], transform->rotation_arm) + transform->offset;
+                                glVertex2fv(v.e);
+                            }
 
-                        glEnd();
+                            glEnd();
+                        }
                     } break;
 
                     case Shape_Circle: {
-                        glBegin(render_mode);
-                        glColor4fv(command->color.e);
+                        u32 segment_count = get_circle_segment_count(transform, shape->radius);
+
+                        if (fill) {
+                            opengl_begin_triangles(&batch, 0);
+                            glColor4fv(command->color.e);
+
+                            v2 prev_v = get_circle_shape_point(transform, shape->radius, 0, segment_count);
+                            for (u32 segment_index = 1; segment_index <= segment_count; segment_index++) {
+                                v2 v = get_circle_shape_point(transform, shape->radius, segment_index, segment_count);
+                                glVertex2fv(transform->offset.e);
+                                glVertex2fv(prev_v.e);
+                                glVertex2fv(v.e);
+                                prev_v = v;
+                            }
+                        } else {
+                            glBegin(GL_LINE_LOOP);
+                            glColor4fv(command->color.e);
 
-                        for (f32 segment_angle = 0; segment_angle < TAU_32; segment_angle += (TAU_32 / cast(f32) circle_quality)) {
-                            v2 v = rotate(transform->scale*vec2(sin(segment_angle), cos(segment_angle))*shape->radius, transform->rotation_arm) + transform->offset;
-                            glVertex2fv(v.e);
-                        }
+                            for (u32 segment_index = 0; segment_index < segment_count; segment_index++) {
+                                v2 v = get_circle_shape_point(transform, shape->radius, segment_index, segment_count);
+                                glVertex2fv(v.e);
+                            }
 
-                        glEnd();
+                            glEnd();
+                        }
                     } break;
 
                     case Shape_Rectangle: {
-                        v2 x_axis = transform->rotation_arm*transform->scale;
-                        v2 y_axis = perp(x_axis);
+                        opengl_rectangle_shape(&batch, transform, shape->bounding_box, command->render_mode, line_width, command->color);
+                    } break;
+                }
+            } break;
+
+            case RenderCommand_RectBatch: {
+                RenderCommandRectBatch* command = cast(RenderCommandRectBatch*) at;
+                at += sizeof(*command);
+
+                for (u32 rect_index = 0; rect_index < command->rect_count; rect_index++) {
+                    RenderRect* rect = command->rects + rect_index;
+                    opengl_rectangle_shape(&batch, &command->transform, rect->aab, rect->render_mode, line_width, rect->color);
+                }
+            } break;
+
+            case RenderCommand_Image: {
+                RenderCommandImage* command = cast(RenderCommandImage*) at;
+                at += sizeof(*command);
+
+                opengl_image(&batch, command);
+            } break;
+
+            case RenderCommand_GlyphRun: {
+                RenderCommandGlyphRun* command = cast(RenderCommandGlyphRun*) at;
+                at += sizeof(*command);
+
+                if (command->shadow_color.a > 0.0f) {
+                    for (u32 glyph_index = 0; glyph_index < command->glyph_count; glyph_index++) {
+                        RenderCommandImage glyph_image = get_glyph_run_image(command, command->glyphs[glyph_index], true);
+                        opengl_image(&batch, &glyph_image);
+                    }
+                }
 
-                        AxisAlignedBox2 aab = shape->bounding_box;
+                for (u32 glyph_index = 0; glyph_index < command->glyph_count; glyph_index++) {
+                    RenderCommandImage glyph_image = get_glyph_run_image(command, command->glyphs[glyph_index], false);
+                    opengl_image(&batch, &glyph_image);
+                }
+            } break;
+
+            case RenderCommand_ParticleSystem: {
+                RenderCommandParticleSystem* command = cast(RenderCommandParticleSystem*) at;
+                at += sizeof(*command);
+
+                opengl_particle_system_fixed_function(&batch, command);
+            } break;
 
-                        v2 a, b, c, d;
-                        if (command->render_mode == ShapeRenderMode_Outline && line_width > 1.0f) {
-                            v2 x_adjust = -0.5f*normalize_or_zero(x_axis)*line_width;
-                            v2 y_adjust = -0.5f*normalize_or_zero(y_axis)*line_width;
+            INVALID_DEFAULT_CASE;
+        }
+    }
+
+    opengl_end_batch(&batch);
+    opengl_set_batch_texture(&batch, 0);
+
+    glDisable(GL_BLEND);
+
+    return batch.batch_count;
+}
+
+inline void opengl_stream_image(OpenGLStream* stream, RenderCommandImage* command) {
+    Transform2D t = command->transform;
+    v2 x_axis = t.rotation_arm*t.scale*command->dim.x;
+    v2 y_axis = perp(t.rotation_arm*t.scale)*command->dim.y;
+    v2 min_p = t.offset - x_axis*command->align.x - y_axis*command->align.y;
+
+    opengl_stream_set_texture(stream, cast(GLuint) command->image->handle);
+    opengl_stream_quad(stream, min_p, min_p + x_axis, min_p + x_axis + y_axis, min_p + y_axis, opengl_pack_color(command->color), command->min_uv, command->max_uv);
+}
+
+inline void opengl_stream_rectangle_shape(OpenGLStream* stream, Transform2D* transform, AxisAlignedBox2 aab, ShapeRenderMode render_mode, f32 line_width, u32 color) {
+    v2 p00, p10, p11, p01;
+    get_rectangle_corners(transform, aab, render_mode, line_width, &p00, &p10, &p11, &p01);
+
+    if (render_mode == ShapeRenderMode_Fill) {
+        opengl_stream_quad(stream, p00, p10, p11, p01, color);
+    } else {
+        opengl_stream_line(stream, p00, p10, line_width, color, true);
+        opengl_stream_line(stream, p10, p11, line_width, color, true);
+        opengl_stream_line(stream, p11, p01, line_width, color, true);
+        opengl_stream_line(stream, p01, p00, line_width, color, true);
+    }
+}
+
+internal void opengl_stream_particle_system(OpenGLStream* stream, RenderCommandParticleSystem* command) {
+    opengl_stream_set_texture(stream, 0);
+    opengl_stream_flush(stream);
+
+    Transform2D t = command->transform;
+    ParticleSystem* system = command->system;
+
+    v2 x_axis = t.rotation_arm*t.scale;
+    v2 half_size = t.scale*system->half_size;
+
+    glUseProgram(stream->particle_program);
+    glUniform2f(stream->particle_origin_location, t.offset.x, t.offset.y);
+    glUniform2f(stream->particle_x_axis_location, x_axis.x, x_axis.y);
+    glUniform2f(stream->particle_half_size_location, half_size.x, half_size.y);
+    glBindVertexArray(stream->particle_vertex_array);
+
+    for (u32 first_particle = 0; first_particle < system->count; first_particle += OPENGL_PARTICLE_CHUNK_SIZE) {
+        u32 particle_count = MIN(system->count - first_particle, OPENGL_PARTICLE_CHUNK_SIZE);
+        u32 vertex_count = cast(u32) ((3*sizeof(f32)*particle_count + sizeof(OpenGLVertex) - 1) / sizeof(OpenGLVertex));
+
+        f32* data = cast(f32*) opengl_stream_reserve(stream, vertex_count);
+        u32 first_vertex = stream->vertex_cursor - vertex_count;
+
+        // @Note: These aren't vertices, so they stay out of the next batch
+        stream->batch_first_vertex = stream->vertex_cursor;
+
+        copy(sizeof(f32)*particle_count, system->x + first_particle, data);
+        copy(sizeof(f32)*particle_count, system->y + first_particle, data + particle_count);
+        copy(sizeof(f32)*particle_count, system->alpha + first_particle, data + 2*particle_count);
+
+        if (!stream->persistent && stream->mapped) {
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            stream->mapped = 0;
+        }
+
+        size_t offset = sizeof(OpenGLVertex)*first_vertex;
+        glVertexAttribPointer(OpenGLParticleAttribute_X, 1, GL_FLOAT, GL_FALSE, sizeof(f32), cast(void*) offset);
+        glVertexAttribPointer(OpenGLParticleAttribute_Y, 1, GL_FLOAT, GL_FALSE, sizeof(f32), cast(void*) (offset + sizeof(f32)*particle_count));
+        glVertexAttribPointer(OpenGLParticleAttribute_Alpha, 1, GL_FLOAT, GL_FALSE, sizeof(f32), cast(void*) (offset + 2*sizeof(f32)*particle_count));
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, particle_count);
+        stream->batch_count++;
+    }
+
+    glBindVertexArray(stream->vertex_array);
+    glUseProgram(stream->program);
+}
+
+// @Note: Returns how many draw calls it took
+internal u32 opengl_render_commands_shader(OpenGLStream* stream, GameRenderCommands* commands) {
+    u32 width = commands->width;
+    u32 height = commands->height;
+
+    glViewport(0, 0, width, height);
+
+    glUseProgram(stream->particle_program);
+    glUniform2f(stream->particle_screen_scale_location, safe_ratio_1(2.0f, cast(f32) width), safe_ratio_1(2.0f, cast(f32) height));
+
+    glUseProgram(stream->program);
+    glUniform2f(stream->screen_scale_location, safe_ratio_1(2.0f, cast(f32) width), safe_ratio_1(2.0f, cast(f32) height));
+    glUniform1i(stream->texture_location, 0);
+
+    glBindVertexArray(stream->vertex_array);
+    glBindBuffer(GL_ARRAY_BUFFER, stream->vertex_buffer);
+    glActiveTexture(GL_TEXTURE0);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
-                            // @Robustness: x_adjust and y_adjust here boldly assume the aab contains its origin!!
-                            a = x_axis*corner_a(aab).x - x_adjust + y_axis*corner_a(aab).y - y_adjust;
-                            b = x_axis*corner_b(aab).x + x_adjust + y_axis*corner_b(aab).y - y_adjust;
-                            c = x_axis*corner_c(aab).x + x_adjust + y_axis*corner_c(aab).y + y_adjust;
-                            d = x_axis*corner_d(aab).x - x_adjust + y_axis*corner_d(aab).y + y_adjust;
+    f32 line_width = 2.0f;
+
+    stream->batch_count = 0;
+    stream->texture = 0;
+    opengl_stream_set_texture(stream, 0);
+
+    for (u32 sort_entry_index = 0; sort_entry_index < commands->sort_entry_count; sort_entry_index++) {
+        SortEntry* entry = cast(SortEntry*) commands->command_buffer + sort_entry_index;
+        u8* at = commands->command_buffer + entry->index;
+
+        RenderCommandHeader* header = cast(RenderCommandHeader*) at;
+        at += sizeof(*header);
+
+        switch (header->type) {
+            case RenderCommand_Clear: {
+                RenderCommandClear* command = cast(RenderCommandClear*) at;
+                at += sizeof(*command);
+
+                opengl_stream_flush(stream);
+                glClearColor(command->color.r, command->color.g, command->color.b, command->color.a);
+                glClear(GL_COLOR_BUFFER_BIT);
+            } break;
+
+            case RenderCommand_Shape: {
+                RenderCommandShape* command = cast(RenderCommandShape*) at;
+                at += sizeof(*command);
+
+                Transform2D* transform = &command->transform;
+                Shape2D* shape = &command->shape;
+                u32 color = opengl_pack_color(command->color);
+                b32 fill = (command->render_mode == ShapeRenderMode_Fill);
+
+                opengl_stream_set_texture(stream, 0);
+
+                switch (shape->type) {
+                    case Shape_Line: {
+                        v2 start_p = transform->offset;
+                        v2 end_p   = transform->offset + transform->scale*rotate(shape->arm, transform->rotation_arm);
+                        opengl_stream_line(stream, start_p, end_p, line_width, color, false);
+                    } break;
+
+                    case Shape_Polygon: {
+                        if (fill) {
+                            for (u32 triangle_index = 0; triangle_index < command->triangle_count; triangle_index++) {
+                                u16* indices = command->triangle_indices + 3*triangle_index;
+                                v2 a = rotate(transform->scale*shape->vertices[indices[0]], transform->rotation_arm) + transform->offset;
+                                v2 b = rotate(transform->scale*shape->vertices[indices[1]], transform->rotation_arm) + transform->offset;
+                                v2 c = rotate(transform->scale*shape->vertices[indices[2]], transform->rotation_arm) + transform->offset;
+                                opengl_stream_triangle(stream, a, b, c, color);
+                            }
                         } else {
-                            a = x_axis*corner_a(aab).x + y_axis*corner_a(aab).y;
-                            b = x_axis*corner_b(aab).x + y_axis*corner_b(aab).y;
-                            c = x_axis*corner_c(aab).x + y_axis*corner_c(aab).y;
-                            d = x_axis*corner_d(aab).x + y_axis*corner_d(aab).y;
+                            v2 first_v = rotate(transform->scale*shape->vertices[0], transform->rotation_arm) + transform->offset;
+                            v2 prev_v = first_v;
+                            for (u32 vertex_index = 1; vertex_index <= shape->vert_count; vertex_index++) {
+                                v2 v = first_v;
+                                if (vertex_index < shape->vert_count) {
+                                    v = rotate(transform->scale*shape->vertices[vertex_index], transform->rotation_arm) + transform->offset;
+                                }
+                                opengl_stream_line(stream, prev_v, v, line_width, color, true);
+                                prev_v = v;
+                            }
                         }
+                    } break;
 
-                        v2 p00 = transform->offset + a;
-                        v2 p10 = transform->offset + b;
-                        v2 p11 = transform->offset + c;
-                        v2 p01 = transform->offset + d;
+                    case Shape_Circle: {
+                        u32 segment_count = get_circle_segment_count(transform, shape->radius);
 
-                        glBegin(render_mode);
-                        glColor4fv(command->color.e);
+                        v2 prev_v = get_circle_shape_point(transform, shape->radius, 0, segment_count);
+                        for (u32 segment_index = 1; segment_index <= segment_count; segment_index++) {
+                            v2 v = get_circle_shape_point(transform, shape->radius, segment_index, segment_count);
 
-                        if (command->render_mode == ShapeRenderMode_Outline) {
-                            glVertex2fv(p00.e);
-                            glVertex2fv(p10.e);
-                            glVertex2fv(p11.e);
-                            glVertex2fv(p01.e);
-                        } else {
-                            glVertex2fv(p00.e);
-                            glVertex2fv(p10.e);
-                            glVertex2fv(p11.e);
+                            if (fill) {
+                                opengl_stream_triangle(stream, transform->offset, prev_v, v, color);
+                            } else {
+                                opengl_stream_line(stream, prev_v, v, line_width, color, true);
+                            }
 
-                            glVertex2fv(p00.e);
-                            glVertex2fv(p11.e);
-                            glVertex2fv(p01.e);
+                            prev_v = v;
                         }
+                    } break;
 
-                        glEnd();
+                    case Shape_Rectangle: {
+                        opengl_stream_rectangle_shape(stream, transform, shape->bounding_box, command->render_mode, line_width, color);
                     } break;
                 }
             } break;
 
-            case RenderCommand_Image: {
-                RenderCommandImage* command = cast(RenderCommandImage*) at;
+            case RenderCommand_RectBatch: {
+                RenderCommandRectBatch* command = cast(RenderCommandRectBatch*) at;
                 at += sizeof(*command);
 
-                Image* image = command->image;
-                Transform2D t = command->transform;
-                v2 x_axis = t.rotation_arm*t.scale;
-                v2 y_axis = perp(x_axis);
-                v2 align = image->align*vec2(image->w, image->h);
-                v2 min_p = t.offset - x_axis*align.x - y_axis*align.y;
-                opengl_texture(cast(GLuint) image->handle, min_p, x_axis*cast(f32) image->w, y_axis*cast(f32) image->h, command->color);
+                opengl_stream_set_texture(stream, 0);
+
+                for (u32 rect_index = 0; rect_index < command->rect_count; rect_index++) {
+                    RenderRect* rect = command->rects + rect_index;
+                    opengl_stream_rectangle_shape(stream, &command->transform, rect->aab, rect->render_mode, line_width, opengl_pack_color(rect->color));
+                }
             } break;
 
-            case RenderCommand_ParticleSystem: {
-                RenderCommandParticleSystem* command = cast(RenderCommandParticleSystem*) at;
+            case RenderCommand_Image: {
+                RenderCommandImage* command = cast(RenderCommandImage*) at;
                 at += sizeof(*command);
 
-                Transform2D t = command->transform;
-                ParticleSystem* system = command->system;
-
-                v2 x_axis = t.rotation_arm*t.scale;
-                v2 y_axis = perp(x_axis);
-
-                for (u32 particle_index = 0; particle_index < system->count; particle_index++) {
-                    Particle particle = system->particles[particle_index];
-                    v2 transformed = t.offset + x_axis*particle.p.x + y_axis*particle.p.y;
-
-                    v2 min_p = transformed + t.scale*vec2(-0.1f, -0.1f);
-                    v2 max_p = transformed + t.scale*vec2( 0.1f,  0.1f);
+                opengl_stream_image(stream, command);
+            } break;
 
-                    v4 color = vec4(1, 1, 1, 1)*particle.alpha;
+            case RenderCommand_GlyphRun: {
+                RenderCommandGlyphRun* command = cast(RenderCommandGlyphRun*) at;
+                at += sizeof(*command);
 
-                    glBegin(GL_TRIANGLES);
-                    glColor4fv(color.e);
+                if (command->shadow_color.a > 0.0f) {
+                    for (u32 glyph_index = 0; glyph_index < command->glyph_count; glyph_index++) {
+                        RenderCommandImage glyph_image = get_glyph_run_image(command, command->glyphs[glyph_index], true);
+                        opengl_stream_image(stream, &glyph_image);
+                    }
+                }
 
-                    // glTexCoord2f(min_uv.x, min_uv.y);
-                    glVertex2f(min_p.x, min_p.y);
-                    // glTexCoord2f(max_uv.x, min_uv.y);
-                    glVertex2f(max_p.x, min_p.y);
-                    // glTexCoord2f(max_uv.x, max_uv.y);
-                    glVertex2f(max_p.x, max_p.y);
+                for (u32 glyph_index = 0; glyph_index < command->glyph_count; glyph_index++) {
+                    RenderCommandImage glyph_image = get_glyph_run_image(command, command->glyphs[glyph_index], false);
+                    opengl_stream_image(stream, &glyph_image);
+                }
+            } break;
 
-                    // glTexCoord2f(min_uv.x, min_uv.y);
-                    glVertex2f(min_p.x, min_p.y);
-                    // glTexCoord2f(max_uv.x, max_uv.y);
-                    glVertex2f(max_p.x, max_p.y);
-                    // glTexCoord2f(min_uv.x, max_uv.y);
-                    glVertex2f(min_p.x, max_p.y);
+            case RenderCommand_ParticleSystem: {
+                RenderCommandParticleSystem* command = cast(RenderCommandParticleSystem*) at;
+                at += sizeof(*command);
 
-                    glEnd();
-                }
+                opengl_stream_particle_system(stream, command);
             } break;
 
             INVALID_DEFAULT_CASE;
         }
     }
 
+    opengl_stream_flush(stream);
+
     glDisable(GL_BLEND);
+    glBindVertexArray(0);
+    glUseProgram(0);
+
+    return stream->batch_count;
+}
+
+// @Note: Returns how many batches or draw calls it took
+internal u32 opengl_render_commands(OpenGLInfo* info, GameRenderCommands* commands) {
+    u32 result;
+    if (info->shader_path) {
+        result = opengl_render_commands_shader(&info->stream, commands);
+    } else {
+        result = opengl_render_commands_fixed_function(commands);
+    }
+    return result;
 }
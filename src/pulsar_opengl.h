@@ -11,14 +11,178 @@ static const GLuint GL_SAMPLE_ALPHA_TO_COVERAGE_ARB = 0x809E;
 static const GLuint GL_SAMPLE_ALPHA_TO_ONE_ARB      = 0x809F;
 static const GLuint GL_SAMPLE_COVERAGE_ARB          = 0x80A0;
 
+static const GLuint GL_CLAMP_TO_EDGE                = 0x812F;
+static const GLuint GL_TEXTURE0                     = 0x84C0;
+
+static const GLuint GL_ARRAY_BUFFER                 = 0x8892;
+static const GLuint GL_STREAM_DRAW                  = 0x88E0;
+static const GLuint GL_VERTEX_SHADER                = 0x8B31;
+static const GLuint GL_FRAGMENT_SHADER              = 0x8B30;
+static const GLuint GL_COMPILE_STATUS               = 0x8B81;
+static const GLuint GL_LINK_STATUS                  = 0x8B82;
+static const GLuint GL_INFO_LOG_LENGTH              = 0x8B84;
+
+static const GLuint GL_MAP_WRITE_BIT                = 0x0002;
+static const GLuint GL_MAP_INVALIDATE_RANGE_BIT     = 0x0004;
+static const GLuint GL_MAP_UNSYNCHRONIZED_BIT       = 0x0020;
+static const GLuint GL_MAP_PERSISTENT_BIT           = 0x0040;
+static const GLuint GL_MAP_COHERENT_BIT             = 0x0080;
+
+static const GLuint GL_SYNC_GPU_COMMANDS_COMPLETE   = 0x9117;
+static const GLuint GL_SYNC_FLUSH_COMMANDS_BIT      = 0x0001;
+static const GLuint GL_TIMEOUT_EXPIRED              = 0x911B;
+static const GLuint GL_WAIT_FAILED                  = 0x911D;
+
+typedef char GLchar;
+typedef ptrdiff_t GLsizeiptr;
+typedef ptrdiff_t GLintptr;
+typedef u64 GLuint64;
+typedef struct __GLsync* GLsync;
+
 #define GL_FUNCTION(return_type, name, ...) \
     typedef return_type WINAPI GL_FUNCTION_##name(__VA_ARGS__); \
     global GL_FUNCTION_##name* name;
 
 GL_FUNCTION(GLubyte*, glGetStringi, GLenum name, GLuint index);
 
+// @Note: Everything the shader path needs past GL 1.1, loaded by the platform once it has a context
+GL_FUNCTION(void, glActiveTexture, GLenum texture);
+GL_FUNCTION(void, glGenBuffers, GLsizei n, GLuint* buffers);
+GL_FUNCTION(void, glDeleteBuffers, GLsizei n, const GLuint* buffers);
+GL_FUNCTION(void, glBindBuffer, GLenum target, GLuint buffer);
+GL_FUNCTION(void, glBufferData, GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+GL_FUNCTION(void, glBufferStorage, GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+GL_FUNCTION(void*, glMapBufferRange, GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+GL_FUNCTION(GLboolean, glUnmapBuffer, GLenum target);
+GL_FUNCTION(void, glGenVertexArrays, GLsizei n, GLuint* arrays);
+GL_FUNCTION(void, glDeleteVertexArrays, GLsizei n, const GLuint* arrays);
+GL_FUNCTION(void, glBindVertexArray, GLuint array);
+GL_FUNCTION(void, glEnableVertexAttribArray, GLuint index);
+GL_FUNCTION(void, glVertexAttribPointer, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+GL_FUNCTION(GLuint, glCreateShader, GLenum type);
+GL_FUNCTION(void, glDeleteShader, GLuint shader);
+GL_FUNCTION(void, glShaderSource, GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+GL_FUNCTION(void, glCompileShader, GLuint shader);
+GL_FUNCTION(void, glGetShaderiv, GLuint shader, GLenum pname, GLint* params);
+GL_FUNCTION(void, glGetShaderInfoLog, GLuint shader, GLsizei buffer_size, GLsizei* length, GLchar* info_log);
+GL_FUNCTION(GLuint, glCreateProgram, void);
+GL_FUNCTION(void, glDeleteProgram, GLuint program);
+GL_FUNCTION(void, glAttachShader, GLuint program, GLuint shader);
+GL_FUNCTION(void, glBindAttribLocation, GLuint program, GLuint index, const GLchar* name);
+GL_FUNCTION(void, glLinkProgram, GLuint program);
+GL_FUNCTION(void, glGetProgramiv, GLuint program, GLenum pname, GLint* params);
+GL_FUNCTION(void, glGetProgramInfoLog, GLuint program, GLsizei buffer_size, GLsizei* length, GLchar* info_log);
+GL_FUNCTION(void, glUseProgram, GLuint program);
+GL_FUNCTION(GLint, glGetUniformLocation, GLuint program, const GLchar* name);
+GL_FUNCTION(void, glUniform1i, GLint location, GLint v0);
+GL_FUNCTION(void, glUniform2f, GLint location, GLfloat v0, GLfloat v1);
+GL_FUNCTION(void, glVertexAttribDivisor, GLuint index, GLuint divisor);
+GL_FUNCTION(void, glDrawArraysInstanced, GLenum mode, GLint first, GLsizei count, GLsizei instance_count);
+GL_FUNCTION(GLsync, glFenceSync, GLenum condition, GLbitfield flags);
+GL_FUNCTION(GLenum, glClientWaitSync, GLsync sync, GLbitfield flags, GLuint64 timeout);
+GL_FUNCTION(void, glDeleteSync, GLsync sync);
+
+// @Note: Lists the shader path's functions for the platform to load, and to check that they all loaded
+#define OPENGL_SHADER_PATH_FUNCTIONS(X) \
+    X(glActiveTexture)                  \
+    X(glGenBuffers)                     \
+    X(glDeleteBuffers)                  \
+    X(glBindBuffer)                     \
+    X(glBufferData)                     \
+    X(glMapBufferRange)                 \
+    X(glUnmapBuffer)                    \
+    X(glGenVertexArrays)                \
+    X(glDeleteVertexArrays)             \
+    X(glBindVertexArray)                \
+    X(glEnableVertexAttribArray)        \
+    X(glVertexAttribPointer)            \
+    X(glCreateShader)                   \
+    X(glDeleteShader)                   \
+    X(glShaderSource)                   \
+    X(glCompileShader)                  \
+    X(glGetShaderiv)                    \
+    X(glGetShaderInfoLog)               \
+    X(glCreateProgram)                  \
+    X(glDeleteProgram)                  \
+    X(glAttachShader)                   \
+    X(glBindAttribLocation)             \
+    X(glLinkProgram)                    \
+    X(glGetProgramiv)                   \
+    X(glGetProgramInfoLog)              \
+    X(glUseProgram)                     \
+    X(glGetUniformLocation)             \
+    X(glUniform1i)                      \
+    X(glUniform2f)                      \
+    X(glVertexAttribDivisor)            \
+    X(glDrawArraysInstanced)            \
+    X(glFenceSync)                      \
+    X(glClientWaitSync)                 \
+    X(glDeleteSync)
+
+// @Note: What the shader path streams to the GPU. Positions are in pixels, like the fixed function path's.
+struct OpenGLVertex {
+    v2 p;
+    v2 uv;
+    u32 color; // @Note: RGBA8, premultiplied like every other color in the renderer
+};
+
+// @Note: The vertex buffer is a ring of segments. Leaving a segment puts a fence behind the draws that read from it, and
+// coming back around to it waits on that fence, so the CPU never writes over vertices the GPU hasn't drawn yet. With
+// GL_ARB_buffer_storage the whole buffer stays mapped for good, otherwise the free part of the current segment gets
+// mapped unsynchronized and unmapped again before every draw.
+#define OPENGL_STREAM_SEGMENT_COUNT 3
+#define OPENGL_STREAM_SEGMENT_VERTEX_COUNT (1 << 18)
+
+struct OpenGLStream {
+    GLuint program;
+    GLint screen_scale_location;
+    GLint texture_location;
+
+    GLuint vertex_array;
+    GLuint vertex_buffer;
+    GLuint white_texture; // @Note: Bound for untextured geometry, so texture changes are the only reason to flush
+
+    b32 persistent;
+    OpenGLVertex* mapped;      // @Note: The whole buffer if persistent, otherwise the mapped part of the segment
+    u32 mapped_first_vertex;   // @Note: Which vertex mapped points at
+
+    u32 segment_index;
+    u32 vertex_cursor;         // @Note: In vertices from the start of the buffer
+    u32 batch_first_vertex;
+    GLsync segment_fences[OPENGL_STREAM_SEGMENT_COUNT];
+
+    GLuint texture;
+    u32 batch_count;
+
+    // @Note: Particles get their x, y and alpha streamed through the same ring, and are drawn as one instanced quad each
+    GLuint particle_program;
+    GLint particle_screen_scale_location;
+    GLint particle_origin_location;
+    GLint particle_x_axis_location;
+    GLint particle_half_size_location;
+    GLuint particle_vertex_array;
+};
+
+// @Note: How many particles go in one instanced draw, their arrays have to fit in a segment
+#define OPENGL_PARTICLE_CHUNK_SIZE (1 << 16)
+
+// @Note: How many particles the fixed function path draws at once, their quads live on the stack
+#define OPENGL_FIXED_FUNCTION_PARTICLE_CHUNK_SIZE 1024
+
+// @Note: How many particles each path is expected to hold 60Hz with. The shader path draws them instanced straight out
+// of their arrays, the fixed function path has to write out four vertices for each of them on the CPU. Neither has
+// been measured yet, so the fixed function path gets the same budget as the software renderer, which was.
+#define OPENGL_MAX_PARTICLE_COUNT (1 << 20)
+#define OPENGL_FIXED_FUNCTION_MAX_PARTICLE_COUNT (1 << 17)
+
 struct OpenGLInfo {
     b32 modern_context;
+    b32 core_profile;
+
+    // @Note: Set once the GL 3.3 shader path is up and running, otherwise everything goes through fixed function
+    b32 shader_path;
+    OpenGLStream stream;
+    char shader_log[1024]; // @Note: Why the shader path didn't come up, if it didn't
 
     char* vendor;
     char* renderer;
@@ -33,6 +197,16 @@ struct OpenGLInfo {
     b32 GL_EXT_framebuffer_sRGB;
     b32 GL_ARB_framebuffer_sRGB;
     b32 GL_ARB_multisample;
+    b32 GL_ARB_buffer_storage;
+};
+
+// @Note: Consecutive triangles with the same texture go into one glBegin/glEnd. The render sort key puts commands with
+// the same type and texture next to each other, so text and particles end up as a handful of batches.
+struct OpenGLBatch {
+    b32 open;
+    GLuint texture; // @Note: 0 means texturing is disabled
+
+    u32 batch_count;
 };
 
 #endif /* OPENGL_H */
@@ -0,0 +1,184 @@
+internal void initialize_particle_simulation(ParticleSimulation* sim, MemoryArena* arena, u32 capacity, f32 half_size) {
+    zero_struct(*sim);
+    sim->capacity = get_padded_particle_count(capacity);
+    sim->max_count = sim->capacity;
+    sim->half_size = half_size;
+    sim->x         = push_array(arena, sim->capacity, f32, align(16, true));
+    sim->y         = push_array(arena, sim->capacity, f32, align(16, true));
+    sim->dx        = push_array(arena, sim->capacity, f32, align(16, true));
+    sim->dy        = push_array(arena, sim->capacity, f32, align(16, true));
+    sim->life      = push_array(arena, sim->capacity, f32, align(16, true));
+    sim->life_rate = push_array(arena, sim->capacity, f32, align(16, true));
+    sim->alpha     = push_array(arena, sim->capacity, f32, align(16, true));
+    sim->inv_depth = push_array(arena, sim->capacity, f32, align(16, true));
+    sim->random_series = random_seed(0x12345678);
+}
+
+// @Note: Spawns count particles in the box around center, as seen from camera_p, moving away from the center at
+// outward_speed on top of the emitter's velocity. Particles past capacity or max_count are dropped.
+internal void emit_particles(ParticleSimulation* sim, ParticleEmitter* emitter, u32 count, v2 center, v2 half_dim, f32 outward_speed, v2 camera_p) {
+    u32 max_count = MIN(sim->capacity, sim->max_count);
+    count = (sim->count < max_count) ? MIN(count, max_count - sim->count) : 0;
+
+    u32 first_particle = sim->count;
+    sim->count += count;
+
+    for (u32 particle_index = first_particle; particle_index < sim->count; particle_index++) {
+        v2 offset = half_dim*vec2(random_range(&sim->random_series, -1.0f, 1.0f), random_range(&sim->random_series, -1.0f, 1.0f));
+        v2 spread = emitter->velocity_spread*vec2(random_range(&sim->random_series, -1.0f, 1.0f), random_range(&sim->random_series, -1.0f, 1.0f));
+        v2 velocity = emitter->velocity + spread + outward_speed*normalize_or_zero(offset);
+
+        f32 inv_depth = 1.0f / random_range(&sim->random_series, emitter->min_depth, emitter->max_depth);
+        v2 p = center + offset - (1.0f - inv_depth)*camera_p;
+
+        sim->x[particle_index]         = p.x;
+        sim->y[particle_index]         = p.y;
+        sim->dx[particle_index]        = velocity.x;
+        sim->dy[particle_index]        = velocity.y;
+        sim->life[particle_index]      = 1.0f;
+        sim->life_rate[particle_index] = 1.0f / random_range(&sim->random_series, emitter->min_lifetime, emitter->max_lifetime);
+        sim->alpha[particle_index]     = random_range(&sim->random_series, emitter->min_alpha, emitter->max_alpha);
+        sim->inv_depth[particle_index] = inv_depth;
+    }
+}
+
+// @Note: Queues a burst for the next update_particle_emitter. Higher notes burst further to the right.
+inline void trigger_particle_emitter(ParticleEmitter* emitter, u32 note_value, f32 strength) {
+    if (strength > 0.0f && emitter->burst_count < ARRAY_COUNT(emitter->bursts)) {
+        ParticleBurst* burst = emitter->bursts + emitter->burst_count++;
+        burst->x = clamp01(cast(f32) note_value / 127.0f);
+        burst->strength = strength;
+    }
+}
+
+internal void update_particle_emitter(ParticleSimulation* sim, ParticleEmitter* emitter, AxisAlignedBox2 view, v2 camera_p, f32 dt) {
+    emitter->emit_remainder += dt*emitter->particles_per_second;
+    u32 emit_count = cast(u32) emitter->emit_remainder;
+    emitter->emit_remainder -= cast(f32) emit_count;
+
+    emit_particles(sim, emitter, emit_count, get_center(view), 0.5f*get_dim(view), 0.0f, camera_p);
+
+    for (u32 burst_index = 0; burst_index < emitter->burst_count; burst_index++) {
+        ParticleBurst* burst = emitter->bursts + burst_index;
+        v2 center = vec2(lerp(view.min.x, view.max.x, burst->x), random_range(&sim->random_series, view.min.y, view.max.y));
+        u32 burst_count = cast(u32) (burst->strength*emitter->particles_per_note);
+        emit_particles(sim, emitter, burst_count, center, vec2(emitter->burst_radius, emitter->burst_radius), emitter->burst_speed, camera_p);
+    }
+    emitter->burst_count = 0;
+}
+
+internal void simulate_particles(ParticleSimulation* sim, f32 dt) {
+    __m128 dt_4 = _mm_set1_ps(dt);
+    __m128 zero = _mm_setzero_ps();
+
+    // @Note: Lanes past the count hold whatever died there last, so they don't count
+    b32 any_died = false;
+    for (u32 particle_index = 0; particle_index < sim->count; particle_index += PARTICLE_LANE_COUNT) {
+        __m128 x = _mm_load_ps(sim->x + particle_index);
+        __m128 y = _mm_load_ps(sim->y + particle_index);
+        __m128 dx = _mm_load_ps(sim->dx + particle_index);
+        __m128 dy = _mm_load_ps(sim->dy + particle_index);
+        __m128 life = _mm_load_ps(sim->life + particle_index);
+        __m128 life_rate = _mm_load_ps(sim->life_rate + particle_index);
+
+        x = _mm_add_ps(x, _mm_mul_ps(dx, dt_4));
+        y = _mm_add_ps(y, _mm_mul_ps(dy, dt_4));
+        life = _mm_sub_ps(life, _mm_mul_ps(life_rate, dt_4));
+
+        _mm_store_ps(sim->x + particle_index, x);
+        _mm_store_ps(sim->y + particle_index, y);
+        _mm_store_ps(sim->life + particle_index, life);
+
+        u32 live_lanes = sim->count - particle_index;
+        u32 lane_mask = (live_lanes >= PARTICLE_LANE_COUNT) ? 0xF : ((1 << live_lanes) - 1);
+        if (_mm_movemask_ps(_mm_cmple_ps(life, zero)) & lane_mask) {
+            any_died = true;
+        }
+    }
+
+    if (any_died) {
+        for (u32 particle_index = 0; particle_index < sim->count;) {
+            if (sim->life[particle_index] <= 0.0f) {
+                u32 last_index = --sim->count;
+                sim->x[particle_index]         = sim->x[last_index];
+                sim->y[particle_index]         = sim->y[last_index];
+                sim->dx[particle_index]        = sim->dx[last_index];
+                sim->dy[particle_index]        = sim->dy[last_index];
+                sim->life[particle_index]      = sim->life[last_index];
+                sim->life_rate[particle_index] = sim->life_rate[last_index];
+                sim->alpha[particle_index]     = sim->alpha[last_index];
+                sim->inv_depth[particle_index] = sim->inv_depth[last_index];
+            } else {
+                particle_index++;
+            }
+        }
+    }
+}
+
+// @Note: Writes where the particles are as seen from the render context's camera out to the frame arena and pushes them.
+// They fade in over the first half of their life and back out over the second.
+internal RenderCommandParticleSystem* push_particles(RenderContext* render_context, ParticleSimulation* sim, f32 sort_key = 0.0f) {
+    if (!sim->count) {
+        return 0;
+    }
+
+    u32 padded_count = get_padded_particle_count(sim->count);
+
+    ParticleSystem* system = push_struct(render_context->commands->frame_arena, ParticleSystem, no_clear());
+    system->count = sim->count;
+    system->half_size = sim->half_size;
+    system->x = push_frame_array(render_context, padded_count, f32, align_no_clear(16));
+    system->y = push_frame_array(render_context, padded_count, f32, align_no_clear(16));
+    system->alpha = push_frame_array(render_context, padded_count, f32, align_no_clear(16));
+
+    __m128 camera_x = _mm_set1_ps(render_context->camera_p.x);
+    __m128 camera_y = _mm_set1_ps(render_context->camera_p.y);
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 four = _mm_set1_ps(4.0f);
+    __m128 infinity = _mm_set1_ps(F32_MAX);
+    __m128i count_4 = _mm_set1_epi32(cast(s32) sim->count);
+
+    __m128 negative_infinity = _mm_set1_ps(-F32_MAX);
+
+    __m128 min_x = infinity;
+    __m128 min_y = infinity;
+    __m128 max_x = negative_infinity;
+    __m128 max_y = negative_infinity;
+
+    for (u32 particle_index = 0; particle_index < padded_count; particle_index += PARTICLE_LANE_COUNT) {
+        __m128i lane_index = _mm_add_epi32(_mm_set1_epi32(cast(s32) particle_index), _mm_setr_epi32(0, 1, 2, 3));
+        __m128 live = _mm_castsi128_ps(_mm_cmplt_epi32(lane_index, count_4));
+
+        __m128 follow = _mm_sub_ps(one, _mm_load_ps(sim->inv_depth + particle_index));
+        __m128 x = _mm_add_ps(_mm_load_ps(sim->x + particle_index), _mm_mul_ps(follow, camera_x));
+        __m128 y = _mm_add_ps(_mm_load_ps(sim->y + particle_index), _mm_mul_ps(follow, camera_y));
+
+        __m128 life = _mm_load_ps(sim->life + particle_index);
+        __m128 fade = _mm_mul_ps(four, _mm_mul_ps(life, _mm_sub_ps(one, life)));
+        __m128 alpha = _mm_and_ps(live, _mm_mul_ps(_mm_load_ps(sim->alpha + particle_index), fade));
+
+        _mm_store_ps(system->x + particle_index, x);
+        _mm_store_ps(system->y + particle_index, y);
+        _mm_store_ps(system->alpha + particle_index, alpha);
+
+        min_x = _mm_min_ps(min_x, _mm_or_ps(_mm_and_ps(live, x), _mm_andnot_ps(live, infinity)));
+        min_y = _mm_min_ps(min_y, _mm_or_ps(_mm_and_ps(live, y), _mm_andnot_ps(live, infinity)));
+        max_x = _mm_max_ps(max_x, _mm_or_ps(_mm_and_ps(live, x), _mm_andnot_ps(live, negative_infinity)));
+        max_y = _mm_max_ps(max_y, _mm_or_ps(_mm_and_ps(live, y), _mm_andnot_ps(live, negative_infinity)));
+    }
+
+    f32 lanes[4][PARTICLE_LANE_COUNT];
+    _mm_storeu_ps(lanes[0], min_x);
+    _mm_storeu_ps(lanes[1], min_y);
+    _mm_storeu_ps(lanes[2], max_x);
+    _mm_storeu_ps(lanes[3], max_y);
+
+    system->bounds = aab_min_max(vec2(lanes[0][0], lanes[1][0]), vec2(lanes[2][0], lanes[3][0]));
+    for (u32 lane_index = 1; lane_index < PARTICLE_LANE_COUNT; lane_index++) {
+        system->bounds.min = min(system->bounds.min, vec2(lanes[0][lane_index], lanes[1][lane_index]));
+        system->bounds.max = max(system->bounds.max, vec2(lanes[2][lane_index], lanes[3][lane_index]));
+    }
+
+    RenderCommandParticleSystem* result = push_particle_system(render_context, default_transform2d(), system, sort_key);
+    return result;
+}
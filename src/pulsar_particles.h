@@ -0,0 +1,62 @@
+#ifndef PULSAR_PARTICLES_H
+#define PULSAR_PARTICLES_H
+
+// @Note: Particles get simulated as a structure of arrays, PARTICLE_LANE_COUNT at a time with SSE2, and come and go in
+// batches: emitters spawn a run of them at the end of the arrays, and dead ones get swapped out for the last live one.
+// Every frame, what gets drawn is written out to a ParticleSystem on the frame arena in the same pass over the arrays,
+// because the platform can still be drawing the previous frame's particles while these ones move on.
+//
+// Particles live in parallax space: with the camera at camera_p, a particle at p is drawn at
+// p + (1 - inv_depth)*camera_p, so the ones further back follow the camera more and look further away.
+
+struct ParticleSimulation {
+    u32 capacity; // @Note: A multiple of PARTICLE_LANE_COUNT
+    u32 count;
+    u32 max_count; // @Note: Emitters stop here, which can be lower than capacity to fit what the renderer can draw
+
+    f32 half_size;
+
+    // @Note: 16 byte aligned. life goes from 1 down to 0 at life_rate per second, and the particle dies at 0.
+    f32* x;
+    f32* y;
+    f32* dx;
+    f32* dy;
+    f32* life;
+    f32* life_rate;
+    f32* alpha;
+    f32* inv_depth;
+
+    RandomSeries random_series;
+};
+
+// @Note: Where a midi note on asked for particles. x is how far across the view the note's pitch is, and strength is
+// the note's velocity scaled by how loud its soundtrack is.
+struct ParticleBurst {
+    f32 x;
+    f32 strength;
+};
+
+#define PARTICLE_EMITTER_MAX_BURSTS 64
+
+struct ParticleEmitter {
+    // @Note: Everywhere in the view, all the time
+    f32 particles_per_second;
+
+    // @Note: Around the burst's spot in the view, per note at full strength
+    f32 particles_per_note;
+    f32 burst_radius;
+    f32 burst_speed;
+
+    v2 velocity;
+    v2 velocity_spread;
+    f32 min_lifetime, max_lifetime;
+    f32 min_alpha, max_alpha;
+    f32 min_depth, max_depth;
+
+    f32 emit_remainder;
+
+    u32 burst_count;
+    ParticleBurst bursts[PARTICLE_EMITTER_MAX_BURSTS];
+};
+
+#endif /* PULSAR_PARTICLES_H */
@@ -10,12 +10,26 @@ typedef PLATFORM_READ_ENTIRE_FILE(PlatformReadEntireFile);
 #define PLATFORM_WRITE_ENTIRE_FILE(name) b32 name(char* file_name, u32 size, void* data)
 typedef PLATFORM_WRITE_ENTIRE_FILE(PlatformWriteEntireFile);
 
+// @Note: Writes the chunks back to back, so data that lives in several places doesn't have to be gathered first
+#define PLATFORM_WRITE_ENTIRE_FILE_CHUNKED(name) b32 name(char* file_name, u32 chunk_count, FileChunk* chunks)
+typedef PLATFORM_WRITE_ENTIRE_FILE_CHUNKED(PlatformWriteEntireFileChunked);
+
 #define PLATFORM_ALLOCATE_MEMORY(name) void* name(size_t size)
 typedef PLATFORM_ALLOCATE_MEMORY(PlatformAllocateMemory);
 
 #define PLATFORM_DEALLOCATE_MEMORY(name) void name(void* memory)
 typedef PLATFORM_DEALLOCATE_MEMORY(PlatformDeallocateMemory);
 
+// @Note: Reserved memory is released with PlatformDeallocateMemory like any other allocation
+#define PLATFORM_RESERVE_MEMORY(name) void* name(size_t size)
+typedef PLATFORM_RESERVE_MEMORY(PlatformReserveMemory);
+
+#define PLATFORM_COMMIT_MEMORY(name) COMMIT_MEMORY(name)
+typedef PLATFORM_COMMIT_MEMORY(PlatformCommitMemory);
+
+#define PLATFORM_DECOMMIT_MEMORY(name) DECOMMIT_MEMORY(name)
+typedef PLATFORM_DECOMMIT_MEMORY(PlatformDecommitMemory);
+
 #define PLATFORM_ALLOCATE_TEXTURE(name) void* name(u32 w, u32 h, void* data, PixelFormat format)
 typedef PLATFORM_ALLOCATE_TEXTURE(PlatformAllocateTexture);
 
@@ -53,8 +67,12 @@ typedef PLATFORM_GET_UNREAD_LOG_MESSAGES(PlatformGetUnreadLogMessages);
 struct PlatformAPI {
     PlatformReadEntireFile* read_entire_file;
     PlatformWriteEntireFile* write_entire_file;
+    PlatformWriteEntireFileChunked* write_entire_file_chunked;
     PlatformAllocateMemory* allocate;
     PlatformDeallocateMemory* deallocate;
+    PlatformReserveMemory* reserve;
+    PlatformCommitMemory* commit;
+    PlatformDecommitMemory* decommit;
     PlatformAllocateTexture* allocate_texture;
     PlatformDeallocateTexture* deallocate_texture;
 
@@ -67,6 +85,8 @@ struct PlatformAPI {
 struct DebugFrameInfo {
     f32 time;
     u32 render_commands;
+    u32 culled_render_commands;
+    u32 draw_batches;
 };
 
 struct DebugFrameTimeHistory {
@@ -95,9 +115,15 @@ introspect() struct GameConfig {
     u32 command_buffer_size_mb    = 16;
     u32 permanent_storage_size_mb = 256;
     u32 transient_storage_size_mb = 512;
+    u32 arena_decommit_threshold_mb = 64;
+    b32 use_large_pages = false;
+    u32 prefault_storage_mb = 64;
 
     // Graphics
     u32 msaa_count = 8;
+    b32 use_shader_renderer = true;
+    b32 use_software_renderer = false;
+    u32 software_renderer_thread_count = 0;
 
     // Sound
     f32 master_volume   = 1.0f;
@@ -178,7 +204,8 @@ introspect() struct GameConfig {
 
 //
 // @Note: Game Memory HAS to be initialized with ZEROED memory!
-//
+// permanent_storage and transient_storage are only reserved, the game commits pages as it needs them through
+// platform_api.commit.
 
 struct GameMemory {
     b32 initialized;
@@ -212,9 +239,16 @@ struct GameRenderCommands {
     // render commands starting at first_command up until command_buffer_size
     u8* command_buffer;
 
-    u32 temp_buffer_size;
-    u32 temp_buffer_used;
-    u8* temp_buffer;
+    // @Note: How many commands the push functions threw away for being off screen, the ones that made it are
+    // sort_entry_count
+    u32 culled_command_count;
+
+    // @Note: Set by the platform. How many particles its render backend can draw and still hold 60Hz.
+    u32 max_particle_count;
+
+    // @Note: Set by the game every frame. Render commands may point into the frame arena, which stays alive until
+    // game_post_render is called with these commands, so the platform has to be done rendering them by then.
+    MemoryArena* frame_arena;
 };
 
 struct GameButtonState {
@@ -0,0 +1,191 @@
+inline u32 get_image_asset_id(Assets* assets, Image* image) {
+    // @Note: Images are the first member of Asset's union, so an image that came from the catalog is its asset
+    u32 result = 0;
+    Asset* asset = cast(Asset*) image;
+    if (asset >= assets->asset_catalog && asset < assets->asset_catalog + assets->asset_count) {
+        result = cast(u32) (asset - assets->asset_catalog);
+    }
+    return result;
+}
+
+inline u32 get_glyph_table_font_id(Assets* assets, PackedGlyph* glyph_table) {
+    u32 result = 0;
+    for (u32 asset_index = 1; asset_index < assets->asset_count; asset_index++) {
+        Asset* asset = assets->asset_catalog + asset_index;
+        if (asset->type == AssetType_Font && asset->font.glyph_table == glyph_table) {
+            result = asset_index;
+            break;
+        }
+    }
+    return result;
+}
+
+internal void end_render_capture(RenderCapture* capture, Assets* assets) {
+    capture->header.magic_value = ASSET_PACK_CODE('p', 'r', 'c', 'f');
+    capture->header.version = RENDER_CAPTURE_VERSION;
+    capture->header.frame_count = capture->frame_count;
+    capture->header.asset_count = assets->asset_count;
+
+    capture->chunks[0].size = sizeof(capture->header);
+    capture->chunks[0].data = &capture->header;
+
+    if (platform.write_entire_file_chunked(RENDER_CAPTURE_FILE_NAME, 1 + capture->frame_count, capture->chunks)) {
+        log_print(LogLevel_Info, "Wrote %u frames of render commands to '%s'", capture->frame_count, RENDER_CAPTURE_FILE_NAME);
+    } else {
+        log_print(LogLevel_Error, "Could not write render commands to '%s'", RENDER_CAPTURE_FILE_NAME);
+    }
+
+    for (u32 frame_index = 0; frame_index < capture->frame_count; frame_index++) {
+        platform.deallocate(capture->chunks[1 + frame_index].data);
+    }
+
+    capture->frames_requested = 0;
+    capture->frame_count = 0;
+}
+
+internal void begin_render_capture(RenderCapture* capture, u32 frame_count) {
+    if (capture->frames_requested) {
+        log_print(LogLevel_Warn, "Already capturing render commands, %u of %u frames done", capture->frame_count, capture->frames_requested);
+    } else {
+        capture->frames_requested = CLAMP(frame_count, 1, RENDER_CAPTURE_MAX_FRAMES);
+        capture->frame_count = 0;
+    }
+}
+
+// @Note: Takes the commands as pushed, before the platform sorts them
+internal void capture_render_frame(RenderCapture* capture, GameRenderCommands* commands, Assets* assets) {
+    assert(capture->frames_requested && capture->frame_count < capture->frames_requested);
+
+    SortEntry* entries = cast(SortEntry*) commands->command_buffer;
+
+    RenderCaptureFrame frame_header = {};
+    frame_header.width = commands->width;
+    frame_header.height = commands->height;
+    frame_header.sort_entry_count = commands->sort_entry_count;
+
+    for (u32 entry_index = 0; entry_index < commands->sort_entry_count; entry_index++) {
+        u8* at = commands->command_buffer + entries[entry_index].index;
+        RenderCommandHeader* header = cast(RenderCommandHeader*) at;
+        at += sizeof(*header);
+
+        frame_header.command_size += render_command_size(header->type);
+
+        if (header->type == RenderCommand_Shape) {
+            RenderCommandShape* command = cast(RenderCommandShape*) at;
+            if (command->shape.type == Shape_Polygon) {
+                frame_header.data_size += cast(u32) (sizeof(v2)*command->shape.vert_count + 3*sizeof(u16)*command->triangle_count);
+            }
+        } else if (header->type == RenderCommand_RectBatch) {
+            RenderCommandRectBatch* command = cast(RenderCommandRectBatch*) at;
+            frame_header.data_size += cast(u32) sizeof(RenderRect)*command->rect_count;
+        } else if (header->type == RenderCommand_ParticleSystem) {
+            RenderCommandParticleSystem* command = cast(RenderCommandParticleSystem*) at;
+            frame_header.data_size += cast(u32) (sizeof(ParticleSystem) + 3*sizeof(f32)*get_padded_particle_count(command->system->count));
+        } else if (header->type == RenderCommand_GlyphRun) {
+            RenderCommandGlyphRun* command = cast(RenderCommandGlyphRun*) at;
+            frame_header.data_size += cast(u32) sizeof(RenderGlyph)*command->glyph_count;
+        }
+    }
+    frame_header.command_size = cast(u32) align_pow2(frame_header.command_size, 8);
+
+    u32 frame_size = get_render_capture_frame_size(&frame_header);
+    u8* frame_memory = cast(u8*) platform.allocate(frame_size);
+    if (!frame_memory) {
+        log_print(LogLevel_Error, "Could not allocate %u bytes to capture a frame of render commands, stopping the capture", frame_size);
+        end_render_capture(capture, assets);
+        return;
+    }
+
+    *cast(RenderCaptureFrame*) frame_memory = frame_header;
+
+    SortEntry* dest_entries = cast(SortEntry*) (frame_memory + sizeof(RenderCaptureFrame));
+    u8* dest_commands = cast(u8*) (dest_entries + frame_header.sort_entry_count);
+    u8* dest_data = dest_commands + frame_header.command_size;
+
+    u32 command_at = 0;
+    u32 data_at = 0;
+    for (u32 entry_index = 0; entry_index < commands->sort_entry_count; entry_index++) {
+        u8* source = commands->command_buffer + entries[entry_index].index;
+        u32 command_size = render_command_size((cast(RenderCommandHeader*) source)->type);
+
+        dest_entries[entry_index].sort_key = entries[entry_index].sort_key;
+        dest_entries[entry_index].index = command_at;
+
+        u8* dest = dest_commands + command_at;
+        copy(command_size, source, dest);
+        command_at += command_size;
+
+        RenderCommandHeader* header = cast(RenderCommandHeader*) dest;
+        u8* at = dest + sizeof(*header);
+
+        switch (header->type) {
+            case RenderCommand_RectBatch: {
+                RenderCommandRectBatch* command = cast(RenderCommandRectBatch*) at;
+                u32 rects_size = cast(u32) sizeof(RenderRect)*command->rect_count;
+                copy(rects_size, command->rects, dest_data + data_at);
+                command->rects = cast(RenderRect*) cast(size_t) data_at;
+                data_at += rects_size;
+            } break;
+
+            case RenderCommand_Shape: {
+                RenderCommandShape* command = cast(RenderCommandShape*) at;
+                if (command->shape.type == Shape_Polygon) {
+                    u32 vertices_size = cast(u32) sizeof(v2)*command->shape.vert_count;
+                    copy(vertices_size, command->shape.vertices, dest_data + data_at);
+                    command->shape.vertices = cast(v2*) cast(size_t) data_at;
+                    data_at += vertices_size;
+
+                    u32 indices_size = cast(u32) (3*sizeof(u16)*command->triangle_count);
+                    copy(indices_size, command->triangle_indices, dest_data + data_at);
+                    command->triangle_indices = 0;
+                    data_at += indices_size;
+                }
+            } break;
+
+            case RenderCommand_Image: {
+                RenderCommandImage* command = cast(RenderCommandImage*) at;
+                command->image = cast(Image*) cast(size_t) get_image_asset_id(assets, command->image);
+            } break;
+
+            case RenderCommand_ParticleSystem: {
+                RenderCommandParticleSystem* command = cast(RenderCommandParticleSystem*) at;
+                ParticleSystem* dest_system = cast(ParticleSystem*) (dest_data + data_at);
+                *dest_system = *command->system;
+                dest_system->x = 0;
+                dest_system->y = 0;
+                dest_system->alpha = 0;
+
+                u32 padded_count = get_padded_particle_count(dest_system->count);
+                f32* dest_arrays = cast(f32*) (dest_system + 1);
+                copy(sizeof(f32)*padded_count, command->system->x, dest_arrays);
+                copy(sizeof(f32)*padded_count, command->system->y, dest_arrays + padded_count);
+                copy(sizeof(f32)*padded_count, command->system->alpha, dest_arrays + 2*padded_count);
+
+                command->system = cast(ParticleSystem*) cast(size_t) data_at;
+                data_at += cast(u32) (sizeof(ParticleSystem) + 3*sizeof(f32)*padded_count);
+            } break;
+
+            case RenderCommand_GlyphRun: {
+                RenderCommandGlyphRun* command = cast(RenderCommandGlyphRun*) at;
+                u32 glyphs_size = cast(u32) sizeof(RenderGlyph)*command->glyph_count;
+                copy(glyphs_size, command->glyphs, dest_data + data_at);
+                command->glyphs = cast(RenderGlyph*) cast(size_t) data_at;
+                command->atlas_page = cast(Image*) cast(size_t) get_image_asset_id(assets, command->atlas_page);
+                command->glyph_table = cast(PackedGlyph*) cast(size_t) get_glyph_table_font_id(assets, command->glyph_table);
+                data_at += glyphs_size;
+            } break;
+        }
+    }
+
+    // @Note: Clear the padding, so captures of the same frames come out the same
+    zero_size(frame_header.command_size - command_at, dest_commands + command_at);
+    assert(data_at == frame_header.data_size);
+
+    FileChunk* chunk = capture->chunks + 1 + capture->frame_count++;
+    chunk->size = frame_size;
+    chunk->data = frame_memory;
+
+    if (capture->frame_count == capture->frames_requested) {
+        end_render_capture(capture, assets);
+    }
+}
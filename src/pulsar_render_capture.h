@@ -0,0 +1,204 @@
+#ifndef PULSAR_RENDER_CAPTURE_H
+#define PULSAR_RENDER_CAPTURE_H
+
+// @Note: A render capture is a run of frames' GameRenderCommands written out by the capture_frames console command, for
+// pulsar_render_replay to play back through any of the renderers. Frames are stored in push order, before the platform
+// sorted them. The commands are stored like they are in the command buffer, except that every pointer in them is
+// swapped out for something that means the same thing in another process:
+//     RenderCommandImage::image           the image's asset id, in the asset pack the capture was made with
+//     RenderCommandShape::shape.vertices  the offset of the vertices in the frame's data, followed by the triangle
+//                                         indices of filled polygons
+//     RenderCommandShape::triangle_indices 0
+//     RenderCommandRectBatch::rects       the offset of the rects in the frame's data
+//     RenderCommandParticleSystem::system the offset of a ParticleSystem in the frame's data, followed by its padded x, y
+//                                         and alpha arrays
+//     RenderCommandGlyphRun::atlas_page   the page's asset id
+//     RenderCommandGlyphRun::glyph_table  the asset id of the font it belongs to
+//     RenderCommandGlyphRun::glyphs       the offset of the glyphs in the frame's data
+// Like the asset pack, the structs are written as they are in memory, so a capture only plays back in a build with the
+// same struct layout.
+
+#define RENDER_CAPTURE_FILE_NAME "render_capture.prc"
+#define RENDER_CAPTURE_MAX_FRAMES 600
+
+struct RenderCaptureHeader {
+    u32 magic_value;
+
+#define RENDER_CAPTURE_VERSION 5
+    u32 version;
+
+    u32 frame_count;
+    u32 asset_count; // @Note: Of the asset pack the frames were captured with
+};
+
+struct RenderCaptureFrame {
+    u32 width;
+    u32 height;
+    u32 sort_entry_count;
+    u32 command_size; // @Note: Padded to 8 bytes, so the data that follows stays aligned
+    u32 data_size;
+
+    /* Data:
+     * SortEntry sort_entries[sort_entry_count]; // @Note: Indices are relative to the first command
+     * u8 commands[command_size];
+     * u8 data[data_size];
+     */
+};
+
+// @Note: Game side state of a capture in progress. Every frame is a separate block from platform.allocate, so a long
+// capture doesn't need one huge allocation up front.
+struct RenderCapture {
+    u32 frames_requested; // @Note: 0 when not capturing
+    u32 frame_count;
+
+    RenderCaptureHeader header;
+    FileChunk chunks[1 + RENDER_CAPTURE_MAX_FRAMES]; // @Note: The header and then the frames, ready to be written out
+};
+
+inline u32 render_command_size(u8 type) {
+    u32 result = cast(u32) sizeof(RenderCommandHeader);
+    switch (type) {
+        case RenderCommand_Clear:          { result += cast(u32) sizeof(RenderCommandClear);          } break;
+        case RenderCommand_RectBatch:      { result += cast(u32) sizeof(RenderCommandRectBatch);      } break;
+        case RenderCommand_Shape:          { result += cast(u32) sizeof(RenderCommandShape);          } break;
+        case RenderCommand_Image:          { result += cast(u32) sizeof(RenderCommandImage);          } break;
+        case RenderCommand_ParticleSystem: { result += cast(u32) sizeof(RenderCommandParticleSystem); } break;
+        case RenderCommand_GlyphRun:       { result += cast(u32) sizeof(RenderCommandGlyphRun);       } break;
+        INVALID_DEFAULT_CASE;
+    }
+    return result;
+}
+
+inline u32 get_render_capture_frame_size(RenderCaptureFrame* frame) {
+    u32 result = cast(u32) (sizeof(RenderCaptureFrame) + sizeof(SortEntry)*frame->sort_entry_count) + frame->command_size + frame->data_size;
+    return result;
+}
+
+// @Note: What the asset ids in a capture turn back into when it's played, indexed by asset id
+struct RenderCaptureAssets {
+    u32 asset_count;
+    Image** images; // @Note: 0 for assets that aren't images
+    PackedGlyph** glyph_tables; // @Note: 0 for assets that aren't fonts
+    u32* glyph_counts;
+    Image* missing_image;
+};
+
+inline Image* get_render_capture_image(RenderCaptureAssets* assets, size_t asset_id) {
+    Image* result = (asset_id && asset_id < assets->asset_count && assets->images[asset_id]) ? assets->images[asset_id] : assets->missing_image;
+    return result;
+}
+
+// @Note: Turns a captured frame back into render commands in place. Images that are out of range or null get the
+// missing image instead, and glyph runs from fonts that aren't there lose their glyphs. Returns false if the frame
+// doesn't add up.
+inline b32 restore_render_capture_frame(RenderCaptureFrame* frame, GameRenderCommands* commands, RenderCaptureAssets* assets) {
+    zero_struct(*commands);
+
+    u32 entries_size = cast(u32) sizeof(SortEntry)*frame->sort_entry_count;
+    u8* frame_base = cast(u8*) (frame + 1);
+    u8* data = frame_base + entries_size + frame->command_size;
+
+    commands->width = frame->width;
+    commands->height = frame->height;
+    commands->sort_entry_count = frame->sort_entry_count;
+    commands->first_command = entries_size;
+    commands->command_buffer_size = entries_size + frame->command_size;
+    commands->command_buffer = frame_base;
+
+    SortEntry* entries = cast(SortEntry*) frame_base;
+    for (u32 entry_index = 0; entry_index < frame->sort_entry_count; entry_index++) {
+        SortEntry* entry = entries + entry_index;
+        if (entry->index >= frame->command_size) {
+            return false;
+        }
+        entry->index += entries_size;
+
+        u8* at = commands->command_buffer + entry->index;
+        RenderCommandHeader* header = cast(RenderCommandHeader*) at;
+        at += sizeof(*header);
+
+        if (header->type > RenderCommand_GlyphRun || entry->index + render_command_size(header->type) > commands->command_buffer_size) {
+            return false;
+        }
+
+        switch (header->type) {
+            case RenderCommand_RectBatch: {
+                RenderCommandRectBatch* command = cast(RenderCommandRectBatch*) at;
+                size_t offset = cast(size_t) command->rects;
+                if (offset + sizeof(RenderRect)*command->rect_count > frame->data_size) {
+                    return false;
+                }
+                command->rects = cast(RenderRect*) (data + offset);
+            } break;
+
+            case RenderCommand_Shape: {
+                RenderCommandShape* command = cast(RenderCommandShape*) at;
+                if (command->shape.type == Shape_Polygon) {
+                    size_t offset = cast(size_t) command->shape.vertices;
+                    size_t vertices_size = sizeof(v2)*command->shape.vert_count;
+                    if (offset + vertices_size + 3*sizeof(u16)*command->triangle_count > frame->data_size) {
+                        return false;
+                    }
+                    command->shape.vertices = cast(v2*) (data + offset);
+                    command->triangle_indices = cast(u16*) (data + offset + vertices_size);
+
+                    for (u32 corner_index = 0; corner_index < 3*command->triangle_count; corner_index++) {
+                        if (command->triangle_indices[corner_index] >= command->shape.vert_count) {
+                            return false;
+                        }
+                    }
+                }
+            } break;
+
+            case RenderCommand_Image: {
+                RenderCommandImage* command = cast(RenderCommandImage*) at;
+                command->image = get_render_capture_image(assets, cast(size_t) command->image);
+            } break;
+
+            case RenderCommand_ParticleSystem: {
+                RenderCommandParticleSystem* command = cast(RenderCommandParticleSystem*) at;
+                size_t offset = cast(size_t) command->system;
+                if (offset + sizeof(ParticleSystem) > frame->data_size) {
+                    return false;
+                }
+
+                ParticleSystem* system = cast(ParticleSystem*) (data + offset);
+                u32 padded_count = get_padded_particle_count(system->count);
+                if (offset + sizeof(ParticleSystem) + 3*sizeof(f32)*padded_count > frame->data_size) {
+                    return false;
+                }
+                system->x = cast(f32*) (system + 1);
+                system->y = system->x + padded_count;
+                system->alpha = system->y + padded_count;
+                command->system = system;
+            } break;
+
+            case RenderCommand_GlyphRun: {
+                RenderCommandGlyphRun* command = cast(RenderCommandGlyphRun*) at;
+                size_t offset = cast(size_t) command->glyphs;
+                if (offset + sizeof(RenderGlyph)*command->glyph_count > frame->data_size) {
+                    return false;
+                }
+                command->glyphs = cast(RenderGlyph*) (data + offset);
+                command->atlas_page = get_render_capture_image(assets, cast(size_t) command->atlas_page);
+
+                size_t font_id = cast(size_t) command->glyph_table;
+                if (font_id && font_id < assets->asset_count && assets->glyph_tables[font_id]) {
+                    command->glyph_table = assets->glyph_tables[font_id];
+                    for (u32 glyph_index = 0; glyph_index < command->glyph_count; glyph_index++) {
+                        if (command->glyphs[glyph_index].glyph_index >= assets->glyph_counts[font_id]) {
+                            return false;
+                        }
+                    }
+                } else {
+                    command->glyph_table = 0;
+                    command->glyph_count = 0;
+                }
+            } break;
+        }
+    }
+
+    return true;
+}
+
+#endif /* PULSAR_RENDER_CAPTURE_H */
@@ -61,8 +61,16 @@ inline v4 transform_color(v4 color) {
     return result;
 }
 
-#define push_render_command(commands, type, sort_key) cast(RenderCommand##type*) push_render_command_(commands, RenderCommand_##type, sizeof(RenderCommand##type), sort_key)
-inline void* push_render_command_(GameRenderCommands* commands, RenderCommandType type, u32 render_command_size, f32 sort_key) {
+// @Note: The f32 sort key everyone passes in picks the layer. Inside a layer, commands are ordered by type and then by
+// texture, so the renderer sees runs of the same state it can batch. Push order only holds between commands of the same
+// type and texture, so anything that has to draw over a different kind of command needs a higher sort key.
+inline u64 render_sort_key(f32 layer, RenderCommandType type, u32 texture_id = 0) {
+    u64 result = sort_key_from_f32(layer) | (cast(u64) (type & 0xFF) << 24) | (texture_id & 0xFFFFFF);
+    return result;
+}
+
+#define push_render_command(commands, type, sort_key, ...) cast(RenderCommand##type*) push_render_command_(commands, RenderCommand_##type, sizeof(RenderCommand##type), sort_key, ##__VA_ARGS__)
+inline void* push_render_command_(GameRenderCommands* commands, RenderCommandType type, u32 render_command_size, f32 sort_key, u32 texture_id = 0) {
     void* result = 0;
     u32 next_command_index = commands->first_command - render_command_size - sizeof(RenderCommandHeader);
     if (sizeof(SortEntry)*(commands->sort_entry_count + 1) < next_command_index) {
@@ -75,7 +83,7 @@ inline void* push_render_command_(GameRenderCommands* commands, RenderCommandTyp
 
         SortEntry* sort_entry = cast(SortEntry*) commands->command_buffer + commands->sort_entry_count++;
 
-        sort_entry->sort_key = sort_key;
+        sort_entry->sort_key = render_sort_key(sort_key, type, texture_id);
         sort_entry->index = commands->first_command;
     } else {
         INVALID_CODE_PATH;
@@ -91,26 +99,129 @@ inline RenderCommandClear* push_clear(RenderContext* render_context, v4 color, f
     return result;
 }
 
-inline RenderCommandImage* push_image(RenderContext* render_context, Transform2D world_transform, Image* image, v4 color = vec4(1, 1, 1, 1), f32 sort_key = 0.0f) {
-    RenderCommandImage* result = push_render_command(render_context->commands, Image, render_context->sort_key_bias + sort_key);
+// @Note: Outlines and lines are drawn a couple of pixels wide, centered on the shape's edges
+#define RENDER_CULL_MARGIN 4.0f
+
+// @Note: Conservative screen culling, on a circle around the command's screen space offset that holds everything the
+// command could touch. Counts the commands it culls, so they can be compared against the ones that made it.
+inline b32 screen_circle_is_visible(RenderContext* render_context, v2 center, f32 radius) {
+    v2 screen_dim = get_screen_dim(render_context);
+    radius += RENDER_CULL_MARGIN;
+
+    b32 result = (center.x + radius >= 0.0f && center.x - radius <= screen_dim.x &&
+                  center.y + radius >= 0.0f && center.y - radius <= screen_dim.y);
+    if (!result) {
+        render_context->commands->culled_command_count++;
+    }
+    return result;
+}
+
+// @Note: An upper bound on the distance from the origin to the box after it's been scaled and rotated the way the
+// renderers do it, which never stretches anything by more than the largest scale component
+inline f32 get_scaled_bounding_radius(AxisAlignedBox2 aab, v2 scale) {
+    v2 farthest_corner = vec2(max(abs(aab.min.x), abs(aab.max.x)), max(abs(aab.min.y), abs(aab.max.y)));
+    f32 result = length(farthest_corner)*max(abs(scale.x), abs(scale.y));
+    return result;
+}
+
+// @Note: Like push_image, but for the part of the image between min_uv and max_uv, which gets treated as an image of dim
+// texels aligned by align. World transforms scale it like they would an image of that size.
+inline RenderCommandImage* push_image_region(RenderContext* render_context, Transform2D world_transform, Image* image, v2 dim, v2 align, v2 min_uv, v2 max_uv, v4 color = vec4(1, 1, 1, 1), f32 sort_key = 0.0f) {
+    Transform2D transform = world_to_screen(render_context, world_transform);
+    transform.scale *= image->scale / dim;
+
+    AxisAlignedBox2 image_aab = aab_min_dim(-align*dim, dim);
+    if (!screen_circle_is_visible(render_context, transform.offset, get_scaled_bounding_radius(image_aab, transform.scale))) {
+        return 0;
+    }
+
+    RenderCommandImage* result = push_render_command(render_context->commands, Image, render_context->sort_key_bias + sort_key, cast(u32) cast(size_t) image->handle);
     if (result) {
-        Transform2D transform = world_to_screen(render_context, world_transform);
-        transform.scale *= image->scale / vec2(image->w, image->h);
         result->transform = transform;
         result->image = image;
         result->color = transform_color(color);
+        result->dim = dim;
+        result->align = align;
+        result->min_uv = min_uv;
+        result->max_uv = max_uv;
     }
     return result;
 }
 
+inline RenderCommandImage* push_image(RenderContext* render_context, Transform2D world_transform, Image* image, v4 color = vec4(1, 1, 1, 1), f32 sort_key = 0.0f) {
+    RenderCommandImage* result = push_image_region(render_context, world_transform, image, vec2(image->w, image->h), image->align, vec2(0, 0), vec2(1, 1), color, sort_key);
+    return result;
+}
+
 inline RenderCommandShape* push_shape(RenderContext* render_context, Transform2D world_transform, Shape2D shape, v4 color = vec4(1, 1, 1, 1), ShapeRenderMode render_mode = ShapeRenderMode_Fill, f32 sort_key = 0.0f) {
+    Transform2D transform = world_to_screen(render_context, world_transform);
+    if (!screen_circle_is_visible(render_context, transform.offset, get_scaled_bounding_radius(shape.bounding_box, transform.scale))) {
+        return 0;
+    }
+
     RenderCommandShape* result = push_render_command(render_context->commands, Shape, render_context->sort_key_bias + sort_key);
     if (result) {
-        Transform2D transform = world_to_screen(render_context, world_transform);
         result->transform = transform;
         result->shape = shape;
         result->color = transform_color(color);
         result->render_mode = render_mode;
+        result->triangle_count = 0;
+        result->triangle_indices = 0;
+
+        if (shape.type == Shape_Polygon && render_mode == ShapeRenderMode_Fill) {
+            result->triangle_indices = get_polygon_triangulation(render_context->triangulation_cache, shape.vert_count, shape.vertices, render_context->commands->frame_arena, &result->triangle_count);
+        }
+    }
+    return result;
+}
+
+// @Note: bounds is where the rects cover, relative to the origin of the batch
+inline RenderCommandRectBatch* push_rect_batch(RenderContext* render_context, Transform2D world_transform, u32 rect_count, RenderRect* rects, AxisAlignedBox2 bounds, f32 sort_key = 0.0f) {
+    Transform2D transform = world_to_screen(render_context, world_transform);
+    if (!screen_circle_is_visible(render_context, transform.offset, get_scaled_bounding_radius(bounds, transform.scale))) {
+        return 0;
+    }
+
+    RenderCommandRectBatch* result = push_render_command(render_context->commands, RectBatch, render_context->sort_key_bias + sort_key);
+    if (result) {
+        result->transform = transform;
+        result->rect_count = rect_count;
+        result->rects = rects;
+    }
+    return result;
+}
+
+// @Note: Memory that stays alive until the platform is done with this frame, for anything a render command points to,
+// like the vertices of a Shape_Polygon.
+#define push_frame_array(render_context, count, type, ...) push_array((render_context)->commands->frame_arena, count, type, ##__VA_ARGS__)
+
+inline RenderCommandShape* push_polygon(RenderContext* render_context, Transform2D world_transform, u32 vert_count, v2* vertices, v4 color = vec4(1, 1, 1, 1), ShapeRenderMode render_mode = ShapeRenderMode_Fill, f32 sort_key = 0.0f) {
+    assert(arena_owns_address(render_context->commands->frame_arena, vertices));
+    RenderCommandShape* result = push_shape(render_context, world_transform, polygon(vert_count, vertices), color, render_mode, sort_key);
+    return result;
+}
+
+// @Note: bounds is where the glyphs cover, relative to the origin of the run and not counting the shadow
+inline RenderCommandGlyphRun* push_glyph_run(RenderContext* render_context, Transform2D world_transform, Image* atlas_page, PackedGlyph* glyph_table, u32 glyph_count, RenderGlyph* glyphs, AxisAlignedBox2 bounds, v4 color, v4 shadow_color = vec4(0, 0, 0, 0), v2 shadow_offset = vec2(0, 0), f32 sort_key = 0.0f) {
+    assert(arena_owns_address(render_context->commands->frame_arena, glyphs));
+
+    Transform2D transform = world_to_screen(render_context, world_transform);
+
+    AxisAlignedBox2 shadowed_bounds = aab_union(bounds, offset(bounds, shadow_offset));
+    if (!screen_circle_is_visible(render_context, transform.offset, get_scaled_bounding_radius(shadowed_bounds, transform.scale))) {
+        return 0;
+    }
+
+    RenderCommandGlyphRun* result = push_render_command(render_context->commands, GlyphRun, render_context->sort_key_bias + sort_key, cast(u32) cast(size_t) atlas_page->handle);
+    if (result) {
+        result->transform = transform;
+        result->atlas_page = atlas_page;
+        result->glyph_table = glyph_table;
+        result->color = transform_color(color);
+        result->shadow_color = transform_color(shadow_color);
+        result->shadow_offset = shadow_offset;
+        result->glyph_count = glyph_count;
+        result->glyphs = glyphs;
     }
     return result;
 }
@@ -128,9 +239,19 @@ inline RenderCommandShape* push_line(RenderContext* render_context, v2 start_p,
 }
 
 inline RenderCommandParticleSystem* push_particle_system(RenderContext* rc, Transform2D world_transform, ParticleSystem* system, f32 sort_key = 0.0f) {
+    assert(arena_owns_address(rc->commands->frame_arena, system));
+    assert(arena_owns_address(rc->commands->frame_arena, system->alpha));
+
+    Transform2D transform = world_to_screen(rc, world_transform);
+
+    AxisAlignedBox2 bounds = grow_by_radius(system->bounds, vec2(system->half_size, system->half_size));
+    if (!system->count || !screen_circle_is_visible(rc, transform.offset, get_scaled_bounding_radius(bounds, transform.scale))) {
+        return 0;
+    }
+
     RenderCommandParticleSystem* result = push_render_command(rc->commands, ParticleSystem, rc->sort_key_bias + sort_key);
     if (result) {
-        result->transform = world_to_screen(rc, world_transform);
+        result->transform = transform;
         result->system = system;
     }
     return result;
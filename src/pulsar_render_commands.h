@@ -10,6 +10,9 @@ struct RenderContext {
     f32 sort_key_bias;
 
     struct GameRenderCommands* commands;
+
+    // @Note: Optional, without one every filled polygon gets triangulated from scratch
+    struct TriangulationCache* triangulation_cache;
 };
 
 struct Image {
@@ -18,15 +21,24 @@ struct Image {
     void* handle;
 };
 
-struct Particle {
-    v2 p;
-    f32 alpha;
-    f32 depth;
-};
+// @Note: Particles are stored as a structure of arrays, so they can be transformed PARTICLE_LANE_COUNT at a time. The
+// arrays are padded up to a multiple of the lane count, and the padding has an alpha of 0.
+#define PARTICLE_LANE_COUNT 4
+
+inline u32 get_padded_particle_count(u32 count) {
+    u32 result = (count + PARTICLE_LANE_COUNT - 1) & ~(PARTICLE_LANE_COUNT - 1);
+    return result;
+}
 
+// @Note: Every particle is a square of half_size around its p, and bounds holds all of their ps
 struct ParticleSystem {
     u32 count;
-    Particle* particles;
+    f32 half_size;
+    AxisAlignedBox2 bounds;
+
+    f32* x;
+    f32* y;
+    f32* alpha;
 };
 
 inline AxisAlignedBox2 get_aligned_image_aab(Image* image) {
@@ -35,11 +47,14 @@ inline AxisAlignedBox2 get_aligned_image_aab(Image* image) {
     return result;
 }
 
+// @Note: Also the order commands of the same layer get drawn in, see render_sort_key
 enum RenderCommandType {
     RenderCommand_Clear,
+    RenderCommand_RectBatch,
     RenderCommand_Shape,
     RenderCommand_Image,
     RenderCommand_ParticleSystem,
+    RenderCommand_GlyphRun,
 };
 
 struct RenderCommandHeader {
@@ -61,12 +76,184 @@ struct RenderCommandShape {
     Shape2D shape;
     v4 color;
     ShapeRenderMode render_mode;
+
+    // @Note: Filled polygons only, 3 indices into shape.vertices per triangle, in the frame arena
+    u32 triangle_count;
+    u16* triangle_indices;
+};
+
+// @Note: Circles get as many segments as they need to stay within about a quarter of a pixel of round, in powers of two
+// so they can step through one table of points on the unit circle rather than doing any trig. Like they always have,
+// the points start at the top and go clockwise.
+#define CIRCLE_TABLE_SEGMENT_COUNT 256
+#define CIRCLE_MIN_SEGMENT_COUNT 8
+
+// @Note: sin and cos of TAU*i/CIRCLE_TABLE_SEGMENT_COUNT. It's written out rather than filled in on first use, because
+// the render threads read it too, and they'd race to fill it.
+global v2 unit_circle_points[CIRCLE_TABLE_SEGMENT_COUNT] = {
+    {  0.000000000f,  1.000000000f }, {  0.024541229f,  0.999698818f }, {  0.049067676f,  0.998795450f },
+    {  0.073564567f,  0.997290432f }, {  0.098017141f,  0.995184720f }, {  0.122410677f,  0.992479563f },
+    {  0.146730468f,  0.989176512f }, {  0.170961887f,  0.985277653f }, {  0.195090324f,  0.980785251f },
+    {  0.219101235f,  0.975702107f }, {  0.242980182f,  0.970031261f }, {  0.266712755f,  0.963776052f },
+    {  0.290284663f,  0.956940353f }, {  0.313681751f,  0.949528158f }, {  0.336889863f,  0.941544056f },
+    {  0.359895051f,  0.932992816f }, {  0.382683426f,  0.923879504f }, {  0.405241311f,  0.914209783f },
+    {  0.427555084f,  0.903989315f }, {  0.449611336f,  0.893224299f }, {  0.471396744f,  0.881921291f },
+    {  0.492898196f,  0.870086968f }, {  0.514102757f,  0.857728601f }, {  0.534997642f,  0.844853580f },
+    {  0.555570245f,  0.831469595f }, {  0.575808167f,  0.817584813f }, {  0.595699310f,  0.803207517f },
+    {  0.615231574f,  0.788346410f }, {  0.634393275f,  0.773010433f }, {  0.653172851f,  0.757208824f },
+    {  0.671558976f,  0.740951121f }, {  0.689540565f,  0.724247098f }, {  0.707106769f,  0.707106769f },
+    {  0.724247098f,  0.689540565f }, {  0.740951121f,  0.671558976f }, {  0.757208824f,  0.653172851f },
+    {  0.773010433f,  0.634393275f }, {  0.788346410f,  0.615231574f }, {  0.803207517f,  0.595699310f },
+    {  0.817584813f,  0.575808167f }, {  0.831469595f,  0.555570245f }, {  0.844853580f,  0.534997642f },
+    {  0.857728601f,  0.514102757f }, {  0.870086968f,  0.492898196f }, {  0.881921291f,  0.471396744f },
+    {  0.893224299f,  0.449611336f }, {  0.903989315f,  0.427555084f }, {  0.914209783f,  0.405241311f },
+    {  0.923879504f,  0.382683426f }, {  0.932992816f,  0.359895051f }, {  0.941544056f,  0.336889863f },
+    {  0.949528158f,  0.313681751f }, {  0.956940353f,  0.290284663f }, {  0.963776052f,  0.266712755f },
+    {  0.970031261f,  0.242980182f }, {  0.975702107f,  0.219101235f }, {  0.980785251f,  0.195090324f },
+    {  0.985277653f,  0.170961887f }, {  0.989176512f,  0.146730468f }, {  0.992479563f,  0.122410677f },
+    {  0.995184720f,  0.098017141f }, {  0.997290432f,  0.073564567f }, {  0.998795450f,  0.049067676f },
+    {  0.999698818f,  0.024541229f }, {  1.000000000f,  0.000000000f }, {  0.999698818f, -0.024541229f },
+    {  0.998795450f, -0.049067676f }, {  0.997290432f, -0.073564567f }, {  0.995184720f, -0.098017141f },
+    {  0.992479563f, -0.122410677f }, {  0.989176512f, -0.146730468f }, {  0.985277653f, -0.170961887f },
+    {  0.980785251f, -0.195090324f }, {  0.975702107f, -0.219101235f }, {  0.970031261f, -0.242980182f },
+    {  0.963776052f, -0.266712755f }, {  0.956940353f, -0.290284663f }, {  0.949528158f, -0.313681751f },
+    {  0.941544056f, -0.336889863f }, {  0.932992816f, -0.359895051f }, {  0.923879504f, -0.382683426f },
+    {  0.914209783f, -0.405241311f }, {  0.903989315f, -0.427555084f }, {  0.893224299f, -0.449611336f },
+    {  0.881921291f, -0.471396744f }, {  0.870086968f, -0.492898196f }, {  0.857728601f, -0.514102757f },
+    {  0.844853580f, -0.534997642f }, {  0.831469595f, -0.555570245f }, {  0.817584813f, -0.575808167f },
+    {  0.803207517f, -0.595699310f }, {  0.788346410f, -0.615231574f }, {  0.773010433f, -0.634393275f },
+    {  0.757208824f, -0.653172851f }, {  0.740951121f, -0.671558976f }, {  0.724247098f, -0.689540565f },
+    {  0.707106769f, -0.707106769f }, {  0.689540565f, -0.724247098f }, {  0.671558976f, -0.740951121f },
+    {  0.653172851f, -0.757208824f }, {  0.634393275f, -0.773010433f }, {  0.615231574f, -0.788346410f },
+    {  0.595699310f, -0.803207517f }, {  0.575808167f, -0.817584813f }, {  0.555570245f, -0.831469595f },
+    {  0.534997642f, -0.844853580f }, {  0.514102757f, -0.857728601f }, {  0.492898196f, -0.870086968f },
+    {  0.471396744f, -0.881921291f }, {  0.449611336f, -0.893224299f }, {  0.427555084f, -0.903989315f },
+    {  0.405241311f, -0.914209783f }, {  0.382683426f, -0.923879504f }, {  0.359895051f, -0.932992816f },
+    {  0.336889863f, -0.941544056f }, {  0.313681751f, -0.949528158f }, {  0.290284663f, -0.956940353f },
+    {  0.266712755f, -0.963776052f }, {  0.242980182f, -0.970031261f }, {  0.219101235f, -0.975702107f },
+    {  0.195090324f, -0.980785251f }, {  0.170961887f, -0.985277653f }, {  0.146730468f, -0.989176512f },
+    {  0.122410677f, -0.992479563f }, {  0.098017141f, -0.995184720f }, {  0.073564567f, -0.997290432f },
+    {  0.049067676f, -0.998795450f }, {  0.024541229f, -0.999698818f }, {  0.000000000f, -1.000000000f },
+    { -0.024541229f, -0.999698818f }, { -0.049067676f, -0.998795450f }, { -0.073564567f, -0.997290432f },
+    { -0.098017141f, -0.995184720f }, { -0.122410677f, -0.992479563f }, { -0.146730468f, -0.989176512f },
+    { -0.170961887f, -0.985277653f }, { -0.195090324f, -0.980785251f }, { -0.219101235f, -0.975702107f },
+    { -0.242980182f, -0.970031261f }, { -0.266712755f, -0.963776052f }, { -0.290284663f, -0.956940353f },
+    { -0.313681751f, -0.949528158f }, { -0.336889863f, -0.941544056f }, { -0.359895051f, -0.932992816f },
+    { -0.382683426f, -0.923879504f }, { -0.405241311f, -0.914209783f }, { -0.427555084f, -0.903989315f },
+    { -0.449611336f, -0.893224299f }, { -0.471396744f, -0.881921291f }, { -0.492898196f, -0.870086968f },
+    { -0.514102757f, -0.857728601f }, { -0.534997642f, -0.844853580f }, { -0.555570245f, -0.831469595f },
+    { -0.575808167f, -0.817584813f }, { -0.595699310f, -0.803207517f }, { -0.615231574f, -0.788346410f },
+    { -0.634393275f, -0.773010433f }, { -0.653172851f, -0.757208824f }, { -0.671558976f, -0.740951121f },
+    { -0.689540565f, -0.724247098f }, { -0.707106769f, -0.707106769f }, { -0.724247098f, -0.689540565f },
+    { -0.740951121f, -0.671558976f }, { -0.757208824f, -0.653172851f }, { -0.773010433f, -0.634393275f },
+    { -0.788346410f, -0.615231574f }, { -0.803207517f, -0.595699310f }, { -0.817584813f, -0.575808167f },
+    { -0.831469595f, -0.555570245f }, { -0.844853580f, -0.534997642f }, { -0.857728601f, -0.514102757f },
+    { -0.870086968f, -0.492898196f }, { -0.881921291f, -0.471396744f }, { -0.893224299f, -0.449611336f },
+    { -0.903989315f, -0.427555084f }, { -0.914209783f, -0.405241311f }, { -0.923879504f, -0.382683426f },
+    { -0.932992816f, -0.359895051f }, { -0.941544056f, -0.336889863f }, { -0.949528158f, -0.313681751f },
+    { -0.956940353f, -0.290284663f }, { -0.963776052f, -0.266712755f }, { -0.970031261f, -0.242980182f },
+    { -0.975702107f, -0.219101235f }, { -0.980785251f, -0.195090324f }, { -0.985277653f, -0.170961887f },
+    { -0.989176512f, -0.146730468f }, { -0.992479563f, -0.122410677f }, { -0.995184720f, -0.098017141f },
+    { -0.997290432f, -0.073564567f }, { -0.998795450f, -0.049067676f }, { -0.999698818f, -0.024541229f },
+    { -1.000000000f,  0.000000000f }, { -0.999698818f,  0.024541229f }, { -0.998795450f,  0.049067676f },
+    { -0.997290432f,  0.073564567f }, { -0.995184720f,  0.098017141f }, { -0.992479563f,  0.122410677f },
+    { -0.989176512f,  0.146730468f }, { -0.985277653f,  0.170961887f }, { -0.980785251f,  0.195090324f },
+    { -0.975702107f,  0.219101235f }, { -0.970031261f,  0.242980182f }, { -0.963776052f,  0.266712755f },
+    { -0.956940353f,  0.290284663f }, { -0.949528158f,  0.313681751f }, { -0.941544056f,  0.336889863f },
+    { -0.932992816f,  0.359895051f }, { -0.923879504f,  0.382683426f }, { -0.914209783f,  0.405241311f },
+    { -0.903989315f,  0.427555084f }, { -0.893224299f,  0.449611336f }, { -0.881921291f,  0.471396744f },
+    { -0.870086968f,  0.492898196f }, { -0.857728601f,  0.514102757f }, { -0.844853580f,  0.534997642f },
+    { -0.831469595f,  0.555570245f }, { -0.817584813f,  0.575808167f }, { -0.803207517f,  0.595699310f },
+    { -0.788346410f,  0.615231574f }, { -0.773010433f,  0.634393275f }, { -0.757208824f,  0.653172851f },
+    { -0.740951121f,  0.671558976f }, { -0.724247098f,  0.689540565f }, { -0.707106769f,  0.707106769f },
+    { -0.689540565f,  0.724247098f }, { -0.671558976f,  0.740951121f }, { -0.653172851f,  0.757208824f },
+    { -0.634393275f,  0.773010433f }, { -0.615231574f,  0.788346410f }, { -0.595699310f,  0.803207517f },
+    { -0.575808167f,  0.817584813f }, { -0.555570245f,  0.831469595f }, { -0.534997642f,  0.844853580f },
+    { -0.514102757f,  0.857728601f }, { -0.492898196f,  0.870086968f }, { -0.471396744f,  0.881921291f },
+    { -0.449611336f,  0.893224299f }, { -0.427555084f,  0.903989315f }, { -0.405241311f,  0.914209783f },
+    { -0.382683426f,  0.923879504f }, { -0.359895051f,  0.932992816f }, { -0.336889863f,  0.941544056f },
+    { -0.313681751f,  0.949528158f }, { -0.290284663f,  0.956940353f }, { -0.266712755f,  0.963776052f },
+    { -0.242980182f,  0.970031261f }, { -0.219101235f,  0.975702107f }, { -0.195090324f,  0.980785251f },
+    { -0.170961887f,  0.985277653f }, { -0.146730468f,  0.989176512f }, { -0.122410677f,  0.992479563f },
+    { -0.098017141f,  0.995184720f }, { -0.073564567f,  0.997290432f }, { -0.049067676f,  0.998795450f },
+    { -0.024541229f,  0.999698818f },
+};
+
+inline u32 get_circle_segment_count(Transform2D* transform, f32 radius) {
+    // @Note: A chord of angle a is off the circle by about radius*a^2/8 in the middle
+    f32 pixel_radius = abs(radius)*max(abs(transform->scale.x), abs(transform->scale.y));
+    f32 wanted_segment_count = TAU_32*square_root(0.5f*pixel_radius);
+
+    u32 result = CIRCLE_MIN_SEGMENT_COUNT;
+    while (result < CIRCLE_TABLE_SEGMENT_COUNT && cast(f32) result < wanted_segment_count) {
+        result *= 2;
+    }
+    return result;
+}
+
+// @Note: Point segment_index of a circle shape cut into segment_count segments, which comes back around to the first one
+// at segment_count
+inline v2 get_circle_shape_point(Transform2D* transform, f32 radius, u32 segment_index, u32 segment_count) {
+    u32 table_index = (segment_index*(CIRCLE_TABLE_SEGMENT_COUNT / segment_count)) & (CIRCLE_TABLE_SEGMENT_COUNT - 1);
+    v2 point = transform->scale*unit_circle_points[table_index]*radius;
+    v2 result = rotate(point, transform->rotation_arm) + transform->offset;
+    return result;
+}
+
+// @Note: The corners of a rectangle shape, pushed out by half the line width when it gets outlined with thick lines
+inline void get_rectangle_corners(Transform2D* transform, AxisAlignedBox2 aab, ShapeRenderMode render_mode, f32 line_width, v2* p00, v2* p10, v2* p11, v2* p01) {
+    v2 x_axis = transform->rotation_arm*transform->scale;
+    v2 y_axis = perp(x_axis);
+
+    v2 a, b, c, d;
+    if (render_mode == ShapeRenderMode_Outline && line_width > 1.0f) {
+        v2 x_adjust = -0.5f*normalize_or_zero(x_axis)*line_width;
+        v2 y_adjust = -0.5f*normalize_or_zero(y_axis)*line_width;
+
+        // @Robustness: x_adjust and y_adjust here boldly assume the aab contains its origin!!
+        a = x_axis*corner_a(aab).x - x_adjust + y_axis*corner_a(aab).y - y_adjust;
+        b = x_axis*corner_b(aab).x + x_adjust + y_axis*corner_b(aab).y - y_adjust;
+        c = x_axis*corner_c(aab).x + x_adjust + y_axis*corner_c(aab).y + y_adjust;
+        d = x_axis*corner_d(aab).x - x_adjust + y_axis*corner_d(aab).y + y_adjust;
+    } else {
+        a = x_axis*corner_a(aab).x + y_axis*corner_a(aab).y;
+        b = x_axis*corner_b(aab).x + y_axis*corner_b(aab).y;
+        c = x_axis*corner_c(aab).x + y_axis*corner_c(aab).y;
+        d = x_axis*corner_d(aab).x + y_axis*corner_d(aab).y;
+    }
+
+    *p00 = transform->offset + a;
+    *p10 = transform->offset + b;
+    *p11 = transform->offset + c;
+    *p01 = transform->offset + d;
+}
+
+// @Note: One rectangle of a RenderCommandRectBatch, relative to the batch's origin. The color is already transformed
+// like the colors of the push functions come out.
+struct RenderRect {
+    AxisAlignedBox2 aab;
+    v4 color;
+    ShapeRenderMode render_mode;
 };
 
+// @Note: A batch of rectangles that gets drawn like as many rectangle shapes with the batch's transform. The rects aren't
+// in the frame arena, they belong to whoever baked them and have to stay put until the frame is rendered.
+struct RenderCommandRectBatch {
+    Transform2D transform;
+    u32 rect_count;
+    RenderRect* rects;
+};
+
+// @Note: Draws the part of the image between min_uv and max_uv as if it were an image of its own, dim texels big and
+// aligned by align. For a whole image that's just its own size and align, for a glyph it's its rect in the font atlas.
 struct RenderCommandImage {
     Transform2D transform;
     Image* image;
     v4 color;
+    v2 dim;
+    v2 align;
+    v2 min_uv;
+    v2 max_uv;
 };
 
 struct RenderCommandParticleSystem {
@@ -74,4 +261,47 @@ struct RenderCommandParticleSystem {
     ParticleSystem* system;
 };
 
+struct RenderGlyph {
+    u32 glyph_index; // @Note: Into the run's glyph_table, so codepoint - first_codepoint
+    f32 x; // @Note: Along the run from its origin, in world units
+};
+
+// @Note: A line of text in one of a font's atlas pages, which the backends turn into an image per glyph. Any shadow is
+// drawn under all of the run's glyphs before the glyphs themselves. The glyph table is the font's, so it lives in the
+// asset data, and the glyphs live in the frame arena.
+struct RenderCommandGlyphRun {
+    Transform2D transform;
+    Image* atlas_page;
+    PackedGlyph* glyph_table;
+    v4 color;
+    v4 shadow_color; // @Note: No shadow if it's fully transparent
+    v2 shadow_offset; // @Note: In world units, like the glyphs' x
+    u32 glyph_count;
+    RenderGlyph* glyphs;
+};
+
+// @Note: The image command a glyph of a run would have been, so the backends can draw glyphs like any other image
+inline RenderCommandImage get_glyph_run_image(RenderCommandGlyphRun* run, RenderGlyph glyph, b32 shadow) {
+    PackedGlyph* packed = run->glyph_table + glyph.glyph_index;
+
+    v2 x_axis = run->transform.rotation_arm*run->transform.scale;
+    v2 y_axis = perp(x_axis);
+    v2 glyph_offset = vec2(glyph.x, 0.0f);
+    if (shadow) {
+        glyph_offset += run->shadow_offset;
+    }
+
+    RenderCommandImage result;
+    result.transform = run->transform;
+    result.transform.offset += x_axis*glyph_offset.x + y_axis*glyph_offset.y;
+    result.transform.scale *= run->atlas_page->scale;
+    result.image = run->atlas_page;
+    result.color = shadow ? run->shadow_color : run->color;
+    result.dim = vec2(packed->w, packed->h);
+    result.align = packed->align;
+    result.min_uv = packed->min_uv;
+    result.max_uv = packed->max_uv;
+    return result;
+}
+
 #endif /* RENDER_COMMANDS_H */
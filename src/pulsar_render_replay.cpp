@@ -0,0 +1,612 @@
+#include <windows.h>
+#include <gl/gl.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <assert.h>
+
+#define STB_SPRINTF_STATIC 1
+#define STB_SPRINTF_IMPLEMENTATION 1
+#include "external/stb_sprintf.h"
+
+#include "pulsar_common.h"
+#include "pulsar_platform_bridge.h"
+
+#include "pulsar_opengl.h"
+#include "win32_opengl.h"
+
+#include "pulsar_sort.cpp"
+
+#include "pulsar_shapes.h"
+#include "pulsar_render_commands.h"
+#include "pulsar_render_capture.h"
+#include "pulsar_software_renderer.h"
+
+#include "pulsar_opengl.cpp"
+#include "win32_opengl.cpp"
+#include "pulsar_software_renderer.cpp"
+
+// @Note: Plays the frames of a render capture (see pulsar_render_capture.h) through the renderers in a tight loop, with
+// nothing else going on, and reports how long every frame took and how long every type of render command took across
+// all of them. The images and fonts come out of the asset pack the capture was made with.
+// The GL backends render into a window of their own and call glFinish at the end of every frame, so their times are
+// wall clock times for the CPU and GPU work together. The per command type times render each type on its own, so they
+// don't add up to the frame times: every pass has its own fixed cost, and overdraw between types isn't there.
+//
+// Usage: pulsar_render_replay [capture.prc] [-assets assets.pla] [-backend all|software|gl|gl_shader] [-loops n] [-threads n]
+
+#define REPLAY_DEFAULT_LOOPS 10
+#define REPLAY_COMMAND_TYPE_COUNT (RenderCommand_GlyphRun + 1)
+
+global char* replay_command_type_names[REPLAY_COMMAND_TYPE_COUNT] = {
+    "Clear",
+    "RectBatch",
+    "Shape",
+    "Image",
+    "ParticleSystem",
+    "GlyphRun",
+};
+
+global s64 perf_count_frequency;
+
+inline LARGE_INTEGER win32_get_clock() {
+    LARGE_INTEGER result;
+    QueryPerformanceCounter(&result);
+    return result;
+}
+
+inline f64 win32_get_seconds_elapsed(LARGE_INTEGER start, LARGE_INTEGER end) {
+    f64 result = cast(f64) (end.QuadPart - start.QuadPart) / cast(f64) perf_count_frequency;
+    return result;
+}
+
+inline void win32_initialize_perf_counter() {
+    LARGE_INTEGER perf_count_frequency_result;
+    QueryPerformanceFrequency(&perf_count_frequency_result);
+    perf_count_frequency = perf_count_frequency_result.QuadPart;
+}
+
+internal EntireFile replay_read_entire_file(char* file_name) {
+    EntireFile result = {};
+
+    FILE* file = fopen(file_name, "rb");
+    if (file) {
+        fseek(file, 0, SEEK_END);
+        long file_size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        if (file_size > 0) {
+            // @Note: The frames get restored in place, and the structs in them want their natural alignment
+            void* data = _aligned_malloc(cast(size_t) file_size, 64);
+            if (data && fread(data, cast(size_t) file_size, 1, file) == 1) {
+                result.size = cast(size_t) file_size;
+                result.data = data;
+            } else if (data) {
+                _aligned_free(data);
+            }
+        }
+
+        fclose(file);
+    }
+
+    return result;
+}
+
+//
+// Capture
+//
+
+struct ReplayFrame {
+    GameRenderCommands commands;
+
+    // @Note: The same frame with only the commands of one type in it, for timing the types on their own
+    u32 command_type_counts[REPLAY_COMMAND_TYPE_COUNT];
+    GameRenderCommands commands_by_type[REPLAY_COMMAND_TYPE_COUNT];
+};
+
+// @Note: Pulls the images and glyph tables out of an asset pack, without going through load_assets, which wants the
+// game's platform
+internal b32 load_replay_assets(RenderCaptureAssets* assets, char* file_name) {
+    EntireFile file = replay_read_entire_file(file_name);
+    if (file.size < sizeof(AssetPackHeader)) {
+        fprintf(stderr, "Could not read the asset pack '%s'\n", file_name);
+        return false;
+    }
+
+    AssetPackHeader* header = cast(AssetPackHeader*) file.data;
+    if (header->magic_value != ASSET_PACK_CODE('p', 'l', 'a', 'f') || header->version != ASSET_PACK_VERSION) {
+        fprintf(stderr, "'%s' is not an asset pack this build understands\n", file_name);
+        return false;
+    }
+
+    PackedAsset* catalog = cast(PackedAsset*) (cast(u8*) header + header->asset_catalog);
+    u8* asset_data = cast(u8*) header + header->asset_data;
+
+    assets->asset_count = header->asset_count;
+    assets->images = cast(Image**) calloc(header->asset_count, sizeof(Image*));
+    assets->glyph_tables = cast(PackedGlyph**) calloc(header->asset_count, sizeof(PackedGlyph*));
+    assets->glyph_counts = cast(u32*) calloc(header->asset_count, sizeof(u32));
+    Image* image_storage = cast(Image*) calloc(header->asset_count, sizeof(Image));
+
+    for (u32 asset_index = 0; asset_index < header->asset_count; asset_index++) {
+        PackedAsset* asset = catalog + asset_index;
+        if (asset->type == AssetType_Image) {
+            Image* image = image_storage + asset_index;
+            image->packed_image = asset->image;
+            image->pixels = asset_data + asset->data_offset;
+            assets->images[asset_index] = image;
+        } else if (asset->type == AssetType_Font) {
+            // @Note: Laid out like load_assets does it, the atlas page ids come before the glyph table
+            ImageID* atlas_pages = cast(ImageID*) (asset_data + asset->data_offset);
+            assets->glyph_tables[asset_index] = cast(PackedGlyph*) (atlas_pages + asset->font.atlas_page_count);
+            assets->glyph_counts[asset_index] = asset->font.one_past_last_codepoint - asset->font.first_codepoint;
+        }
+    }
+
+    return true;
+}
+
+// @Note: Makes a copy of the frame's command buffer with only the commands of one type in it. The commands are copied
+// whole and stay where they were, only the sort entries get filtered and rebased.
+internal u32 filter_replay_frame(GameRenderCommands* source, u8 type, GameRenderCommands* dest) {
+    SortEntry* source_entries = cast(SortEntry*) source->command_buffer;
+
+    u32 entry_count = 0;
+    for (u32 entry_index = 0; entry_index < source->sort_entry_count; entry_index++) {
+        RenderCommandHeader* header = cast(RenderCommandHeader*) (source->command_buffer + source_entries[entry_index].index);
+        entry_count += (header->type == type);
+    }
+
+    u32 command_size = source->command_buffer_size - source->first_command;
+    u32 entries_size = cast(u32) sizeof(SortEntry)*entry_count;
+
+    *dest = *source;
+    dest->sort_entry_count = entry_count;
+    dest->first_command = entries_size;
+    dest->command_buffer_size = entries_size + command_size;
+    dest->command_buffer = cast(u8*) _aligned_malloc(dest->command_buffer_size, 64);
+
+    copy(command_size, source->command_buffer + source->first_command, dest->command_buffer + entries_size);
+
+    SortEntry* dest_entries = cast(SortEntry*) dest->command_buffer;
+    u32 dest_entry_index = 0;
+    for (u32 entry_index = 0; entry_index < source->sort_entry_count; entry_index++) {
+        SortEntry entry = source_entries[entry_index];
+        RenderCommandHeader* header = cast(RenderCommandHeader*) (source->command_buffer + entry.index);
+        if (header->type == type) {
+            entry.index = entry.index - source->first_command + entries_size;
+            dest_entries[dest_entry_index++] = entry;
+        }
+    }
+
+    return entry_count;
+}
+
+internal ReplayFrame* load_render_capture(char* file_name, RenderCaptureAssets* assets, u32* out_frame_count) {
+    EntireFile file = replay_read_entire_file(file_name);
+    if (file.size < sizeof(RenderCaptureHeader)) {
+        fprintf(stderr, "Could not read the render capture '%s'\n", file_name);
+        return 0;
+    }
+
+    RenderCaptureHeader* header = cast(RenderCaptureHeader*) file.data;
+    if (header->magic_value != ASSET_PACK_CODE('p', 'r', 'c', 'f') || header->version != RENDER_CAPTURE_VERSION) {
+        fprintf(stderr, "'%s' is not a render capture this build understands\n", file_name);
+        return 0;
+    }
+
+    if (header->asset_count != assets->asset_count) {
+        fprintf(stderr, "Warning: '%s' was captured with %u assets, but the asset pack has %u. Images and text may come out wrong.\n", file_name, header->asset_count, assets->asset_count);
+    }
+
+    ReplayFrame* frames = cast(ReplayFrame*) calloc(MAX(1, header->frame_count), sizeof(ReplayFrame));
+
+    u8* at = cast(u8*) (header + 1);
+    u8* end = cast(u8*) file.data + file.size;
+    for (u32 frame_index = 0; frame_index < header->frame_count; frame_index++) {
+        RenderCaptureFrame* capture_frame = cast(RenderCaptureFrame*) at;
+        if (cast(size_t) (end - at) < sizeof(RenderCaptureFrame) || cast(size_t) (end - at) < get_render_capture_frame_size(capture_frame)) {
+            fprintf(stderr, "'%s' ends in the middle of frame %u\n", file_name, frame_index);
+            return 0;
+        }
+        at += get_render_capture_frame_size(capture_frame);
+
+        ReplayFrame* frame = frames + frame_index;
+        if (!restore_render_capture_frame(capture_frame, &frame->commands, assets)) {
+            fprintf(stderr, "Frame %u of '%s' is corrupt\n", frame_index, file_name);
+            return 0;
+        }
+
+        // @Note: The capture has the commands in push order, sort them once up front like the platform would every frame
+        SortEntry* sort_temp_space = cast(SortEntry*) malloc(sizeof(SortEntry)*MAX(1, frame->commands.sort_entry_count));
+        sort_entries(frame->commands.sort_entry_count, cast(SortEntry*) frame->commands.command_buffer, sort_temp_space);
+        free(sort_temp_space);
+
+        for (u8 type = 0; type < REPLAY_COMMAND_TYPE_COUNT; type++) {
+            frame->command_type_counts[type] = filter_replay_frame(&frame->commands, type, frame->commands_by_type + type);
+        }
+    }
+
+    *out_frame_count = header->frame_count;
+    return frames;
+}
+
+//
+// Backends
+//
+
+enum ReplayBackend {
+    ReplayBackend_Software,
+    ReplayBackend_FixedFunction,
+    ReplayBackend_Shader,
+
+    ReplayBackend_Count,
+};
+
+global char* replay_backend_names[ReplayBackend_Count] = {
+    "software",
+    "gl",
+    "gl_shader",
+};
+
+struct ReplayWorkers {
+    SoftwareRenderer* renderer;
+    HANDLE semaphore;
+    u32 worker_count;
+    u32 volatile workers_finished;
+};
+
+struct ReplayRenderer {
+    ReplayBackend backend;
+
+    // @Note: Software
+    SoftwareRenderer software_renderer;
+    SoftwareFramebuffer framebuffer;
+    MemoryArena arena;
+    ReplayWorkers* workers;
+
+    // @Note: GL
+    HWND window;
+    HDC window_dc;
+    HGLRC glrc;
+    WglInfo wgl_info;
+    OpenGLInfo opengl_info;
+};
+
+internal DWORD WINAPI replay_worker_thread_proc(LPVOID parameter) {
+    ReplayWorkers* workers = cast(ReplayWorkers*) parameter;
+    for (;;) {
+        WaitForSingleObject(workers->semaphore, INFINITE);
+        software_render_tiles(workers->renderer);
+        atomic_add_u32(&workers->workers_finished, 1);
+    }
+}
+
+internal b32 begin_replay_renderer(ReplayRenderer* renderer, ReplayBackend backend, ReplayWorkers* workers, RenderCaptureAssets* assets, u32 max_width, u32 max_height) {
+    zero_struct(*renderer);
+    renderer->backend = backend;
+
+    if (backend == ReplayBackend_Software) {
+        renderer->workers = workers;
+        workers->renderer = &renderer->software_renderer;
+
+        renderer->framebuffer.width = max_width;
+        renderer->framebuffer.height = max_height;
+        renderer->framebuffer.pitch = max_width;
+        renderer->framebuffer.pixels = cast(u32*) _aligned_malloc(sizeof(u32)*max_width*max_height, 64);
+
+        size_t arena_size = MEGABYTES(512);
+        initialize_arena(&renderer->arena, arena_size, _aligned_malloc(arena_size, 64));
+
+        for (u32 image_index = 0; image_index < assets->asset_count; image_index++) {
+            if (assets->images[image_index]) {
+                assets->images[image_index]->handle = 0;
+            }
+        }
+
+        return true;
+    }
+
+    RECT window_rect = { 0, 0, cast(LONG) max_width, cast(LONG) max_height };
+    AdjustWindowRect(&window_rect, WS_OVERLAPPEDWINDOW, FALSE);
+
+    // @Note: The window gets shown, pixels that fail the ownership test of a hidden window can get skipped by the driver
+    renderer->window = CreateWindowA(
+        "PulsarReplayWindowClass",
+        replay_backend_names[backend],
+        WS_OVERLAPPEDWINDOW|WS_VISIBLE,
+        CW_USEDEFAULT, CW_USEDEFAULT,
+        window_rect.right - window_rect.left, window_rect.bottom - window_rect.top,
+        NULL, NULL,
+        GetModuleHandleA(0),
+        NULL
+    );
+    if (!renderer->window) {
+        fprintf(stderr, "Could not create a window for %s\n", replay_backend_names[backend]);
+        return false;
+    }
+
+    renderer->window_dc = GetDC(renderer->window);
+    renderer->glrc = wgl_opengl_init(renderer->window_dc, &renderer->wgl_info, &renderer->opengl_info, 0, backend == ReplayBackend_Shader);
+    if (wglSwapIntervalEXT) {
+        wglSwapIntervalEXT(0);
+    }
+
+    if (backend == ReplayBackend_Shader && !renderer->opengl_info.shader_path) {
+        fprintf(stderr, "Skipping %s: %s\n", replay_backend_names[backend], renderer->opengl_info.shader_log[0] ? renderer->opengl_info.shader_log : "No GL 3.3 core context");
+        wglMakeCurrent(0, 0);
+        wglDeleteContext(renderer->glrc);
+        DestroyWindow(renderer->window);
+        return false;
+    }
+
+    for (u32 image_index = 0; image_index < assets->asset_count; image_index++) {
+        Image* image = assets->images[image_index];
+        if (image) {
+            image->handle = cast(void*) cast(size_t) opengl_load_texture(&renderer->opengl_info, image->w, image->h, image->pixels);
+        }
+    }
+    Image* missing_image = assets->missing_image;
+    missing_image->handle = cast(void*) cast(size_t) opengl_load_texture(&renderer->opengl_info, missing_image->w, missing_image->h, missing_image->pixels);
+
+    return true;
+}
+
+internal void end_replay_renderer(ReplayRenderer* renderer) {
+    if (renderer->backend == ReplayBackend_Software) {
+        _aligned_free(renderer->framebuffer.pixels);
+        _aligned_free(renderer->arena.base_ptr);
+    } else {
+        // @Note: The textures go with the context
+        wglMakeCurrent(0, 0);
+        wglDeleteContext(renderer->glrc);
+        ReleaseDC(renderer->window, renderer->window_dc);
+        DestroyWindow(renderer->window);
+    }
+}
+
+// @Note: Returns once the frame is completely done, not just submitted
+internal void replay_render(ReplayRenderer* renderer, GameRenderCommands* commands) {
+    if (renderer->backend == ReplayBackend_Software) {
+        ReplayWorkers* workers = renderer->workers;
+
+        SoftwareFramebuffer framebuffer = renderer->framebuffer;
+        framebuffer.width = commands->width;
+        framebuffer.height = commands->height;
+
+        TemporaryMemory temp = begin_temporary_memory(&renderer->arena);
+        software_begin_render(&renderer->software_renderer, framebuffer, commands, &renderer->arena);
+
+        workers->workers_finished = 0;
+        if (workers->worker_count) {
+            ReleaseSemaphore(workers->semaphore, workers->worker_count, 0);
+        }
+
+        software_render_tiles(&renderer->software_renderer);
+        while (!software_render_is_done(&renderer->software_renderer) || workers->workers_finished != workers->worker_count) {
+            _mm_pause();
+        }
+
+        end_temporary_memory(temp);
+    } else {
+        opengl_render_commands(&renderer->opengl_info, commands);
+        glFinish();
+
+        MSG message;
+        while (PeekMessageA(&message, 0, 0, 0, PM_REMOVE)) {
+            DispatchMessageA(&message);
+        }
+    }
+}
+
+//
+// Timing
+//
+
+internal void replay_backend(ReplayRenderer* renderer, u32 frame_count, ReplayFrame* frames, u32 loop_count) {
+    // @Note: One untimed pass first, so uploads, allocations and caches don't land on the first loop
+    for (u32 frame_index = 0; frame_index < frame_count; frame_index++) {
+        replay_render(renderer, &frames[frame_index].commands);
+    }
+
+    f64* best_seconds = cast(f64*) malloc(sizeof(f64)*frame_count);
+    f64* total_seconds = cast(f64*) calloc(frame_count, sizeof(f64));
+    for (u32 frame_index = 0; frame_index < frame_count; frame_index++) {
+        best_seconds[frame_index] = DBL_MAX;
+    }
+
+    for (u32 loop = 0; loop < loop_count; loop++) {
+        for (u32 frame_index = 0; frame_index < frame_count; frame_index++) {
+            LARGE_INTEGER start = win32_get_clock();
+            replay_render(renderer, &frames[frame_index].commands);
+            LARGE_INTEGER end = win32_get_clock();
+
+            f64 seconds = win32_get_seconds_elapsed(start, end);
+            best_seconds[frame_index] = MIN(best_seconds[frame_index], seconds);
+            total_seconds[frame_index] += seconds;
+        }
+    }
+
+    fprintf(stdout, "\n%s, milliseconds per frame over %u loops\n\n", replay_backend_names[renderer->backend], loop_count);
+    fprintf(stdout, "%8s%12s%12s%10s%10s\n", "frame", "size", "commands", "best", "mean");
+
+    f64 best_sum = 0.0;
+    f64 mean_sum = 0.0;
+    f64 worst_mean = 0.0;
+    for (u32 frame_index = 0; frame_index < frame_count; frame_index++) {
+        GameRenderCommands* commands = &frames[frame_index].commands;
+        f64 mean_seconds = total_seconds[frame_index] / cast(f64) loop_count;
+
+        char size[32];
+        stbsp_snprintf(size, sizeof(size), "%ux%u", commands->width, commands->height);
+        fprintf(stdout, "%8u%12s%12u%10.3f%10.3f\n", frame_index, size, commands->sort_entry_count, 1000.0*best_seconds[frame_index], 1000.0*mean_seconds);
+
+        best_sum += best_seconds[frame_index];
+        mean_sum += mean_seconds;
+        worst_mean = MAX(worst_mean, mean_seconds);
+    }
+
+    fprintf(stdout, "%8s%12s%12s%10.3f%10.3f  (worst mean %.3f)\n", "average", "", "", 1000.0*best_sum / frame_count, 1000.0*mean_sum / frame_count, 1000.0*worst_mean);
+
+    fprintf(stdout, "\n%s, milliseconds per frame by command type, each type rendered on its own\n\n", replay_backend_names[renderer->backend]);
+    fprintf(stdout, "%16s%12s%10s%10s\n", "type", "commands", "mean", "us/cmd");
+
+    for (u8 type = 0; type < REPLAY_COMMAND_TYPE_COUNT; type++) {
+        u64 command_count = 0;
+        for (u32 frame_index = 0; frame_index < frame_count; frame_index++) {
+            command_count += frames[frame_index].command_type_counts[type];
+        }
+
+        if (!command_count) {
+            continue;
+        }
+
+        f64 type_seconds = 0.0;
+        for (u32 loop = 0; loop < loop_count; loop++) {
+            for (u32 frame_index = 0; frame_index < frame_count; frame_index++) {
+                LARGE_INTEGER start = win32_get_clock();
+                replay_render(renderer, &frames[frame_index].commands_by_type[type]);
+                LARGE_INTEGER end = win32_get_clock();
+                type_seconds += win32_get_seconds_elapsed(start, end);
+            }
+        }
+
+        f64 mean_seconds = type_seconds / cast(f64) (loop_count*frame_count);
+        f64 commands_per_frame = cast(f64) command_count / cast(f64) frame_count;
+        fprintf(stdout, "%16s%12.1f%10.3f%10.3f\n", replay_command_type_names[type], commands_per_frame, 1000.0*mean_seconds, 1000000.0*mean_seconds / commands_per_frame);
+    }
+
+    free(best_seconds);
+    free(total_seconds);
+}
+
+int main(int argument_count, char** arguments) {
+    win32_initialize_perf_counter();
+    initialize_memory_kernels();
+    initialize_software_span_kernels();
+
+    char* capture_file_name = RENDER_CAPTURE_FILE_NAME;
+    char* asset_file_name = "assets.pla";
+    u32 backend_mask = (1 << ReplayBackend_Count) - 1;
+    u32 loop_count = REPLAY_DEFAULT_LOOPS;
+    u32 thread_count = 0;
+
+    for (int argument_index = 1; argument_index < argument_count; argument_index++) {
+        String argument = wrap_cstr(arguments[argument_index]);
+        b32 has_value = argument_index + 1 < argument_count;
+        if (argument.len && argument.data[0] != '-') {
+            capture_file_name = arguments[argument_index];
+        } else if (has_value && strings_are_equal(argument, string_literal("-assets"))) {
+            asset_file_name = arguments[++argument_index];
+        } else if (has_value && strings_are_equal(argument, string_literal("-backend"))) {
+            String backend_name = wrap_cstr(arguments[++argument_index]);
+            backend_mask = 0;
+            for (u32 backend = 0; backend < ReplayBackend_Count; backend++) {
+                if (strings_are_equal(backend_name, string_literal("all")) || strings_are_equal(backend_name, wrap_cstr(replay_backend_names[backend]))) {
+                    backend_mask |= 1 << backend;
+                }
+            }
+            if (!backend_mask) {
+                fprintf(stderr, "Unknown backend '%s', expected all, software, gl or gl_shader\n", backend_name.data);
+                return 1;
+            }
+        } else if (has_value && strings_are_equal(argument, string_literal("-loops"))) {
+            loop_count = cast(u32) atoi(arguments[++argument_index]);
+            loop_count = MAX(1, loop_count);
+        } else if (has_value && strings_are_equal(argument, string_literal("-threads"))) {
+            thread_count = cast(u32) atoi(arguments[++argument_index]);
+        } else {
+            fprintf(stderr, "Unknown argument '%s'\n", arguments[argument_index]);
+            return 1;
+        }
+    }
+
+    // @Note: Magenta, so images that didn't make it are easy to spot
+    u32 missing_texel = 0xFFFF00FF;
+    Image missing_image = {};
+    missing_image.w = 1;
+    missing_image.h = 1;
+    missing_image.align = vec2(0.5f, 0.5f);
+    missing_image.scale = vec2(1, 1);
+    missing_image.pixel_format = PixelFormat_BGRA8;
+    missing_image.pixels = &missing_texel;
+
+    RenderCaptureAssets assets = {};
+    assets.missing_image = &missing_image;
+    if (!load_replay_assets(&assets, asset_file_name)) {
+        fprintf(stderr, "Images will show up as missing, and text won't show up at all\n");
+    }
+
+    u32 frame_count = 0;
+    ReplayFrame* frames = load_render_capture(capture_file_name, &assets, &frame_count);
+    if (!frames) {
+        return 1;
+    }
+    if (!frame_count) {
+        fprintf(stderr, "'%s' has no frames in it\n", capture_file_name);
+        return 1;
+    }
+
+    u32 max_width = 1;
+    u32 max_height = 1;
+    u64 command_count = 0;
+    for (u32 frame_index = 0; frame_index < frame_count; frame_index++) {
+        max_width = MAX(max_width, frames[frame_index].commands.width);
+        max_height = MAX(max_height, frames[frame_index].commands.height);
+        command_count += frames[frame_index].commands.sort_entry_count;
+    }
+
+    fprintf(stdout, "'%s': %u frames, up to %ux%u, %.1f render commands per frame\n", capture_file_name, frame_count, max_width, max_height, cast(f64) command_count / cast(f64) frame_count);
+
+    if (backend_mask & (1 << ReplayBackend_Software)) {
+        SYSTEM_INFO system_info;
+        GetSystemInfo(&system_info);
+        if (!thread_count) {
+            thread_count = MAX(1, cast(u32) system_info.dwNumberOfProcessors);
+        }
+    }
+
+    ReplayWorkers workers = {};
+    if (thread_count > 1) {
+        workers.semaphore = CreateSemaphoreA(0, 0, thread_count, 0);
+        for (u32 worker_index = 0; worker_index + 1 < thread_count; worker_index++) {
+            CloseHandle(CreateThread(0, 0, replay_worker_thread_proc, &workers, 0, 0));
+            workers.worker_count++;
+        }
+    }
+
+    u32 gl_backend_mask = (1 << ReplayBackend_FixedFunction)|(1 << ReplayBackend_Shader);
+    if (backend_mask & gl_backend_mask) {
+        WNDCLASSA window_class = {};
+        window_class.style = CS_OWNDC;
+        window_class.lpfnWndProc = DefWindowProcA;
+        window_class.hInstance = GetModuleHandleA(0);
+        window_class.hbrBackground = cast(HBRUSH) GetStockObject(BLACK_BRUSH);
+        window_class.lpszClassName = "PulsarReplayWindowClass";
+        if (!RegisterClassA(&window_class)) {
+            fprintf(stderr, "Could not register a window class, skipping the GL backends\n");
+            backend_mask &= ~gl_backend_mask;
+        }
+    }
+
+    for (u32 backend = 0; backend < ReplayBackend_Count; backend++) {
+        if (!(backend_mask & (1 << backend))) {
+            continue;
+        }
+
+        ReplayRenderer renderer;
+        if (begin_replay_renderer(&renderer, cast(ReplayBackend) backend, &workers, &assets, max_width, max_height)) {
+            if (backend == ReplayBackend_Software) {
+                fprintf(stdout, "\nsoftware: %u threads, %s span kernels\n", workers.worker_count + 1, software_span_kernels.name);
+            } else {
+                fprintf(stdout, "\n%s: %s, %s\n", replay_backend_names[backend], renderer.opengl_info.renderer, renderer.opengl_info.version);
+            }
+
+            replay_backend(&renderer, frame_count, frames, loop_count);
+            end_replay_renderer(&renderer);
+        }
+    }
+
+    return 0;
+}
@@ -41,7 +41,7 @@ struct Shape2D {
 
         struct /* Shape_Polygon */ {
             u32 vert_count;
-            v2* vertices;
+            v2* vertices; // @Note: Not copied when pushed as a render command, use push_frame_array for transient vertices
         };
 
         struct /* Shape_Circle */ {
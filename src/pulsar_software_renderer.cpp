@@ -0,0 +1,1260 @@
+//
+// Span kernels
+//
+
+// @Note: Every kernel does the same math in the same order, so the SSE2 and AVX2 kernels produce the exact same pixels.
+// The scalar ones are the reference the benchmark checks them against, and can be off by one here and there.
+
+inline v4 software_unpack_pixel(u32 pixel) {
+    f32 inv_255 = 1.0f / 255.0f;
+    f32 b = cast(f32) ((pixel >>  0) & 0xFF)*inv_255;
+    f32 g = cast(f32) ((pixel >>  8) & 0xFF)*inv_255;
+    f32 r = cast(f32) ((pixel >> 16) & 0xFF)*inv_255;
+    f32 a = cast(f32) ((pixel >> 24) & 0xFF)*inv_255;
+    v4 result = vec4(r*r, g*g, b*b, a);
+    return result;
+}
+
+inline u32 software_pack_pixel(v4 color) {
+    f32 r = square_root(clamp(color.r, 0.0f, 1.0f))*255.0f + 0.5f;
+    f32 g = square_root(clamp(color.g, 0.0f, 1.0f))*255.0f + 0.5f;
+    f32 b = square_root(clamp(color.b, 0.0f, 1.0f))*255.0f + 0.5f;
+    f32 a = clamp(color.a, 0.0f, 1.0f)*255.0f + 0.5f;
+    u32 result = (cast(u32) a << 24) | (cast(u32) r << 16) | (cast(u32) g << 8) | cast(u32) b;
+    return result;
+}
+
+inline v4 software_blend(v4 source, v4 dest) {
+    f32 inv_source_a = 1.0f - source.a;
+    v4 result;
+    result.r = source.r + dest.r*inv_source_a;
+    result.g = source.g + dest.g*inv_source_a;
+    result.b = source.b + dest.b*inv_source_a;
+    result.a = source.a + dest.a*inv_source_a;
+    return result;
+}
+
+inline v4 software_sample_bilinear(Image* image, f32 u, f32 v) {
+    f32 max_x = cast(f32) (image->w - 1);
+    f32 max_y = cast(f32) (image->h - 1);
+
+    // @Note: Clamp to edge, with texel centers at half texels like GL_LINEAR
+    f32 tx = clamp(u*cast(f32) image->w - 0.5f, 0.0f, max_x);
+    f32 ty = clamp(v*cast(f32) image->h - 0.5f, 0.0f, max_y);
+    f32 x0 = cast(f32) cast(s32) tx;
+    f32 y0 = cast(f32) cast(s32) ty;
+    f32 x1 = MIN(x0 + 1.0f, max_x);
+    f32 y1 = MIN(y0 + 1.0f, max_y);
+    f32 fx = tx - x0;
+    f32 fy = ty - y0;
+
+    u32* texels = cast(u32*) image->pixels;
+    f32 w = cast(f32) image->w;
+    v4 t00 = software_unpack_pixel(texels[cast(s32) (y0*w + x0)]);
+    v4 t10 = software_unpack_pixel(texels[cast(s32) (y0*w + x1)]);
+    v4 t01 = software_unpack_pixel(texels[cast(s32) (y1*w + x0)]);
+    v4 t11 = software_unpack_pixel(texels[cast(s32) (y1*w + x1)]);
+
+    v4 result;
+    for (u32 channel = 0; channel < 4; channel++) {
+        f32 bottom = t00.e[channel] + (t10.e[channel] - t00.e[channel])*fx;
+        f32 top    = t01.e[channel] + (t11.e[channel] - t01.e[channel])*fx;
+        result.e[channel] = bottom + (top - bottom)*fy;
+    }
+    return result;
+}
+
+internal SOFTWARE_FILL_SPAN(software_fill_span_scalar) {
+    for (u32 pixel_index = 0; pixel_index < count; pixel_index++) {
+        v4 dest = software_unpack_pixel(pixels[pixel_index]);
+        pixels[pixel_index] = software_pack_pixel(software_blend(color, dest));
+    }
+}
+
+internal SOFTWARE_TEXTURE_SPAN(software_texture_span_scalar) {
+    for (u32 pixel_index = 0; pixel_index < count; pixel_index++) {
+        f32 offset = cast(f32) pixel_index;
+        v4 texel = software_sample_bilinear(image, u + du*offset, v + dv*offset);
+        v4 source = vec4(texel.r*color.r, texel.g*color.g, texel.b*color.b, texel.a*color.a);
+        v4 dest = software_unpack_pixel(pixels[pixel_index]);
+        pixels[pixel_index] = software_pack_pixel(software_blend(source, dest));
+    }
+}
+
+// @Note: Four pixels, as four channels of four lanes
+struct SoftwareColor4x {
+    __m128 r, g, b, a;
+};
+
+inline SoftwareColor4x software_unpack_4x(__m128i pixels) {
+    __m128 inv_255 = _mm_set1_ps(1.0f / 255.0f);
+    __m128i mask_ff = _mm_set1_epi32(0xFF);
+
+    SoftwareColor4x result;
+    result.b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(pixels, mask_ff)), inv_255);
+    result.g = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 8), mask_ff)), inv_255);
+    result.r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 16), mask_ff)), inv_255);
+    result.a = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(pixels, 24)), inv_255);
+    result.r = _mm_mul_ps(result.r, result.r);
+    result.g = _mm_mul_ps(result.g, result.g);
+    result.b = _mm_mul_ps(result.b, result.b);
+    return result;
+}
+
+inline __m128i software_pack_4x(SoftwareColor4x color) {
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 one_255 = _mm_set1_ps(255.0f);
+    __m128 half = _mm_set1_ps(0.5f);
+
+    __m128 r = _mm_add_ps(_mm_mul_ps(_mm_sqrt_ps(_mm_min_ps(_mm_max_ps(color.r, zero), one)), one_255), half);
+    __m128 g = _mm_add_ps(_mm_mul_ps(_mm_sqrt_ps(_mm_min_ps(_mm_max_ps(color.g, zero), one)), one_255), half);
+    __m128 b = _mm_add_ps(_mm_mul_ps(_mm_sqrt_ps(_mm_min_ps(_mm_max_ps(color.b, zero), one)), one_255), half);
+    __m128 a = _mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(color.a, zero), one), one_255), half);
+
+    __m128i result = _mm_or_si128(
+        _mm_or_si128(_mm_slli_epi32(_mm_cvttps_epi32(a), 24), _mm_slli_epi32(_mm_cvttps_epi32(r), 16)),
+        _mm_or_si128(_mm_slli_epi32(_mm_cvttps_epi32(g), 8), _mm_cvttps_epi32(b))
+    );
+    return result;
+}
+
+inline SoftwareColor4x software_blend_4x(SoftwareColor4x source, SoftwareColor4x dest) {
+    __m128 inv_source_a = _mm_sub_ps(_mm_set1_ps(1.0f), source.a);
+
+    SoftwareColor4x result;
+    result.r = _mm_add_ps(source.r, _mm_mul_ps(dest.r, inv_source_a));
+    result.g = _mm_add_ps(source.g, _mm_mul_ps(dest.g, inv_source_a));
+    result.b = _mm_add_ps(source.b, _mm_mul_ps(dest.b, inv_source_a));
+    result.a = _mm_add_ps(source.a, _mm_mul_ps(dest.a, inv_source_a));
+    return result;
+}
+
+inline SoftwareColor4x software_lerp_4x(SoftwareColor4x a, SoftwareColor4x b, __m128 t) {
+    SoftwareColor4x result;
+    result.r = _mm_add_ps(a.r, _mm_mul_ps(_mm_sub_ps(b.r, a.r), t));
+    result.g = _mm_add_ps(a.g, _mm_mul_ps(_mm_sub_ps(b.g, a.g), t));
+    result.b = _mm_add_ps(a.b, _mm_mul_ps(_mm_sub_ps(b.b, a.b), t));
+    result.a = _mm_add_ps(a.a, _mm_mul_ps(_mm_sub_ps(b.a, a.a), t));
+    return result;
+}
+
+// @Note: Spans that don't fill a whole vector go through a little buffer, so the tail pixels get the same math too
+#define SOFTWARE_SPAN_TAIL_BEGIN(lanes)                            \
+    u32 tail_buffer[lanes] = {};                                   \
+    u32 tail_count = count % (lanes);                              \
+    u32* tail_pixels = pixels + (count - tail_count);              \
+    for (u32 tail_index = 0; tail_index < tail_count; tail_index++) { \
+        tail_buffer[tail_index] = tail_pixels[tail_index];         \
+    }
+
+#define SOFTWARE_SPAN_TAIL_END                                     \
+    for (u32 tail_index = 0; tail_index < tail_count; tail_index++) { \
+        tail_pixels[tail_index] = tail_buffer[tail_index];         \
+    }
+
+inline void software_fill_4x(u32* pixels, SoftwareColor4x source) {
+    SoftwareColor4x dest = software_unpack_4x(_mm_loadu_si128(cast(__m128i*) pixels));
+    _mm_storeu_si128(cast(__m128i*) pixels, software_pack_4x(software_blend_4x(source, dest)));
+}
+
+internal SOFTWARE_FILL_SPAN(software_fill_span_sse2) {
+    SoftwareColor4x source;
+    source.r = _mm_set1_ps(color.r);
+    source.g = _mm_set1_ps(color.g);
+    source.b = _mm_set1_ps(color.b);
+    source.a = _mm_set1_ps(color.a);
+
+    u32 body_count = count & ~3u;
+    for (u32 pixel_index = 0; pixel_index < body_count; pixel_index += 4) {
+        software_fill_4x(pixels + pixel_index, source);
+    }
+
+    if (count & 3) {
+        SOFTWARE_SPAN_TAIL_BEGIN(4);
+        software_fill_4x(tail_buffer, source);
+        SOFTWARE_SPAN_TAIL_END;
+    }
+}
+
+struct SoftwareTextureSpanSetup {
+    Image* image;
+    u32* texels;
+    f32 u, v, du, dv;
+    v4 color;
+};
+
+inline void software_texture_4x(u32* pixels, u32 first_pixel_index, SoftwareTextureSpanSetup* setup) {
+    Image* image = setup->image;
+    __m128 w = _mm_set1_ps(cast(f32) image->w);
+    __m128 h = _mm_set1_ps(cast(f32) image->h);
+    __m128 max_x = _mm_set1_ps(cast(f32) (image->w - 1));
+    __m128 max_y = _mm_set1_ps(cast(f32) (image->h - 1));
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 half = _mm_set1_ps(0.5f);
+
+    f32 first = cast(f32) first_pixel_index;
+    __m128 offset = _mm_setr_ps(first, first + 1.0f, first + 2.0f, first + 3.0f);
+    __m128 u = _mm_add_ps(_mm_set1_ps(setup->u), _mm_mul_ps(_mm_set1_ps(setup->du), offset));
+    __m128 v = _mm_add_ps(_mm_set1_ps(setup->v), _mm_mul_ps(_mm_set1_ps(setup->dv), offset));
+
+    __m128 tx = _mm_min_ps(_mm_max_ps(_mm_sub_ps(_mm_mul_ps(u, w), half), zero), max_x);
+    __m128 ty = _mm_min_ps(_mm_max_ps(_mm_sub_ps(_mm_mul_ps(v, h), half), zero), max_y);
+    __m128 x0 = _mm_cvtepi32_ps(_mm_cvttps_epi32(tx));
+    __m128 y0 = _mm_cvtepi32_ps(_mm_cvttps_epi32(ty));
+    __m128 x1 = _mm_min_ps(_mm_add_ps(x0, one), max_x);
+    __m128 y1 = _mm_min_ps(_mm_add_ps(y0, one), max_y);
+    __m128 fx = _mm_sub_ps(tx, x0);
+    __m128 fy = _mm_sub_ps(ty, y0);
+
+    // @Note: No gathers in SSE2, so the texel fetches are scalar
+    u32 index00[4], index10[4], index01[4], index11[4];
+    _mm_storeu_si128(cast(__m128i*) index00, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(y0, w), x0)));
+    _mm_storeu_si128(cast(__m128i*) index10, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(y0, w), x1)));
+    _mm_storeu_si128(cast(__m128i*) index01, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(y1, w), x0)));
+    _mm_storeu_si128(cast(__m128i*) index11, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(y1, w), x1)));
+
+    u32* texels = setup->texels;
+    SoftwareColor4x t00 = software_unpack_4x(_mm_setr_epi32(texels[index00[0]], texels[index00[1]], texels[index00[2]], texels[index00[3]]));
+    SoftwareColor4x t10 = software_unpack_4x(_mm_setr_epi32(texels[index10[0]], texels[index10[1]], texels[index10[2]], texels[index10[3]]));
+    SoftwareColor4x t01 = software_unpack_4x(_mm_setr_epi32(texels[index01[0]], texels[index01[1]], texels[index01[2]], texels[index01[3]]));
+    SoftwareColor4x t11 = software_unpack_4x(_mm_setr_epi32(texels[index11[0]], texels[index11[1]], texels[index11[2]], texels[index11[3]]));
+
+    SoftwareColor4x texel = software_lerp_4x(software_lerp_4x(t00, t10, fx), software_lerp_4x(t01, t11, fx), fy);
+
+    SoftwareColor4x source;
+    source.r = _mm_mul_ps(texel.r, _mm_set1_ps(setup->color.r));
+    source.g = _mm_mul_ps(texel.g, _mm_set1_ps(setup->color.g));
+    source.b = _mm_mul_ps(texel.b, _mm_set1_ps(setup->color.b));
+    source.a = _mm_mul_ps(texel.a, _mm_set1_ps(setup->color.a));
+
+    SoftwareColor4x dest = software_unpack_4x(_mm_loadu_si128(cast(__m128i*) pixels));
+    _mm_storeu_si128(cast(__m128i*) pixels, software_pack_4x(software_blend_4x(source, dest)));
+}
+
+inline SoftwareTextureSpanSetup software_texture_span_setup(Image* image, f32 u, f32 v, f32 du, f32 dv, v4 color) {
+    SoftwareTextureSpanSetup result;
+    result.image = image;
+    result.texels = cast(u32*) image->pixels;
+    result.u = u;
+    result.v = v;
+    result.du = du;
+    result.dv = dv;
+    result.color = color;
+    return result;
+}
+
+internal SOFTWARE_TEXTURE_SPAN(software_texture_span_sse2) {
+    SoftwareTextureSpanSetup setup = software_texture_span_setup(image, u, v, du, dv, color);
+
+    u32 body_count = count & ~3u;
+    for (u32 pixel_index = 0; pixel_index < body_count; pixel_index += 4) {
+        software_texture_4x(pixels + pixel_index, pixel_index, &setup);
+    }
+
+    if (count & 3) {
+        SOFTWARE_SPAN_TAIL_BEGIN(4);
+        software_texture_4x(tail_buffer, body_count, &setup);
+        SOFTWARE_SPAN_TAIL_END;
+    }
+}
+
+// @Note: Eight pixels, as four channels of eight lanes
+struct SoftwareColor8x {
+    __m256 r, g, b, a;
+};
+
+MEMORY_KERNEL_TARGET_AVX2 inline SoftwareColor8x software_unpack_8x(__m256i pixels) {
+    __m256 inv_255 = _mm256_set1_ps(1.0f / 255.0f);
+    __m256i mask_ff = _mm256_set1_epi32(0xFF);
+
+    SoftwareColor8x result;
+    result.b = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(pixels, mask_ff)), inv_255);
+    result.g = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), mask_ff)), inv_255);
+    result.r = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 16), mask_ff)), inv_255);
+    result.a = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(pixels, 24)), inv_255);
+    result.r = _mm256_mul_ps(result.r, result.r);
+    result.g = _mm256_mul_ps(result.g, result.g);
+    result.b = _mm256_mul_ps(result.b, result.b);
+    return result;
+}
+
+MEMORY_KERNEL_TARGET_AVX2 inline __m256i software_pack_8x(SoftwareColor8x color) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 one_255 = _mm256_set1_ps(255.0f);
+    __m256 half = _mm256_set1_ps(0.5f);
+
+    __m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_sqrt_ps(_mm256_min_ps(_mm256_max_ps(color.r, zero), one)), one_255), half);
+    __m256 g = _mm256_add_ps(_mm256_mul_ps(_mm256_sqrt_ps(_mm256_min_ps(_mm256_max_ps(color.g, zero), one)), one_255), half);
+    __m256 b = _mm256_add_ps(_mm256_mul_ps(_mm256_sqrt_ps(_mm256_min_ps(_mm256_max_ps(color.b, zero), one)), one_255), half);
+    __m256 a = _mm256_add_ps(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(color.a, zero), one), one_255), half);
+
+    __m256i result = _mm256_or_si256(
+        _mm256_or_si256(_mm256_slli_epi32(_mm256_cvttps_epi32(a), 24), _mm256_slli_epi32(_mm256_cvttps_epi32(r), 16)),
+        _mm256_or_si256(_mm256_slli_epi32(_mm256_cvttps_epi32(g), 8), _mm256_cvttps_epi32(b))
+    );
+    return result;
+}
+
+MEMORY_KERNEL_TARGET_AVX2 inline SoftwareColor8x software_blend_8x(SoftwareColor8x source, SoftwareColor8x dest) {
+    __m256 inv_source_a = _mm256_sub_ps(_mm256_set1_ps(1.0f), source.a);
+
+    SoftwareColor8x result;
+    result.r = _mm256_add_ps(source.r, _mm256_mul_ps(dest.r, inv_source_a));
+    result.g = _mm256_add_ps(source.g, _mm256_mul_ps(dest.g, inv_source_a));
+    result.b = _mm256_add_ps(source.b, _mm256_mul_ps(dest.b, inv_source_a));
+    result.a = _mm256_add_ps(source.a, _mm256_mul_ps(dest.a, inv_source_a));
+    return result;
+}
+
+MEMORY_KERNEL_TARGET_AVX2 inline SoftwareColor8x software_lerp_8x(SoftwareColor8x a, SoftwareColor8x b, __m256 t) {
+    SoftwareColor8x result;
+    result.r = _mm256_add_ps(a.r, _mm256_mul_ps(_mm256_sub_ps(b.r, a.r), t));
+    result.g = _mm256_add_ps(a.g, _mm256_mul_ps(_mm256_sub_ps(b.g, a.g), t));
+    result.b = _mm256_add_ps(a.b, _mm256_mul_ps(_mm256_sub_ps(b.b, a.b), t));
+    result.a = _mm256_add_ps(a.a, _mm256_mul_ps(_mm256_sub_ps(b.a, a.a), t));
+    return result;
+}
+
+MEMORY_KERNEL_TARGET_AVX2 internal SOFTWARE_FILL_SPAN(software_fill_span_avx2) {
+    SoftwareColor8x source;
+    source.r = _mm256_set1_ps(color.r);
+    source.g = _mm256_set1_ps(color.g);
+    source.b = _mm256_set1_ps(color.b);
+    source.a = _mm256_set1_ps(color.a);
+
+    u32 body_count = count & ~7u;
+    for (u32 pixel_index = 0; pixel_index < body_count; pixel_index += 8) {
+        __m256i* at = cast(__m256i*) (pixels + pixel_index);
+        SoftwareColor8x dest = software_unpack_8x(_mm256_loadu_si256(at));
+        _mm256_storeu_si256(at, software_pack_8x(software_blend_8x(source, dest)));
+    }
+
+    _mm256_zeroupper();
+
+    if (count & 7) {
+        software_fill_span_sse2(pixels + body_count, count & 7, color);
+    }
+}
+
+MEMORY_KERNEL_TARGET_AVX2 internal SOFTWARE_TEXTURE_SPAN(software_texture_span_avx2) {
+    __m256 w = _mm256_set1_ps(cast(f32) image->w);
+    __m256 h = _mm256_set1_ps(cast(f32) image->h);
+    __m256 max_x = _mm256_set1_ps(cast(f32) (image->w - 1));
+    __m256 max_y = _mm256_set1_ps(cast(f32) (image->h - 1));
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 half = _mm256_set1_ps(0.5f);
+    __m256 lane_offset = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+    int* texels = cast(int*) image->pixels;
+
+    u32 body_count = count & ~7u;
+    for (u32 pixel_index = 0; pixel_index < body_count; pixel_index += 8) {
+        __m256 offset = _mm256_add_ps(_mm256_set1_ps(cast(f32) pixel_index), lane_offset);
+        __m256 lane_u = _mm256_add_ps(_mm256_set1_ps(u), _mm256_mul_ps(_mm256_set1_ps(du), offset));
+        __m256 lane_v = _mm256_add_ps(_mm256_set1_ps(v), _mm256_mul_ps(_mm256_set1_ps(dv), offset));
+
+        __m256 tx = _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_mul_ps(lane_u, w), half), zero), max_x);
+        __m256 ty = _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_mul_ps(lane_v, h), half), zero), max_y);
+        __m256 x0 = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(tx));
+        __m256 y0 = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(ty));
+        __m256 x1 = _mm256_min_ps(_mm256_add_ps(x0, one), max_x);
+        __m256 y1 = _mm256_min_ps(_mm256_add_ps(y0, one), max_y);
+        __m256 fx = _mm256_sub_ps(tx, x0);
+        __m256 fy = _mm256_sub_ps(ty, y0);
+
+        __m256i index00 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(y0, w), x0));
+        __m256i index10 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(y0, w), x1));
+        __m256i index01 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(y1, w), x0));
+        __m256i index11 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(y1, w), x1));
+
+        SoftwareColor8x t00 = software_unpack_8x(_mm256_i32gather_epi32(texels, index00, 4));
+        SoftwareColor8x t10 = software_unpack_8x(_mm256_i32gather_epi32(texels, index10, 4));
+        SoftwareColor8x t01 = software_unpack_8x(_mm256_i32gather_epi32(texels, index01, 4));
+        SoftwareColor8x t11 = software_unpack_8x(_mm256_i32gather_epi32(texels, index11, 4));
+
+        SoftwareColor8x texel = software_lerp_8x(software_lerp_8x(t00, t10, fx), software_lerp_8x(t01, t11, fx), fy);
+
+        SoftwareColor8x source;
+        source.r = _mm256_mul_ps(texel.r, _mm256_set1_ps(color.r));
+        source.g = _mm256_mul_ps(texel.g, _mm256_set1_ps(color.g));
+        source.b = _mm256_mul_ps(texel.b, _mm256_set1_ps(color.b));
+        source.a = _mm256_mul_ps(texel.a, _mm256_set1_ps(color.a));
+
+        __m256i* at = cast(__m256i*) (pixels + pixel_index);
+        SoftwareColor8x dest = software_unpack_8x(_mm256_loadu_si256(at));
+        _mm256_storeu_si256(at, software_pack_8x(software_blend_8x(source, dest)));
+    }
+
+    _mm256_zeroupper();
+
+    if (count & 7) {
+        // @Note: The leftovers go through the SSE2 kernel, which has to know where they are in the span to get the same uvs
+        SoftwareTextureSpanSetup setup = software_texture_span_setup(image, u, v, du, dv, color);
+        u32 pixel_index = body_count;
+        if (count - pixel_index >= 4) {
+            software_texture_4x(pixels + pixel_index, pixel_index, &setup);
+            pixel_index += 4;
+        }
+
+        if (count & 3) {
+            SOFTWARE_SPAN_TAIL_BEGIN(4);
+            software_texture_4x(tail_buffer, pixel_index, &setup);
+            SOFTWARE_SPAN_TAIL_END;
+        }
+    }
+}
+
+global SoftwareSpanKernels software_span_kernels = { software_fill_span_sse2, software_texture_span_sse2, "SSE2" };
+
+inline void initialize_software_span_kernels() {
+    if (cpu_supports_avx2()) {
+        software_span_kernels.fill = software_fill_span_avx2;
+        software_span_kernels.texture = software_texture_span_avx2;
+        software_span_kernels.name = "AVX2";
+    } else {
+        software_span_kernels.fill = software_fill_span_sse2;
+        software_span_kernels.texture = software_texture_span_sse2;
+        software_span_kernels.name = "SSE2";
+    }
+}
+
+//
+// Front end
+//
+
+inline SoftwarePrimitive* software_push_primitive(LinearBuffer<SoftwarePrimitive>* buffer, u32 type, v4 color) {
+    SoftwarePrimitive* result = lb_push(buffer);
+    result->type = type;
+    result->color = color;
+    result->image = 0;
+    return result;
+}
+
+inline void software_push_triangle(LinearBuffer<SoftwarePrimitive>* buffer, v2 a, v2 b, v2 c, v4 color) {
+    SoftwarePrimitive* primitive = software_push_primitive(buffer, SoftwarePrimitive_Triangle, color);
+    primitive->p[0] = a;
+    primitive->p[1] = b;
+    primitive->p[2] = c;
+}
+
+inline void software_push_rectangle(LinearBuffer<SoftwarePrimitive>* buffer, v2 min_p, v2 max_p, v4 color) {
+    SoftwarePrimitive* primitive = software_push_primitive(buffer, SoftwarePrimitive_Rectangle, color);
+    primitive->p[0] = min_p;
+    primitive->p[1] = max_p;
+}
+
+// @Note: Quads that line up with the screen become rectangles, which skip all the edge walking
+inline void software_push_quad(LinearBuffer<SoftwarePrimitive>* buffer, v2 p00, v2 p10, v2 p11, v2 p01, v4 color) {
+    if (p00.y == p10.y && p10.x == p11.x && p11.y == p01.y && p01.x == p00.x) {
+        software_push_rectangle(buffer, vec2(MIN(p00.x, p11.x), MIN(p00.y, p11.y)), vec2(MAX(p00.x, p11.x), MAX(p00.y, p11.y)), color);
+    } else {
+        software_push_triangle(buffer, p00, p10, p11, color);
+        software_push_triangle(buffer, p00, p11, p01, color);
+    }
+}
+
+// @Note: Lines are quads, the same as in the GL shader path. Square caps close the corners of outlines.
+inline void software_push_line(LinearBuffer<SoftwarePrimitive>* buffer, v2 a, v2 b, f32 line_width, v4 color, b32 square_caps) {
+    v2 along = 0.5f*line_width*normalize_or_zero(b - a);
+    v2 across = perp(along);
+    if (square_caps) {
+        a -= along;
+        b += along;
+    }
+    software_push_quad(buffer, a - across, b - across, b + across, a + across, color);
+}
+
+internal void software_push_image(LinearBuffer<SoftwarePrimitive>* buffer, RenderCommandImage* command) {
+    Image* image = command->image;
+    if (!image->pixels || image->pixel_format != PixelFormat_BGRA8 || !image->w || !image->h) {
+        return;
+    }
+
+    Transform2D t = command->transform;
+    v2 x_axis = t.rotation_arm*t.scale*command->dim.x;
+    v2 y_axis = perp(t.rotation_arm*t.scale)*command->dim.y;
+    v2 min_p = t.offset - x_axis*command->align.x - y_axis*command->align.y;
+
+    v2 uv_dim = command->max_uv - command->min_uv;
+    f32 x_length_sq = length_sq(x_axis);
+    f32 y_length_sq = length_sq(y_axis);
+    if (x_length_sq == 0.0f || y_length_sq == 0.0f || uv_dim.x == 0.0f || uv_dim.y == 0.0f) {
+        return;
+    }
+
+    // @Note: The axes are perpendicular, so projecting onto them gives where in the quad a point is. Moving the origin
+    // back by min_uv's worth of quads and scaling the axes by the size of the region turns that into the uvs of the
+    // region.
+    v2 uv_origin = min_p - x_axis*(command->min_uv.x / uv_dim.x) - y_axis*(command->min_uv.y / uv_dim.y);
+    v2 u_axis = x_axis*(uv_dim.x / x_length_sq);
+    v2 v_axis = y_axis*(uv_dim.y / y_length_sq);
+
+    v2 corners[4] = { min_p, min_p + x_axis, min_p + x_axis + y_axis, min_p + y_axis };
+    for (u32 triangle_index = 0; triangle_index < 2; triangle_index++) {
+        SoftwarePrimitive* primitive = software_push_primitive(buffer, SoftwarePrimitive_TexturedTriangle, command->color);
+        primitive->p[0] = corners[0];
+        primitive->p[1] = corners[triangle_index + 1];
+        primitive->p[2] = corners[triangle_index + 2];
+        primitive->image = image;
+        primitive->uv_origin = uv_origin;
+        primitive->u_axis = u_axis;
+        primitive->v_axis = v_axis;
+    }
+}
+
+inline void software_push_rectangle_shape(LinearBuffer<SoftwarePrimitive>* buffer, Transform2D* transform, AxisAlignedBox2 aab, ShapeRenderMode render_mode, f32 line_width, v4 color) {
+    v2 p00, p10, p11, p01;
+    get_rectangle_corners(transform, aab, render_mode, line_width, &p00, &p10, &p11, &p01);
+
+    if (render_mode == ShapeRenderMode_Fill) {
+        software_push_quad(buffer, p00, p10, p11, p01, color);
+    } else {
+        software_push_line(buffer, p00, p10, line_width, color, true);
+        software_push_line(buffer, p10, p11, line_width, color, true);
+        software_push_line(buffer, p11, p01, line_width, color, true);
+        software_push_line(buffer, p01, p00, line_width, color, true);
+    }
+}
+
+internal void software_push_commands(LinearBuffer<SoftwarePrimitive>* buffer, GameRenderCommands* commands) {
+    f32 line_width = 2.0f;
+
+    for (u32 sort_entry_index = 0; sort_entry_index < commands->sort_entry_count; sort_entry_index++) {
+        SortEntry* entry = cast(SortEntry*) commands->command_buffer + sort_entry_index;
+        u8* at = commands->command_buffer + entry->index;
+
+        RenderCommandHeader* header = cast(RenderCommandHeader*) at;
+        at += sizeof(*header);
+
+        switch (header->type) {
+            case RenderCommand_Clear: {
+                RenderCommandClear* command = cast(RenderCommandClear*) at;
+                at += sizeof(*command);
+
+                software_push_primitive(buffer, SoftwarePrimitive_Clear, command->color);
+            } break;
+
+            case RenderCommand_Shape: {
+                RenderCommandShape* command = cast(RenderCommandShape*) at;
+                at += sizeof(*command);
+
+                Transform2D* transform = &command->transform;
+                Shape2D* shape = &command->shape;
+                v4 color = command->color;
+                b32 fill = (command->render_mode == ShapeRenderMode_Fill);
+
+                switch (shape->type) {
+                    case Shape_Line: {
+                        v2 start_p = transform->offset;
+                        v2 end_p   = transform->offset + transform->scale*rotate(shape->arm, transform->rotation_arm);
+                        software_push_line(buffer, start_p, end_p, line_width, color, false);
+                    } break;
+
+                    case Shape_Polygon: {
+                        if (fill) {
+                            for (u32 triangle_index = 0; triangle_index < command->triangle_count; triangle_index++) {
+                                u16* indices = command->triangle_indices + 3*triangle_index;
+                                v2 a = rotate(transform->scale*shape->vertices[indices[0]], transform->rotation_arm) + transform->offset;
+                                v2 b = rotate(transform->scale*shape->vertices[indices[1]], transform->rotation_arm) + transform->offset;
+                                v2 c = rotate(transform->scale*shape->vertices[indices[2]], transform->rotation_arm) + transform->offset;
+                                software_push_triangle(buffer, a, b, c, color);
+                            }
+                        } else {
+                            v2 first_v = rotate(transform->scale*shape->vertices[0], transform->rotation_arm) + transform->offset;
+                            v2 prev_v = first_v;
+                            for (u32 vertex_index = 1; vertex_index <= shape->vert_count; vertex_index++) {
+                                v2 v = first_v;
+                                if (vertex_index < shape->vert_count) {
+                                    v = rotate(transform->scale*shape->vertices[vertex_index], transform->rotation_arm) + transform->offset;
+                                }
+                                software_push_line(buffer, prev_v, v, line_width, color, true);
+                                prev_v = v;
+                            }
+                        }
+                    } break;
+
+                    case Shape_Circle: {
+                        u32 segment_count = get_circle_segment_count(transform, shape->radius);
+
+                        v2 prev_v = get_circle_shape_point(transform, shape->radius, 0, segment_count);
+                        for (u32 segment_index = 1; segment_index <= segment_count; segment_index++) {
+                            v2 v = get_circle_shape_point(transform, shape->radius, segment_index, segment_count);
+
+                            if (fill) {
+                                software_push_triangle(buffer, transform->offset, prev_v, v, color);
+                            } else {
+                                software_push_line(buffer, prev_v, v, line_width, color, true);
+                            }
+
+                            prev_v = v;
+                        }
+                    } break;
+
+                    case Shape_Rectangle: {
+                        software_push_rectangle_shape(buffer, transform, shape->bounding_box, command->render_mode, line_width, color);
+                    } break;
+                }
+            } break;
+
+            case RenderCommand_RectBatch: {
+                RenderCommandRectBatch* command = cast(RenderCommandRectBatch*) at;
+                at += sizeof(*command);
+
+                for (u32 rect_index = 0; rect_index < command->rect_count; rect_index++) {
+                    RenderRect* rect = command->rects + rect_index;
+                    software_push_rectangle_shape(buffer, &command->transform, rect->aab, rect->render_mode, line_width, rect->color);
+                }
+            } break;
+
+            case RenderCommand_Image: {
+                RenderCommandImage* command = cast(RenderCommandImage*) at;
+                at += sizeof(*command);
+
+                software_push_image(buffer, command);
+            } break;
+
+            case RenderCommand_GlyphRun: {
+                RenderCommandGlyphRun* command = cast(RenderCommandGlyphRun*) at;
+                at += sizeof(*command);
+
+                if (command->shadow_color.a > 0.0f) {
+                    for (u32 glyph_index = 0; glyph_index < command->glyph_count; glyph_index++) {
+                        RenderCommandImage glyph_image = get_glyph_run_image(command, command->glyphs[glyph_index], true);
+                        software_push_image(buffer, &glyph_image);
+                    }
+                }
+
+                for (u32 glyph_index = 0; glyph_index < command->glyph_count; glyph_index++) {
+                    RenderCommandImage glyph_image = get_glyph_run_image(command, command->glyphs[glyph_index], false);
+                    software_push_image(buffer, &glyph_image);
+                }
+            } break;
+
+            case RenderCommand_ParticleSystem: {
+                RenderCommandParticleSystem* command = cast(RenderCommandParticleSystem*) at;
+                at += sizeof(*command);
+
+                SoftwarePrimitive* primitive = software_push_primitive(buffer, SoftwarePrimitive_Particles, vec4(1, 1, 1, 1));
+                primitive->particle_command = command;
+                primitive->particle_bins = 0;
+            } break;
+
+            INVALID_DEFAULT_CASE;
+        }
+    }
+}
+
+// @Note: The first pixel whose center is at or past edge, clamped to [lo, hi]. With spans covering [first, one past
+// last), neighbouring primitives that share an edge never both cover the same pixel.
+inline s32 software_pixel_edge(f32 edge, s32 lo, s32 hi) {
+    f32 clamped = clamp(edge - 0.5f, cast(f32) lo - 1.0f, cast(f32) hi + 1.0f);
+    s32 result = CLAMP(ceil_f32_to_i32(clamped), lo, hi);
+    return result;
+}
+
+inline SoftwarePixelRect software_primitive_pixel_rect(SoftwareFramebuffer* framebuffer, SoftwarePrimitive* primitive) {
+    s32 width = cast(s32) framebuffer->width;
+    s32 height = cast(s32) framebuffer->height;
+
+    // @Note: Particle systems go in every tile, they don't get binned until the tiles are being rendered, and tiles
+    // without any of their particles skip them right away
+    SoftwarePixelRect result = { 0, 0, width, height };
+    if (primitive->type != SoftwarePrimitive_Clear && primitive->type != SoftwarePrimitive_Particles) {
+        u32 point_count = (primitive->type == SoftwarePrimitive_Rectangle) ? 2 : 3;
+        v2 min_p = primitive->p[0];
+        v2 max_p = primitive->p[0];
+        for (u32 point_index = 1; point_index < point_count; point_index++) {
+            min_p = min(min_p, primitive->p[point_index]);
+            max_p = max(max_p, primitive->p[point_index]);
+        }
+
+        result.min_x = software_pixel_edge(min_p.x, 0, width);
+        result.min_y = software_pixel_edge(min_p.y, 0, height);
+        result.max_x = software_pixel_edge(max_p.x, 0, width);
+        result.max_y = software_pixel_edge(max_p.y, 0, height);
+    }
+    return result;
+}
+
+// @Note: software_pixel_edge for four edges at once, with lo at 0
+inline __m128 software_pixel_edge_4x(__m128 edge, __m128 hi) {
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 clamped = _mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_sub_ps(edge, _mm_set1_ps(0.5f)), _mm_set1_ps(-1.0f)), _mm_add_ps(hi, one)), one);
+    __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(clamped));
+    __m128 ceiling = _mm_add_ps(truncated, _mm_and_ps(_mm_cmplt_ps(truncated, clamped), one));
+    __m128 result = _mm_min_ps(_mm_max_ps(_mm_sub_ps(ceiling, one), _mm_setzero_ps()), hi);
+    return result;
+}
+
+struct SoftwareParticleSetup {
+    __m128 offset_x, offset_y;
+    __m128 x_axis_x, x_axis_y;
+    __m128 y_axis_x, y_axis_y;
+    __m128 half_size_x, half_size_y;
+    __m128 width, height;
+};
+
+// @Note: The pixel rects of four particles, and which of them are on screen and which of those are inside one tile
+struct SoftwareParticleRects4x {
+    __m128 min_x, min_y;
+    __m128 max_x, max_y;
+    __m128 tile_x, tile_y; // @Note: The tile the rect starts in
+    u32 visible_mask;
+    u32 one_tile_mask;
+};
+
+inline SoftwareParticleSetup software_particle_setup(SoftwareFramebuffer* framebuffer, RenderCommandParticleSystem* command) {
+    Transform2D t = command->transform;
+
+    v2 x_axis = t.rotation_arm*t.scale;
+    v2 y_axis = perp(x_axis);
+    v2 half_size = t.scale*command->system->half_size;
+    half_size = vec2(abs(half_size.x), abs(half_size.y));
+
+    SoftwareParticleSetup result;
+    result.offset_x = _mm_set1_ps(t.offset.x);
+    result.offset_y = _mm_set1_ps(t.offset.y);
+    result.x_axis_x = _mm_set1_ps(x_axis.x);
+    result.x_axis_y = _mm_set1_ps(x_axis.y);
+    result.y_axis_x = _mm_set1_ps(y_axis.x);
+    result.y_axis_y = _mm_set1_ps(y_axis.y);
+    result.half_size_x = _mm_set1_ps(half_size.x);
+    result.half_size_y = _mm_set1_ps(half_size.y);
+    result.width = _mm_set1_ps(cast(f32) framebuffer->width);
+    result.height = _mm_set1_ps(cast(f32) framebuffer->height);
+    return result;
+}
+
+inline SoftwareParticleRects4x software_particle_rects_4x(SoftwareParticleSetup* setup, ParticleSystem* system, u32 particle_index) {
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 inv_tile_size = _mm_set1_ps(1.0f / cast(f32) SOFTWARE_TILE_SIZE);
+
+    __m128 x = _mm_loadu_ps(system->x + particle_index);
+    __m128 y = _mm_loadu_ps(system->y + particle_index);
+    __m128 alpha = _mm_loadu_ps(system->alpha + particle_index);
+
+    __m128 center_x = _mm_add_ps(setup->offset_x, _mm_add_ps(_mm_mul_ps(setup->x_axis_x, x), _mm_mul_ps(setup->y_axis_x, y)));
+    __m128 center_y = _mm_add_ps(setup->offset_y, _mm_add_ps(_mm_mul_ps(setup->x_axis_y, x), _mm_mul_ps(setup->y_axis_y, y)));
+
+    SoftwareParticleRects4x result;
+    result.min_x = software_pixel_edge_4x(_mm_sub_ps(center_x, setup->half_size_x), setup->width);
+    result.min_y = software_pixel_edge_4x(_mm_sub_ps(center_y, setup->half_size_y), setup->height);
+    result.max_x = software_pixel_edge_4x(_mm_add_ps(center_x, setup->half_size_x), setup->width);
+    result.max_y = software_pixel_edge_4x(_mm_add_ps(center_y, setup->half_size_y), setup->height);
+
+    __m128 visible = _mm_and_ps(_mm_cmpgt_ps(alpha, _mm_setzero_ps()), _mm_and_ps(_mm_cmplt_ps(result.min_x, result.max_x), _mm_cmplt_ps(result.min_y, result.max_y)));
+    result.visible_mask = cast(u32) _mm_movemask_ps(visible);
+
+    // @Note: The pixel edges are whole numbers, and not negative, so truncating divides them down to their tile
+    result.tile_x = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(result.min_x, inv_tile_size)));
+    result.tile_y = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(result.min_y, inv_tile_size)));
+    __m128 last_tile_x = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(_mm_sub_ps(result.max_x, one), inv_tile_size)));
+    __m128 last_tile_y = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(_mm_sub_ps(result.max_y, one), inv_tile_size)));
+    result.one_tile_mask = cast(u32) _mm_movemask_ps(_mm_and_ps(_mm_cmpeq_ps(result.tile_x, last_tile_x), _mm_cmpeq_ps(result.tile_y, last_tile_y)));
+
+    return result;
+}
+
+internal void software_count_particles(SoftwareRenderer* renderer, SoftwareParticleJob* job) {
+    ParticleSystem* system = job->command->system;
+    SoftwareParticleSetup setup = software_particle_setup(&renderer->framebuffer, job->command);
+    __m128 tile_count_x = _mm_set1_ps(cast(f32) renderer->tile_count_x);
+
+    zero_size(sizeof(u32)*renderer->tile_count, job->tile_cursors);
+
+    for (u32 particle_index = job->first_particle; particle_index < job->end_particle; particle_index += PARTICLE_LANE_COUNT) {
+        SoftwareParticleRects4x rects = software_particle_rects_4x(&setup, system, particle_index);
+        if (!rects.visible_mask) {
+            continue;
+        }
+
+        s32 tiles[PARTICLE_LANE_COUNT];
+        _mm_storeu_si128(cast(__m128i*) tiles, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(rects.tile_y, tile_count_x), rects.tile_x)));
+
+        if ((rects.visible_mask & rects.one_tile_mask) == rects.visible_mask) {
+            for (u32 lane_index = 0; lane_index < PARTICLE_LANE_COUNT; lane_index++) {
+                if (rects.visible_mask & (1 << lane_index)) {
+                    job->tile_cursors[tiles[lane_index]]++;
+                }
+            }
+        } else {
+            s32 min_x[PARTICLE_LANE_COUNT], min_y[PARTICLE_LANE_COUNT], max_x[PARTICLE_LANE_COUNT], max_y[PARTICLE_LANE_COUNT];
+            _mm_storeu_si128(cast(__m128i*) min_x, _mm_cvttps_epi32(rects.min_x));
+            _mm_storeu_si128(cast(__m128i*) min_y, _mm_cvttps_epi32(rects.min_y));
+            _mm_storeu_si128(cast(__m128i*) max_x, _mm_cvttps_epi32(rects.max_x));
+            _mm_storeu_si128(cast(__m128i*) max_y, _mm_cvttps_epi32(rects.max_y));
+
+            for (u32 lane_index = 0; lane_index < PARTICLE_LANE_COUNT; lane_index++) {
+                if (rects.visible_mask & (1 << lane_index)) {
+                    for (s32 tile_y = min_y[lane_index] / SOFTWARE_TILE_SIZE; tile_y <= (max_y[lane_index] - 1) / SOFTWARE_TILE_SIZE; tile_y++) {
+                        for (s32 tile_x = min_x[lane_index] / SOFTWARE_TILE_SIZE; tile_x <= (max_x[lane_index] - 1) / SOFTWARE_TILE_SIZE; tile_x++) {
+                            job->tile_cursors[tile_y*renderer->tile_count_x + tile_x]++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// @Note: Gives every particle system's tiles their spot in its bins, and every job its spot in each tile, in job order.
+// That way the bins come out the same no matter which threads did which jobs.
+internal void software_place_particles(SoftwareRenderer* renderer) {
+    u32 first_job_index = 0;
+    while (first_job_index < renderer->particle_job_count) {
+        SoftwareParticleBins* bins = renderer->particle_jobs[first_job_index].bins;
+        u32 end_job_index = first_job_index + 1;
+        while (end_job_index < renderer->particle_job_count && renderer->particle_jobs[end_job_index].bins == bins) {
+            end_job_index++;
+        }
+
+        u32 total = 0;
+        for (u32 tile_index = 0; tile_index < renderer->tile_count; tile_index++) {
+            bins->tile_offsets[tile_index] = total;
+            for (u32 job_index = first_job_index; job_index < end_job_index; job_index++) {
+                SoftwareParticleJob* job = renderer->particle_jobs + job_index;
+                u32 count = job->tile_cursors[tile_index];
+                job->tile_cursors[tile_index] = total;
+                total += count;
+            }
+        }
+        bins->tile_offsets[renderer->tile_count] = total;
+        bins->particles = push_array(renderer->arena, total, SoftwareParticle, no_clear());
+
+        first_job_index = end_job_index;
+    }
+}
+
+internal void software_scatter_particles(SoftwareRenderer* renderer, SoftwareParticleJob* job) {
+    ParticleSystem* system = job->command->system;
+    SoftwareParticleBins* bins = job->bins;
+    SoftwareParticleSetup setup = software_particle_setup(&renderer->framebuffer, job->command);
+    __m128 tile_count_x = _mm_set1_ps(cast(f32) renderer->tile_count_x);
+    __m128 tile_size = _mm_set1_ps(cast(f32) SOFTWARE_TILE_SIZE);
+    __m128 one = _mm_set1_ps(1.0f);
+
+    for (u32 particle_index = job->first_particle; particle_index < job->end_particle; particle_index += PARTICLE_LANE_COUNT) {
+        SoftwareParticleRects4x rects = software_particle_rects_4x(&setup, system, particle_index);
+        if (!rects.visible_mask) {
+            continue;
+        }
+
+        // @Note: Relative to the tile the rect starts in, which is all there is to it for particles in one tile
+        __m128 tile_min_x = _mm_mul_ps(rects.tile_x, tile_size);
+        __m128 tile_min_y = _mm_mul_ps(rects.tile_y, tile_size);
+
+        __m128i local_min_x = _mm_cvttps_epi32(_mm_sub_ps(rects.min_x, tile_min_x));
+        __m128i local_min_y = _mm_cvttps_epi32(_mm_sub_ps(rects.min_y, tile_min_y));
+        __m128i local_max_x = _mm_cvttps_epi32(_mm_sub_ps(rects.max_x, tile_min_x));
+        __m128i local_max_y = _mm_cvttps_epi32(_mm_sub_ps(rects.max_y, tile_min_y));
+        __m128 transmittance = _mm_sub_ps(one, _mm_loadu_ps(system->alpha + particle_index));
+
+        // @Note: Put the bytes of the rects together and interleave them with the transmittances, which makes four
+        // SoftwareParticles ready to copy into the bins
+        __m128i packed_rects = _mm_or_si128(_mm_or_si128(local_min_x, _mm_slli_epi32(local_min_y, 8)), _mm_or_si128(_mm_slli_epi32(local_max_x, 16), _mm_slli_epi32(local_max_y, 24)));
+        SoftwareParticle particles[PARTICLE_LANE_COUNT];
+        _mm_storeu_ps(cast(f32*) particles, _mm_unpacklo_ps(_mm_castsi128_ps(packed_rects), transmittance));
+        _mm_storeu_ps(cast(f32*) particles + 4, _mm_unpackhi_ps(_mm_castsi128_ps(packed_rects), transmittance));
+
+        s32 tiles[PARTICLE_LANE_COUNT];
+        _mm_storeu_si128(cast(__m128i*) tiles, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(rects.tile_y, tile_count_x), rects.tile_x)));
+
+        // @Note: Particles over more than one tile can be any size, so they get cut up from their screen rects
+        s32 min_x[PARTICLE_LANE_COUNT], min_y[PARTICLE_LANE_COUNT], max_x[PARTICLE_LANE_COUNT], max_y[PARTICLE_LANE_COUNT];
+        if (rects.visible_mask & ~rects.one_tile_mask) {
+            _mm_storeu_si128(cast(__m128i*) min_x, _mm_cvttps_epi32(rects.min_x));
+            _mm_storeu_si128(cast(__m128i*) min_y, _mm_cvttps_epi32(rects.min_y));
+            _mm_storeu_si128(cast(__m128i*) max_x, _mm_cvttps_epi32(rects.max_x));
+            _mm_storeu_si128(cast(__m128i*) max_y, _mm_cvttps_epi32(rects.max_y));
+        }
+
+        for (u32 lane_index = 0; lane_index < PARTICLE_LANE_COUNT; lane_index++) {
+            if (rects.visible_mask & (1 << lane_index)) {
+                if (rects.one_tile_mask & (1 << lane_index)) {
+                    bins->particles[job->tile_cursors[tiles[lane_index]]++] = particles[lane_index];
+                } else {
+                    for (s32 tile_y = min_y[lane_index] / SOFTWARE_TILE_SIZE; tile_y <= (max_y[lane_index] - 1) / SOFTWARE_TILE_SIZE; tile_y++) {
+                        for (s32 tile_x = min_x[lane_index] / SOFTWARE_TILE_SIZE; tile_x <= (max_x[lane_index] - 1) / SOFTWARE_TILE_SIZE; tile_x++) {
+                            s32 offset_x = tile_x*SOFTWARE_TILE_SIZE;
+                            s32 offset_y = tile_y*SOFTWARE_TILE_SIZE;
+
+                            SoftwareParticle* piece = bins->particles + job->tile_cursors[tile_y*renderer->tile_count_x + tile_x]++;
+                            piece->min_x = cast(u8) MAX(min_x[lane_index] - offset_x, 0);
+                            piece->min_y = cast(u8) MAX(min_y[lane_index] - offset_y, 0);
+                            piece->max_x = cast(u8) MIN(max_x[lane_index] - offset_x, SOFTWARE_TILE_SIZE);
+                            piece->max_y = cast(u8) MIN(max_y[lane_index] - offset_y, SOFTWARE_TILE_SIZE);
+                            piece->transmittance = particles[lane_index].transmittance;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// @Note: Every thread that calls this takes particle jobs until there are none left, and only returns once all of them
+// are done. The jobs of the second round only get taken once all of the first round's have been, so whoever waits for
+// the placement in between waits for threads that are already working.
+internal void software_bin_particles(SoftwareRenderer* renderer) {
+    u32 job_count = renderer->particle_job_count;
+    for (;;) {
+        u32 job_index = atomic_add_u32(&renderer->next_particle_job, 1);
+        if (job_index >= 2*job_count) {
+            break;
+        }
+
+        if (job_index < job_count) {
+            software_count_particles(renderer, renderer->particle_jobs + job_index);
+            if (atomic_add_u32(&renderer->particle_jobs_counted, 1) + 1 == job_count) {
+                software_place_particles(renderer);
+                atomic_exchange_u32(&renderer->particle_jobs_placed, 1);
+            }
+        } else {
+            while (!renderer->particle_jobs_placed) {
+                _mm_pause();
+            }
+            software_scatter_particles(renderer, renderer->particle_jobs + (job_index - job_count));
+            atomic_add_u32(&renderer->particle_jobs_binned, 1);
+        }
+    }
+
+    while (renderer->particle_jobs_binned != job_count) {
+        _mm_pause();
+    }
+}
+
+// @Note: Turns the commands into primitives and bins them. The commands need to be sorted already. The primitives and
+// bins live in arena, and have to stay there until the tiles are done.
+internal void software_begin_render(SoftwareRenderer* renderer, SoftwareFramebuffer framebuffer, GameRenderCommands* commands, MemoryArena* arena) {
+    atomic_exchange_u32(&renderer->next_particle_job, UINT32_MAX / 2);
+    atomic_exchange_u32(&renderer->next_tile, UINT32_MAX / 2);
+
+    renderer->framebuffer = framebuffer;
+    renderer->tile_count_x = (framebuffer.width + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+    renderer->tile_count_y = (framebuffer.height + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+    renderer->tile_count = renderer->tile_count_x*renderer->tile_count_y;
+
+    LinearBuffer<SoftwarePrimitive>* buffer = begin_linear_buffer<SoftwarePrimitive>(arena);
+    software_push_commands(buffer, commands);
+    renderer->primitives = buffer->data;
+    renderer->primitive_count = cast(u32) buffer->count;
+    end_linear_buffer(buffer);
+
+    // @Note: Set up the particle jobs. Their particles get binned in software_render_tiles.
+    renderer->arena = arena;
+    renderer->particle_job_count = 0;
+    for (u32 primitive_index = 0; primitive_index < renderer->primitive_count; primitive_index++) {
+        SoftwarePrimitive* primitive = renderer->primitives + primitive_index;
+        if (primitive->type == SoftwarePrimitive_Particles) {
+            u32 padded_count = get_padded_particle_count(primitive->particle_command->system->count);
+            renderer->particle_job_count += (padded_count + SOFTWARE_PARTICLE_JOB_SIZE - 1) / SOFTWARE_PARTICLE_JOB_SIZE;
+        }
+    }
+
+    renderer->particle_jobs = push_array(arena, renderer->particle_job_count, SoftwareParticleJob, no_clear());
+    u32 job_index = 0;
+    for (u32 primitive_index = 0; primitive_index < renderer->primitive_count; primitive_index++) {
+        SoftwarePrimitive* primitive = renderer->primitives + primitive_index;
+        if (primitive->type == SoftwarePrimitive_Particles) {
+            SoftwareParticleBins* bins = push_struct(arena, SoftwareParticleBins, no_clear());
+            bins->tile_offsets = push_array(arena, renderer->tile_count + 1, u32, no_clear());
+            bins->particles = 0;
+            primitive->particle_bins = bins;
+
+            u32 padded_count = get_padded_particle_count(primitive->particle_command->system->count);
+            for (u32 first_particle = 0; first_particle < padded_count; first_particle += SOFTWARE_PARTICLE_JOB_SIZE) {
+                SoftwareParticleJob* job = renderer->particle_jobs + job_index++;
+                job->command = primitive->particle_command;
+                job->bins = bins;
+                job->first_particle = first_particle;
+                job->end_particle = MIN(first_particle + SOFTWARE_PARTICLE_JOB_SIZE, padded_count);
+                job->tile_cursors = push_array(arena, renderer->tile_count, u32, no_clear());
+            }
+
+            // @Note: A system without any particles still needs its bins to be empty
+            if (!padded_count) {
+                zero_size(sizeof(u32)*(renderer->tile_count + 1), bins->tile_offsets);
+            }
+        }
+    }
+    assert(job_index == renderer->particle_job_count);
+
+    // @Note: Count how many primitives land in each tile, then go again and fill in the bins. Both passes go through
+    // the primitives in order, so every bin comes out in the sorted order.
+    renderer->tile_bin_offsets = push_array(arena, renderer->tile_count + 1, u32);
+    for (u32 primitive_index = 0; primitive_index < renderer->primitive_count; primitive_index++) {
+        SoftwarePixelRect rect = software_primitive_pixel_rect(&framebuffer, renderer->primitives + primitive_index);
+        if (rect.min_x < rect.max_x && rect.min_y < rect.max_y) {
+            for (s32 tile_y = rect.min_y / SOFTWARE_TILE_SIZE; tile_y <= (rect.max_y - 1) / SOFTWARE_TILE_SIZE; tile_y++) {
+                for (s32 tile_x = rect.min_x / SOFTWARE_TILE_SIZE; tile_x <= (rect.max_x - 1) / SOFTWARE_TILE_SIZE; tile_x++) {
+                    renderer->tile_bin_offsets[tile_y*renderer->tile_count_x + tile_x + 1]++;
+                }
+            }
+        }
+    }
+
+    for (u32 tile_index = 0; tile_index < renderer->tile_count; tile_index++) {
+        renderer->tile_bin_offsets[tile_index + 1] += renderer->tile_bin_offsets[tile_index];
+    }
+
+    u32* tile_cursors = push_array(arena, renderer->tile_count, u32, no_clear());
+    copy(sizeof(u32)*renderer->tile_count, renderer->tile_bin_offsets, tile_cursors);
+
+    renderer->tile_bins = push_array(arena, renderer->tile_bin_offsets[renderer->tile_count], u32, no_clear());
+    for (u32 primitive_index = 0; primitive_index < renderer->primitive_count; primitive_index++) {
+        SoftwarePixelRect rect = software_primitive_pixel_rect(&framebuffer, renderer->primitives + primitive_index);
+        if (rect.min_x < rect.max_x && rect.min_y < rect.max_y) {
+            for (s32 tile_y = rect.min_y / SOFTWARE_TILE_SIZE; tile_y <= (rect.max_y - 1) / SOFTWARE_TILE_SIZE; tile_y++) {
+                for (s32 tile_x = rect.min_x / SOFTWARE_TILE_SIZE; tile_x <= (rect.max_x - 1) / SOFTWARE_TILE_SIZE; tile_x++) {
+                    renderer->tile_bins[tile_cursors[tile_y*renderer->tile_count_x + tile_x]++] = primitive_index;
+                }
+            }
+        }
+    }
+
+    renderer->particle_jobs_counted = 0;
+    renderer->particle_jobs_placed = 0;
+    renderer->particle_jobs_binned = 0;
+    atomic_exchange_u32(&renderer->next_particle_job, 0);
+
+    renderer->tiles_done = 0;
+    atomic_exchange_u32(&renderer->next_tile, 0);
+}
+
+//
+// Tiles
+//
+
+inline f32 software_edge_x(v2 start, f32 dx_dy, f32 y) {
+    f32 result = start.x + (y - start.y)*dx_dy;
+    return result;
+}
+
+internal void software_rasterize_triangle(SoftwareFramebuffer* framebuffer, SoftwarePrimitive* primitive, SoftwarePixelRect clip) {
+    v2 v0 = primitive->p[0];
+    v2 v1 = primitive->p[1];
+    v2 v2_ = primitive->p[2];
+
+    // @Note: Sort by y, so an edge shared by two triangles gets walked from the same end in both and lands on the
+    // exact same x on every row.
+#define SOFTWARE_VERTEX_BEFORE(a, b) ((a).y < (b).y || ((a).y == (b).y && (a).x < (b).x))
+    if (SOFTWARE_VERTEX_BEFORE(v1, v0)) SWAP(v0, v1);
+    if (SOFTWARE_VERTEX_BEFORE(v2_, v1)) SWAP(v1, v2_);
+    if (SOFTWARE_VERTEX_BEFORE(v1, v0)) SWAP(v0, v1);
+#undef SOFTWARE_VERTEX_BEFORE
+
+    if (v0.y == v2_.y) {
+        return;
+    }
+
+    f32 long_dx_dy   = (v2_.x - v0.x) / (v2_.y - v0.y);
+    f32 bottom_dx_dy = (v1.y > v0.y) ? (v1.x - v0.x) / (v1.y - v0.y) : 0.0f;
+    f32 top_dx_dy    = (v2_.y > v1.y) ? (v2_.x - v1.x) / (v2_.y - v1.y) : 0.0f;
+
+    s32 min_y = software_pixel_edge(v0.y, clip.min_y, clip.max_y);
+    s32 max_y = software_pixel_edge(v2_.y, clip.min_y, clip.max_y);
+
+    b32 textured = (primitive->type == SoftwarePrimitive_TexturedTriangle);
+
+    for (s32 y = min_y; y < max_y; y++) {
+        f32 center_y = cast(f32) y + 0.5f;
+
+        f32 long_x = software_edge_x(v0, long_dx_dy, center_y);
+        f32 short_x = (center_y < v1.y) ? software_edge_x(v0, bottom_dx_dy, center_y) : software_edge_x(v1, top_dx_dy, center_y);
+
+        s32 min_x = software_pixel_edge(MIN(long_x, short_x), clip.min_x, clip.max_x);
+        s32 max_x = software_pixel_edge(MAX(long_x, short_x), clip.min_x, clip.max_x);
+
+        if (min_x < max_x) {
+            u32* row = framebuffer->pixels + cast(u32) y*framebuffer->pitch + cast(u32) min_x;
+            u32 count = cast(u32) (max_x - min_x);
+            if (textured) {
+                v2 d = vec2(cast(f32) min_x + 0.5f, center_y) - primitive->uv_origin;
+                f32 u = dot(d, primitive->u_axis);
+                f32 v = dot(d, primitive->v_axis);
+                software_span_kernels.texture(row, count, primitive->image, u, v, primitive->u_axis.x, primitive->v_axis.x, primitive->color);
+            } else {
+                software_span_kernels.fill(row, count, primitive->color);
+            }
+        }
+    }
+}
+
+// @Note: Particles are white, so drawing one with premultiplied alpha over a pixel takes 1 - pixel to
+// (1 - pixel)*(1 - alpha), in every channel. The order they get drawn in doesn't matter then, so a tile's particles just
+// multiply their 1 - alpha into how much of the pixels underneath shows through, and the pixels get blended once at the
+// end. Unlike blending the particles one at a time, nothing gets rounded to 8 bits in between, so it's slightly more
+// accurate too. Either way it doesn't depend on the span kernels.
+internal void software_render_particles(SoftwareFramebuffer* framebuffer, SoftwareParticleBins* bins, u32 tile_index, SoftwarePixelRect tile) {
+    u32 first_particle = bins->tile_offsets[tile_index];
+    u32 end_particle = bins->tile_offsets[tile_index + 1];
+    if (first_particle == end_particle) {
+        return;
+    }
+
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128i lane_indices = _mm_setr_epi32(0, 1, 2, 3);
+
+    // @Note: Rows are padded to a multiple of four pixels, and the padding never gets touched. Particles up to four
+    // pixels wide get multiplied in four at a time, with 1 past their right edge, which can run into the start of the
+    // next row or the four extra at the end without changing them.
+    f32 transmittance[SOFTWARE_TILE_SIZE*SOFTWARE_TILE_SIZE + 4];
+    for (u32 index = 0; index < ARRAY_COUNT(transmittance); index += 4) {
+        _mm_storeu_ps(transmittance + index, one);
+    }
+
+    s32 touched_min_x = SOFTWARE_TILE_SIZE;
+    s32 touched_min_y = SOFTWARE_TILE_SIZE;
+    s32 touched_max_x = 0;
+    s32 touched_max_y = 0;
+    for (u32 particle_index = first_particle; particle_index < end_particle; particle_index++) {
+        SoftwareParticle* particle = bins->particles + particle_index;
+        s32 min_x = particle->min_x;
+        s32 min_y = particle->min_y;
+        s32 max_x = particle->max_x;
+        s32 max_y = particle->max_y;
+
+        touched_min_x = MIN(touched_min_x, min_x);
+        touched_min_y = MIN(touched_min_y, min_y);
+        touched_max_x = MAX(touched_max_x, max_x);
+        touched_max_y = MAX(touched_max_y, max_y);
+
+        if (max_x - min_x <= 4) {
+            __m128 lanes = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_set1_epi32(max_x - min_x), lane_indices));
+            __m128 factor = _mm_or_ps(_mm_and_ps(lanes, _mm_set1_ps(particle->transmittance)), _mm_andnot_ps(lanes, one));
+            f32* row = transmittance + min_y*SOFTWARE_TILE_SIZE + min_x;
+            for (s32 y = min_y; y < max_y; y++) {
+                _mm_storeu_ps(row, _mm_mul_ps(_mm_loadu_ps(row), factor));
+                row += SOFTWARE_TILE_SIZE;
+            }
+        } else {
+            for (s32 y = min_y; y < max_y; y++) {
+                f32* row = transmittance + y*SOFTWARE_TILE_SIZE;
+                for (s32 x = min_x; x < max_x; x++) {
+                    row[x] *= particle->transmittance;
+                }
+            }
+        }
+    }
+
+    SoftwarePixelRect touched;
+    touched.min_x = tile.min_x + touched_min_x;
+    touched.min_y = tile.min_y + touched_min_y;
+    touched.max_x = tile.min_x + touched_max_x;
+    touched.max_y = tile.min_y + touched_max_y;
+
+    // @Note: Blend four pixels at a time, starting on a multiple of four from the tile's edge. Pixels in there that no
+    // particle touched come out the same as they went in, and four of them in a row get skipped.
+    s32 min_x = tile.min_x + ((touched.min_x - tile.min_x) & ~3);
+    u32 count = cast(u32) (touched.max_x - min_x);
+    for (s32 y = touched.min_y; y < touched.max_y; y++) {
+        u32* pixels = framebuffer->pixels + cast(u32) y*framebuffer->pitch + cast(u32) min_x;
+        f32* row_transmittance = transmittance + (y - tile.min_y)*SOFTWARE_TILE_SIZE + (min_x - tile.min_x);
+
+        SOFTWARE_SPAN_TAIL_BEGIN(4);
+        for (u32 pixel_index = 0; pixel_index < count; pixel_index += 4) {
+            u32* dest_pixels = (pixel_index + 4 <= count) ? pixels + pixel_index : tail_buffer;
+            __m128 t = _mm_loadu_ps(row_transmittance + pixel_index);
+            if (!_mm_movemask_ps(_mm_cmplt_ps(t, one))) {
+                continue;
+            }
+
+            SoftwareColor4x color = software_unpack_4x(_mm_loadu_si128(cast(__m128i*) dest_pixels));
+            color.r = _mm_sub_ps(one, _mm_mul_ps(_mm_sub_ps(one, color.r), t));
+            color.g = _mm_sub_ps(one, _mm_mul_ps(_mm_sub_ps(one, color.g), t));
+            color.b = _mm_sub_ps(one, _mm_mul_ps(_mm_sub_ps(one, color.b), t));
+            color.a = _mm_sub_ps(one, _mm_mul_ps(_mm_sub_ps(one, color.a), t));
+            _mm_storeu_si128(cast(__m128i*) dest_pixels, software_pack_4x(color));
+        }
+        SOFTWARE_SPAN_TAIL_END;
+    }
+}
+
+internal void software_render_tile(SoftwareRenderer* renderer, u32 tile_index) {
+    SoftwareFramebuffer* framebuffer = &renderer->framebuffer;
+
+    u32 tile_x = tile_index % renderer->tile_count_x;
+    u32 tile_y = tile_index / renderer->tile_count_x;
+
+    SoftwarePixelRect tile;
+    tile.min_x = cast(s32) (tile_x*SOFTWARE_TILE_SIZE);
+    tile.min_y = cast(s32) (tile_y*SOFTWARE_TILE_SIZE);
+    tile.max_x = cast(s32) MIN((tile_x + 1)*SOFTWARE_TILE_SIZE, framebuffer->width);
+    tile.max_y = cast(s32) MIN((tile_y + 1)*SOFTWARE_TILE_SIZE, framebuffer->height);
+
+    for (u32 bin_index = renderer->tile_bin_offsets[tile_index]; bin_index < renderer->tile_bin_offsets[tile_index + 1]; bin_index++) {
+        SoftwarePrimitive* primitive = renderer->primitives + renderer->tile_bins[bin_index];
+
+        switch (primitive->type) {
+            case SoftwarePrimitive_Clear: {
+                u32 clear_pixel = software_pack_pixel(primitive->color);
+                for (s32 y = tile.min_y; y < tile.max_y; y++) {
+                    u32* row = framebuffer->pixels + cast(u32) y*framebuffer->pitch;
+                    for (s32 x = tile.min_x; x < tile.max_x; x++) {
+                        row[x] = clear_pixel;
+                    }
+                }
+            } break;
+
+            case SoftwarePrimitive_Rectangle: {
+                s32 min_x = software_pixel_edge(primitive->p[0].x, tile.min_x, tile.max_x);
+                s32 min_y = software_pixel_edge(primitive->p[0].y, tile.min_y, tile.max_y);
+                s32 max_x = software_pixel_edge(primitive->p[1].x, tile.min_x, tile.max_x);
+                s32 max_y = software_pixel_edge(primitive->p[1].y, tile.min_y, tile.max_y);
+                if (min_x < max_x) {
+                    for (s32 y = min_y; y < max_y; y++) {
+                        u32* row = framebuffer->pixels + cast(u32) y*framebuffer->pitch + cast(u32) min_x;
+                        software_span_kernels.fill(row, cast(u32) (max_x - min_x), primitive->color);
+                    }
+                }
+            } break;
+
+            case SoftwarePrimitive_Triangle:
+            case SoftwarePrimitive_TexturedTriangle: {
+                software_rasterize_triangle(framebuffer, primitive, tile);
+            } break;
+
+            case SoftwarePrimitive_Particles: {
+                software_render_particles(framebuffer, primitive->particle_bins, tile_index, tile);
+            } break;
+
+            INVALID_DEFAULT_CASE;
+        }
+    }
+}
+
+// @Note: Can be called from any number of threads at once after software_begin_render. Every call helps bin the
+// particles first, then keeps taking tiles until there are none left, and returns how many it did.
+internal u32 software_render_tiles(SoftwareRenderer* renderer) {
+    software_bin_particles(renderer);
+
+    u32 result = 0;
+    for (;;) {
+        u32 tile_index = atomic_add_u32(&renderer->next_tile, 1);
+        if (tile_index >= renderer->tile_count) {
+            break;
+        }
+
+        software_render_tile(renderer, tile_index);
+        atomic_add_u32(&renderer->tiles_done, 1);
+        result++;
+    }
+    return result;
+}
+
+inline b32 software_render_is_done(SoftwareRenderer* renderer) {
+    b32 result = (renderer->tiles_done == renderer->tile_count);
+    return result;
+}
+
+// @Note: Renders everything on the calling thread. Returns how many primitives it took.
+internal u32 software_render_commands(SoftwareRenderer* renderer, SoftwareFramebuffer framebuffer, GameRenderCommands* commands, MemoryArena* arena) {
+    software_begin_render(renderer, framebuffer, commands, arena);
+    software_render_tiles(renderer);
+    assert(software_render_is_done(renderer));
+    return renderer->primitive_count;
+}
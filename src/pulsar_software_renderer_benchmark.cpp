@@ -0,0 +1,384 @@
+#include <windows.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <assert.h>
+
+#include "pulsar_common.h"
+#include "pulsar_platform_bridge.h"
+#include "pulsar_sort.cpp"
+#include "pulsar_template_hash_table.h"
+
+#include "pulsar_shapes.h"
+#include "pulsar_render_commands.h"
+#include "pulsar_triangulation.h"
+#include "pulsar_triangulation.cpp"
+#include "pulsar_render_commands.cpp"
+
+#include "pulsar_software_renderer.h"
+#include "pulsar_software_renderer.cpp"
+
+// @Note: Renders a made up but busy frame at 1920x1080 with the software renderer: a clear, a few thousand shapes of
+// every kind and mode, textured images and a large particle system. Before timing anything, the frame is rendered with
+// every set of span kernels on one thread and with every thread on all of them, and the SIMD kernels have to match
+// each other exactly and the scalar ones to within 1 per channel, and the threaded frames have to match the single
+// threaded ones exactly. Then the frame is timed from 1 thread up to one per core.
+//
+// Usage: pulsar_software_renderer_benchmark [-out frame.bmp]
+
+#define BENCHMARK_WIDTH 1920
+#define BENCHMARK_HEIGHT 1080
+#define BENCHMARK_SHAPE_COUNT 4000
+#define BENCHMARK_IMAGE_COUNT 200
+#define BENCHMARK_PARTICLE_COUNT (1 << 20)
+#define BENCHMARK_RUNS 10
+
+global s64 perf_count_frequency;
+
+inline LARGE_INTEGER win32_get_clock() {
+    LARGE_INTEGER result;
+    QueryPerformanceCounter(&result);
+    return result;
+}
+
+inline f64 win32_get_seconds_elapsed(LARGE_INTEGER start, LARGE_INTEGER end) {
+    f64 result = cast(f64) (end.QuadPart - start.QuadPart) / cast(f64) perf_count_frequency;
+    return result;
+}
+
+inline void win32_initialize_perf_counter() {
+    LARGE_INTEGER perf_count_frequency_result;
+    QueryPerformanceFrequency(&perf_count_frequency_result);
+    perf_count_frequency = perf_count_frequency_result.QuadPart;
+}
+
+global RandomSeries random_series = { 0x12345678 };
+
+//
+// Scene
+//
+
+internal void build_scene(GameRenderCommands* commands, MemoryArena* arena, Image* images, ParticleSystem* particles) {
+    commands->sort_entry_count = 0;
+    commands->first_command = commands->command_buffer_size;
+
+    RenderContext render_context;
+    initialize_render_context(&render_context, commands, 1.0f);
+    render_screenspace(&render_context);
+
+    push_clear(&render_context, vec4(0.1f, 0.1f, 0.15f, 1.0f));
+
+    v2 screen_dim = vec2(BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+    for (u32 shape_index = 0; shape_index < BENCHMARK_SHAPE_COUNT; shape_index++) {
+        Transform2D transform = transform2d(vec2(random_unilateral(&random_series)*screen_dim.x, random_unilateral(&random_series)*screen_dim.y));
+        f32 angle = (shape_index % 3) ? random_range(&random_series, 0.0f, TAU_32) : 0.0f;
+        transform.rotation_arm = vec2(cos(angle), sin(angle));
+
+        v4 color = vec4(random_unilateral(&random_series), random_unilateral(&random_series), random_unilateral(&random_series), random_range(&random_series, 0.25f, 1.0f));
+        ShapeRenderMode render_mode = (shape_index % 4 == 3) ? ShapeRenderMode_Outline : ShapeRenderMode_Fill;
+        f32 sort_key = cast(f32) (random_u32(&random_series) % 8);
+
+        switch (shape_index % 5) {
+            case 0:
+            case 1: {
+                push_shape(&render_context, transform, rectangle(vec2(random_range(&random_series, 4.0f, 120.0f), random_range(&random_series, 4.0f, 120.0f))), color, render_mode, sort_key);
+            } break;
+
+            case 2: {
+                push_shape(&render_context, transform, circle(random_range(&random_series, 2.0f, 60.0f)), color, render_mode, sort_key);
+            } break;
+
+            case 3: {
+                u32 vert_count = 3 + random_u32(&random_series) % 6;
+                v2* vertices = push_array(arena, vert_count, v2, no_clear());
+                f32 radius = random_range(&random_series, 4.0f, 80.0f);
+                for (u32 vertex_index = 0; vertex_index < vert_count; vertex_index++) {
+                    f32 vertex_angle = TAU_32*cast(f32) vertex_index / cast(f32) vert_count;
+                    vertices[vertex_index] = radius*vec2(cos(vertex_angle), sin(vertex_angle));
+                }
+                push_polygon(&render_context, transform, vert_count, vertices, color, render_mode, sort_key);
+            } break;
+
+            case 4: {
+                v2 end_p = transform.offset + vec2(random_range(&random_series, -200.0f, 200.0f), random_range(&random_series, -200.0f, 200.0f));
+                push_line(&render_context, transform.offset, end_p, color, sort_key);
+            } break;
+        }
+    }
+
+    for (u32 image_index = 0; image_index < BENCHMARK_IMAGE_COUNT; image_index++) {
+        Image* image = images + (image_index % 2);
+        Transform2D transform = transform2d(vec2(random_unilateral(&random_series)*screen_dim.x, random_unilateral(&random_series)*screen_dim.y), vec2(1, 1)*random_range(&random_series, 16.0f, 256.0f));
+        f32 angle = (image_index % 2) ? random_range(&random_series, 0.0f, TAU_32) : 0.0f;
+        transform.rotation_arm = vec2(cos(angle), sin(angle));
+        push_image(&render_context, transform, image, vec4(1, 1, 1, random_range(&random_series, 0.5f, 1.0f)), 4.0f);
+    }
+
+    push_particle_system(&render_context, transform2d(0.5f*screen_dim, vec2(8.0f, 8.0f)), particles, 8.0f);
+
+    SortEntry* sort_temp_space = push_array(arena, commands->sort_entry_count, SortEntry, no_clear());
+    sort_entries(commands->sort_entry_count, cast(SortEntry*) commands->command_buffer, sort_temp_space);
+}
+
+//
+// Threads
+//
+
+struct BenchmarkWorkers {
+    SoftwareRenderer* renderer;
+    HANDLE semaphore;
+    u32 worker_count;
+    u32 volatile workers_finished;
+};
+
+internal DWORD WINAPI benchmark_worker_thread_proc(LPVOID parameter) {
+    BenchmarkWorkers* workers = cast(BenchmarkWorkers*) parameter;
+    for (;;) {
+        WaitForSingleObject(workers->semaphore, INFINITE);
+        software_render_tiles(workers->renderer);
+        atomic_add_u32(&workers->workers_finished, 1);
+    }
+}
+
+// @Note: Renders the frame on the calling thread plus worker_count workers
+internal void render_frame(BenchmarkWorkers* workers, u32 worker_count, SoftwareFramebuffer framebuffer, GameRenderCommands* commands, MemoryArena* arena, f64* out_begin_seconds, f64* out_total_seconds) {
+    TemporaryMemory temp = begin_temporary_memory(arena);
+
+    LARGE_INTEGER start = win32_get_clock();
+    software_begin_render(workers->renderer, framebuffer, commands, arena);
+    LARGE_INTEGER binned = win32_get_clock();
+
+    workers->workers_finished = 0;
+    if (worker_count) {
+        ReleaseSemaphore(workers->semaphore, worker_count, 0);
+    }
+
+    software_render_tiles(workers->renderer);
+    while (!software_render_is_done(workers->renderer) || workers->workers_finished != worker_count) {
+        _mm_pause();
+    }
+    LARGE_INTEGER end = win32_get_clock();
+
+    end_temporary_memory(temp);
+
+    if (out_begin_seconds) *out_begin_seconds = win32_get_seconds_elapsed(start, binned);
+    if (out_total_seconds) *out_total_seconds = win32_get_seconds_elapsed(start, end);
+}
+
+//
+// Validation
+//
+
+internal u32 max_channel_difference(u32 pixel_count, u32* a, u32* b, u32* out_differing_pixels) {
+    u32 result = 0;
+    u32 differing_pixels = 0;
+    for (u32 pixel_index = 0; pixel_index < pixel_count; pixel_index++) {
+        u32 pixel_difference = 0;
+        for (u32 shift = 0; shift < 32; shift += 8) {
+            s32 channel_a = cast(s32) ((a[pixel_index] >> shift) & 0xFF);
+            s32 channel_b = cast(s32) ((b[pixel_index] >> shift) & 0xFF);
+            pixel_difference = MAX(pixel_difference, cast(u32) abs(channel_a - channel_b));
+        }
+        differing_pixels += (pixel_difference != 0);
+        result = MAX(result, pixel_difference);
+    }
+    *out_differing_pixels = differing_pixels;
+    return result;
+}
+
+internal b32 write_bmp(char* file_name, SoftwareFramebuffer framebuffer) {
+    FILE* file = fopen(file_name, "wb");
+    if (!file) {
+        return false;
+    }
+
+    u32 pixel_size = sizeof(u32)*framebuffer.pitch*framebuffer.height;
+
+    BITMAPFILEHEADER file_header = {};
+    file_header.bfType = 0x4D42;
+    file_header.bfOffBits = sizeof(BITMAPFILEHEADER) + sizeof(BITMAPINFOHEADER);
+    file_header.bfSize = file_header.bfOffBits + pixel_size;
+
+    BITMAPINFOHEADER info_header = {};
+    info_header.biSize = sizeof(info_header);
+    info_header.biWidth = cast(LONG) framebuffer.pitch;
+    info_header.biHeight = cast(LONG) framebuffer.height;
+    info_header.biPlanes = 1;
+    info_header.biBitCount = 32;
+    info_header.biCompression = BI_RGB;
+
+    fwrite(&file_header, sizeof(file_header), 1, file);
+    fwrite(&info_header, sizeof(info_header), 1, file);
+    fwrite(framebuffer.pixels, pixel_size, 1, file);
+    fclose(file);
+
+    return true;
+}
+
+int main(int argument_count, char** arguments) {
+    win32_initialize_perf_counter();
+    initialize_memory_kernels();
+
+    char* bmp_file_name = 0;
+    for (int argument_index = 1; argument_index + 1 < argument_count; argument_index += 2) {
+        String argument = wrap_cstr(arguments[argument_index]);
+        if (strings_are_equal(argument, string_literal("-out"))) {
+            bmp_file_name = arguments[argument_index + 1];
+        } else {
+            fprintf(stderr, "Unknown argument '%s'\n", arguments[argument_index]);
+            return 1;
+        }
+    }
+
+    size_t arena_size = MEGABYTES(512);
+    MemoryArena arena;
+    initialize_arena(&arena, arena_size, _aligned_malloc(arena_size, 64));
+
+    GameRenderCommands commands = {};
+    commands.width = BENCHMARK_WIDTH;
+    commands.height = BENCHMARK_HEIGHT;
+    commands.command_buffer_size = MEGABYTES(16);
+    commands.command_buffer = push_array(&arena, commands.command_buffer_size, u8, no_clear());
+    commands.frame_arena = &arena;
+
+    // @Note: A checkerboard with a transparent and an opaque color, premultiplied like the packer's, and a gradient
+    // that isn't a power of two wide
+    Image images[2] = {};
+    u32 image_sizes[2][2] = { { 64, 64 }, { 37, 21 } };
+    for (u32 image_index = 0; image_index < ARRAY_COUNT(images); image_index++) {
+        Image* image = images + image_index;
+        image->w = image_sizes[image_index][0];
+        image->h = image_sizes[image_index][1];
+        image->align = vec2(0.5f, 0.5f);
+        image->scale = vec2(1, 1);
+        image->pixel_format = PixelFormat_BGRA8;
+
+        u32* texels = push_array(&arena, image->w*image->h, u32, no_clear());
+        for (u32 y = 0; y < image->h; y++) {
+            for (u32 x = 0; x < image->w; x++) {
+                u32 texel;
+                if (image_index == 0) {
+                    texel = ((x / 8 + y / 8) & 1) ? 0xFF20C040 : 0x80404040;
+                } else {
+                    u32 r = 255*x / image->w;
+                    u32 a = 255*y / image->h;
+                    texel = (a << 24) | ((r*a / 255) << 16) | ((a / 2) << 8);
+                }
+                texels[y*image->w + x] = texel;
+            }
+        }
+        image->pixels = texels;
+    }
+
+    // @Note: Particle systems have to be on the frame arena, which is the arena here
+    ParticleSystem* particles = push_struct(&arena, ParticleSystem);
+    particles->count = BENCHMARK_PARTICLE_COUNT;
+    particles->half_size = 0.1f;
+    particles->bounds = aab_min_max(vec2(-120.0f, -67.0f), vec2(120.0f, 67.0f));
+    particles->x = push_array(&arena, particles->count, f32, align_no_clear(16));
+    particles->y = push_array(&arena, particles->count, f32, align_no_clear(16));
+    particles->alpha = push_array(&arena, particles->count, f32, align_no_clear(16));
+    for (u32 particle_index = 0; particle_index < particles->count; particle_index++) {
+        particles->x[particle_index] = random_range(&random_series, -120.0f, 120.0f);
+        particles->y[particle_index] = random_range(&random_series, -67.0f, 67.0f);
+        particles->alpha[particle_index] = random_unilateral(&random_series);
+    }
+
+    build_scene(&commands, &arena, images, particles);
+
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    u32 max_thread_count = MAX(1, cast(u32) system_info.dwNumberOfProcessors);
+
+    SoftwareRenderer renderer = {};
+    BenchmarkWorkers workers = {};
+    workers.renderer = &renderer;
+    workers.semaphore = CreateSemaphoreA(0, 0, max_thread_count, 0);
+    for (u32 worker_index = 0; worker_index + 1 < max_thread_count; worker_index++) {
+        CloseHandle(CreateThread(0, 0, benchmark_worker_thread_proc, &workers, 0, 0));
+        workers.worker_count++;
+    }
+
+    u32 pixel_count = BENCHMARK_WIDTH*BENCHMARK_HEIGHT;
+    SoftwareFramebuffer framebuffers[4];
+    for (u32 framebuffer_index = 0; framebuffer_index < ARRAY_COUNT(framebuffers); framebuffer_index++) {
+        SoftwareFramebuffer* framebuffer = framebuffers + framebuffer_index;
+        framebuffer->width = BENCHMARK_WIDTH;
+        framebuffer->height = BENCHMARK_HEIGHT;
+        framebuffer->pitch = BENCHMARK_WIDTH;
+        framebuffer->pixels = push_array(&arena, pixel_count, u32);
+    }
+
+    SoftwareSpanKernels kernel_sets[] = {
+        { software_fill_span_scalar, software_texture_span_scalar, "scalar" },
+        { software_fill_span_sse2,   software_texture_span_sse2,   "SSE2"   },
+        { software_fill_span_avx2,   software_texture_span_avx2,   "AVX2"   },
+    };
+    u32 kernel_set_count = cpu_supports_avx2() ? 3 : 2;
+
+    for (u32 kernel_set_index = 0; kernel_set_index < kernel_set_count; kernel_set_index++) {
+        software_span_kernels = kernel_sets[kernel_set_index];
+        render_frame(&workers, 0, framebuffers[kernel_set_index], &commands, &arena, 0, 0);
+    }
+
+    u32 differing_pixels;
+    u32 scalar_difference = max_channel_difference(pixel_count, framebuffers[0].pixels, framebuffers[1].pixels, &differing_pixels);
+    if (scalar_difference > 1) {
+        fprintf(stderr, "The SSE2 kernels are off from the scalar ones by up to %u in %u pixels\n", scalar_difference, differing_pixels);
+        return 1;
+    }
+
+    if (kernel_set_count > 2 && max_channel_difference(pixel_count, framebuffers[1].pixels, framebuffers[2].pixels, &differing_pixels)) {
+        fprintf(stderr, "The AVX2 kernels don't match the SSE2 ones in %u pixels\n", differing_pixels);
+        return 1;
+    }
+
+    initialize_software_span_kernels();
+    render_frame(&workers, workers.worker_count, framebuffers[3], &commands, &arena, 0, 0);
+    if (max_channel_difference(pixel_count, framebuffers[kernel_set_count - 1].pixels, framebuffers[3].pixels, &differing_pixels)) {
+        fprintf(stderr, "Rendering on %u threads doesn't match rendering on one in %u pixels\n", max_thread_count, differing_pixels);
+        return 1;
+    }
+
+    if (bmp_file_name) {
+        if (!write_bmp(bmp_file_name, framebuffers[3])) {
+            fprintf(stderr, "Could not write '%s'\n", bmp_file_name);
+            return 1;
+        }
+    }
+
+    fprintf(stdout, "%ux%u, %u render commands, %u primitives, %u tiles\n", BENCHMARK_WIDTH, BENCHMARK_HEIGHT, commands.sort_entry_count, renderer.primitive_count, renderer.tile_count);
+    fprintf(stdout, "Milliseconds per frame, best of %u\n\n", BENCHMARK_RUNS);
+    fprintf(stdout, "%8s%10s%12s%12s%10s\n", "threads", "kernels", "bin", "total", "speedup");
+
+    for (u32 kernel_set_index = 0; kernel_set_index < kernel_set_count; kernel_set_index++) {
+        software_span_kernels = kernel_sets[kernel_set_index];
+
+        f64 single_thread_seconds = 0.0;
+        u32 thread_count = 1;
+        for (;;) {
+            f64 best_begin_seconds = DBL_MAX;
+            f64 best_total_seconds = DBL_MAX;
+            for (u32 run = 0; run < BENCHMARK_RUNS; run++) {
+                f64 begin_seconds, total_seconds;
+                render_frame(&workers, thread_count - 1, framebuffers[0], &commands, &arena, &begin_seconds, &total_seconds);
+                best_begin_seconds = MIN(best_begin_seconds, begin_seconds);
+                best_total_seconds = MIN(best_total_seconds, total_seconds);
+            }
+
+            if (thread_count == 1) {
+                single_thread_seconds = best_total_seconds;
+            }
+
+            fprintf(stdout, "%8u%10s%12.2f%12.2f%9.2fx\n", thread_count, software_span_kernels.name, 1000.0*best_begin_seconds, 1000.0*best_total_seconds, single_thread_seconds / best_total_seconds);
+
+            if (thread_count == max_thread_count) {
+                break;
+            }
+            thread_count = MIN(2*thread_count, max_thread_count);
+        }
+    }
+
+    return 0;
+}
@@ -1,7 +1,9 @@
 // @Note: Copied straight from Handmade Hero
 
+// @Note: Sort keys are plain 64-bit integers. Use sort_key_from_f32 to sort by a float, which lands in the top 32 bits
+// and leaves the bottom 32 bits for breaking ties, see render_sort_key.
 struct SortEntry {
-    f32 sort_key;
+    u64 sort_key;
     u32 index;
 };
 
@@ -15,6 +17,11 @@ inline u32 sort_key_to_u32(f32 sort_key) {
     return result;
 }
 
+inline u64 sort_key_from_f32(f32 sort_key) {
+    u64 result = cast(u64) sort_key_to_u32(sort_key) << 32;
+    return result;
+}
+
 inline void swap(SortEntry* a, SortEntry* b) {
     SortEntry swap = *b;
     *b = *a;
@@ -39,6 +46,18 @@ inline void bubble_sort(u32 count, SortEntry* first) {
     }
 }
 
+inline void insertion_sort(u32 count, SortEntry* first) {
+    for (u32 index = 1; index < count; index++) {
+        SortEntry entry = first[index];
+        u32 insert_index = index;
+        while (insert_index > 0 && first[insert_index - 1].sort_key > entry.sort_key) {
+            first[insert_index] = first[insert_index - 1];
+            insert_index--;
+        }
+        first[insert_index] = entry;
+    }
+}
+
 internal void merge_sort(u32 count, SortEntry* first, SortEntry* temp) {
     if (count == 1) {
         // NOTE: No work to do.
@@ -71,10 +90,11 @@ internal void merge_sort(u32 count, SortEntry* first, SortEntry* temp) {
                 *out++ = *read_half1++;
             } else if (read_half1 == end) {
                 *out++ = *read_half0++;
-            } else if (read_half0->sort_key < read_half1->sort_key) {
-                *out++ = *read_half0++;
-            } else {
+            } else if (read_half1->sort_key < read_half0->sort_key) {
+                // @Note: Only take from the second half when it's strictly smaller, so equal keys keep their order
                 *out++ = *read_half1++;
+            } else {
+                *out++ = *read_half0++;
             }
         }
         assert(out == (temp + count));
@@ -88,36 +108,325 @@ internal void merge_sort(u32 count, SortEntry* first, SortEntry* temp) {
     }
 }
 
+// @Note: Radix sort digit width. 11-bit digits sort a 64-bit key in six passes instead of eight, at the cost of 8KB
+// histograms instead of 1KB ones. They were faster at every size measured, from 1e3 to 1e7 entries. Define this as 8
+// to go back to byte digits.
+#ifndef RADIX_SORT_DIGIT_BITS
+#define RADIX_SORT_DIGIT_BITS 11
+#endif
+
+#define RADIX_SORT_DIGIT_COUNT ((64 + RADIX_SORT_DIGIT_BITS - 1) / RADIX_SORT_DIGIT_BITS)
+#define RADIX_SORT_BUCKET_COUNT (1 << RADIX_SORT_DIGIT_BITS)
+#define RADIX_SORT_DIGIT_MASK (RADIX_SORT_BUCKET_COUNT - 1)
+
+// @Note: How far ahead the scatter prefetches its write targets, and from how many entries on it bothers. Below that,
+// both buffers sit in L2 anyway.
+#define RADIX_SORT_PREFETCH_DISTANCE 16
+#define RADIX_SORT_PREFETCH_MIN_COUNT 65536
+
+inline u32 get_radix_digit(u64 sort_key, u32 digit_index) {
+    u32 result = cast(u32) (sort_key >> (digit_index*RADIX_SORT_DIGIT_BITS)) & RADIX_SORT_DIGIT_MASK;
+    return result;
+}
+
+// @Note: Sorts first, using temp as scratch space for count entries. All the histograms get built in a single read, and
+// passes for digits that all keys share are skipped. That's most of them for render commands, whose layers mostly come
+// from a handful of values and whose texture ids only use the low bits.
 internal void radix_sort(u32 count, SortEntry* first, SortEntry* temp) {
+    if (count < 2) {
+        return;
+    }
+
+    u32 offsets[RADIX_SORT_DIGIT_COUNT][RADIX_SORT_BUCKET_COUNT] = {};
+
+    // NOTE: First pass - count how many of each digit, for all digits at once
+    for (u32 index = 0; index < count; index++) {
+        u64 sort_key = first[index].sort_key;
+        for (u32 digit_index = 0; digit_index < RADIX_SORT_DIGIT_COUNT; digit_index++) {
+            offsets[digit_index][get_radix_digit(sort_key, digit_index)]++;
+        }
+    }
+
     SortEntry* source = first;
     SortEntry* dest = temp;
-    for (u32 byte_index = 0; byte_index < 32; byte_index += 8) {
-        u32 sort_key_offsets[256] = {};
+    u64 first_sort_key = first->sort_key;
+    for (u32 digit_index = 0; digit_index < RADIX_SORT_DIGIT_COUNT; digit_index++) {
+        u32* digit_offsets = offsets[digit_index];
 
-        // NOTE: First pass - count how many of each key
-        for (u32 index = 0; index < count; index++) {
-            u32 radix_value = sort_key_to_u32(source[index].sort_key);
-            u32 radix_piece = (radix_value >> byte_index) & 0xFF;
-            sort_key_offsets[radix_piece]++;
+        // NOTE: A digit only needs a pass if the keys don't all share it
+        if (digit_offsets[get_radix_digit(first_sort_key, digit_index)] == count) {
+            continue;
         }
 
         // NOTE: Convert counts to offsets
         u32 total = 0;
-        for (u32 sort_key_index = 0; sort_key_index < ARRAY_COUNT(sort_key_offsets); sort_key_index++) {
-            u32 piece_count = sort_key_offsets[sort_key_index];
-            sort_key_offsets[sort_key_index] = total;
+        for (u32 bucket_index = 0; bucket_index < RADIX_SORT_BUCKET_COUNT; bucket_index++) {
+            u32 piece_count = digit_offsets[bucket_index];
+            digit_offsets[bucket_index] = total;
             total += piece_count;
         }
 
         // NOTE: Second pass - place elements into the right location
+        b32 prefetch = (count >= RADIX_SORT_PREFETCH_MIN_COUNT);
         for (u32 index = 0; index < count; index++) {
-            u32 radix_value = sort_key_to_u32(source[index].sort_key);
-            u32 radix_piece = (radix_value >> byte_index) & 0xFF;
-            dest[sort_key_offsets[radix_piece]++] = source[index];
+            if (prefetch && index + RADIX_SORT_PREFETCH_DISTANCE < count) {
+                u32 ahead_digit = get_radix_digit(source[index + RADIX_SORT_PREFETCH_DISTANCE].sort_key, digit_index);
+                _mm_prefetch(cast(char*) (dest + digit_offsets[ahead_digit]), _MM_HINT_T0);
+            }
+
+            dest[digit_offsets[get_radix_digit(source[index].sort_key, digit_index)]++] = source[index];
         }
 
         SortEntry* swap_temp = dest;
         dest = source;
         source = swap_temp;
     }
+
+    if (source != first) {
+        copy(sizeof(SortEntry)*count, source, first);
+    }
+}
+
+inline b32 sort_entry_is_less(SortEntry* a, SortEntry* b, b32 break_ties_by_index) {
+    b32 result = (a->sort_key < b->sort_key) || (break_ties_by_index && a->sort_key == b->sort_key && a->index < b->index);
+    return result;
+}
+
+// @Note: Merges the runs that are already in the input, two at a time, ping-ponging between first and temp. That's
+// log2(run count) passes, so input that's sorted apart from a few spots costs about as much as a couple of copies.
+// It's stable, and with break_ties_by_index equal keys are ordered by index instead of by where they were.
+internal void natural_merge_sort(u32 count, SortEntry* first, SortEntry* temp, b32 break_ties_by_index = false) {
+    SortEntry* source = first;
+    SortEntry* dest = temp;
+
+    for (;;) {
+        u32 run_count = 0;
+
+        u32 start = 0;
+        while (start < count) {
+            u32 middle = start + 1;
+            while (middle < count && !sort_entry_is_less(source + middle, source + middle - 1, break_ties_by_index)) {
+                middle++;
+            }
+
+            u32 end = middle;
+            if (end < count) {
+                end++;
+                while (end < count && !sort_entry_is_less(source + end, source + end - 1, break_ties_by_index)) {
+                    end++;
+                }
+            }
+
+            SortEntry* read_a = source + start;
+            SortEntry* read_b = source + middle;
+            SortEntry* end_a = read_b;
+            SortEntry* end_b = source + end;
+            SortEntry* out = dest + start;
+            while (read_a < end_a && read_b < end_b) {
+                if (sort_entry_is_less(read_b, read_a, break_ties_by_index)) {
+                    *out++ = *read_b++;
+                } else {
+                    *out++ = *read_a++;
+                }
+            }
+            while (read_a < end_a) {
+                *out++ = *read_a++;
+            }
+            while (read_b < end_b) {
+                *out++ = *read_b++;
+            }
+
+            run_count++;
+            start = end;
+        }
+
+        SortEntry* swap_temp = dest;
+        dest = source;
+        source = swap_temp;
+
+        if (run_count <= 1) {
+            break;
+        }
+    }
+
+    if (source != first) {
+        copy(sizeof(SortEntry)*count, source, first);
+    }
+}
+
+// @Note: The cutoffs sort_entries picks algorithms by, from pulsar_sort_benchmark. Below a few hundred entries,
+// radix sort spends most of its time clearing and summing its histograms, so insertion sort and then natural merge sort
+// beat it. Past that, natural merge sort only wins when the input is made of so few runs that it needs fewer passes
+// than radix sort does.
+#define SORT_INSERTION_MAX_COUNT 64
+#define SORT_MERGE_MAX_COUNT 256
+#define SORT_NATURAL_MERGE_MAX_RUN_COUNT 16
+
+// @Note: Sorts first by sort key, keeping entries with equal keys in their original order. temp needs room for count
+// entries. One read over the input counts how often the keys go down, which tells sorted and reversed input apart from
+// the rest before picking an algorithm.
+internal void sort_entries(u32 count, SortEntry* first, SortEntry* temp) {
+    if (count < 2) {
+        return;
+    }
+
+    u32 descent_count = 0;
+    for (u32 index = 1; index < count; index++) {
+        descent_count += (first[index - 1].sort_key > first[index].sort_key);
+    }
+
+    if (descent_count == 0) {
+        // NOTE: Already sorted
+    } else if (descent_count == count - 1) {
+        // NOTE: Strictly descending, so there are no equal keys whose order reversing could break
+        for (u32 index = 0; index < count / 2; index++) {
+            swap(first + index, first + count - index - 1);
+        }
+    } else if (count <= SORT_INSERTION_MAX_COUNT) {
+        insertion_sort(count, first);
+    } else if (count <= SORT_MERGE_MAX_COUNT || descent_count < SORT_NATURAL_MERGE_MAX_RUN_COUNT) {
+        natural_merge_sort(count, first, temp);
+    } else {
+        radix_sort(count, first, temp);
+    }
+}
+
+//
+// Frame coherent sorting
+//
+
+// @Note: Remembers the order the last sort put the entries in, as the position each entry came from for every position
+// it ended up at. Things like the render commands come out of a frame in nearly the same order as the frame before, so
+// putting the new entries in last frame's order first leaves only a little work for an adaptive sort. indices holds
+// the caller's indices while the sort runs, since the entries carry their positions in their place.
+struct CoherentSortState {
+    u32 capacity;
+    u32 count;
+    u32* permutation;
+    u32* indices;
+};
+
+inline void initialize_coherent_sort(CoherentSortState* state, u32 capacity, u32* permutation, u32* indices) {
+    state->capacity = capacity;
+    state->count = 0;
+    state->permutation = permutation;
+    state->indices = indices;
+}
+
+// @Note: If more entries than this fraction of the count are out of place in the previous order, it didn't help enough
+// to be worth it and the entries get sorted from scratch instead. Has to be at least 2, so the displaced entries never
+// overlap the spot they get moved to.
+#define COHERENT_SORT_MAX_DISPLACED_FRACTION 8
+
+// @Note: Like sort_entries, but starts from the order the previous call with the same state ended up with. The indices
+// can be anything, render commands use theirs for byte offsets, because entries are matched up with last time's by
+// their position in first. Equal keys keep their order, like a stable sort. Entries that are new since the last call
+// go at the end, and ones that are gone get skipped, so any old permutation is safe to reuse, it only costs the
+// fallback.
+internal void coherent_sort_entries(CoherentSortState* state, u32 count, SortEntry* first, SortEntry* temp) {
+    if (count > state->capacity) {
+        sort_entries(count, first, temp);
+        state->count = 0;
+        return;
+    }
+
+    // NOTE: Swap the indices for positions, which order equal keys the way a stable sort would and say where every
+    // entry came from once it's sorted
+    for (u32 position = 0; position < count; position++) {
+        state->indices[position] = first[position].index;
+        first[position].index = position;
+    }
+
+    b32 sorted = false;
+
+    if (state->count && count >= 2) {
+        // NOTE: Put the entries in last time's order
+        u32 gathered_count = 0;
+        for (u32 position = 0; position < state->count; position++) {
+            u32 source_position = state->permutation[position];
+            if (source_position < count) {
+                temp[gathered_count++] = first[source_position];
+            }
+        }
+        for (u32 position = state->count; position < count; position++) {
+            temp[gathered_count++] = first[position];
+        }
+        assert(gathered_count == count);
+
+        u32 descent_count = 0;
+        for (u32 index = 1; index < count; index++) {
+            descent_count += sort_entry_is_less(temp + index, temp + index - 1, true);
+        }
+
+        u32 max_displaced_count = count / COHERENT_SORT_MAX_DISPLACED_FRACTION;
+        if (descent_count == 0) {
+            copy(sizeof(SortEntry)*count, temp, first);
+            sorted = true;
+        } else if (2*descent_count <= max_displaced_count) {
+            // NOTE: Every descent takes out the entry before it and the one after it, which leaves a sorted run in temp
+            // and the displaced entries in first. A descent can displace a lot more than two entries when the entry
+            // after it is smaller than a long stretch before it, so this gives up past max_displaced_count.
+            u32 kept_count = 0;
+            u32 displaced_count = 0;
+            u32 index = 0;
+            for (; index < count; index++) {
+                if (kept_count && sort_entry_is_less(temp + index, temp + kept_count - 1, true)) {
+                    if (displaced_count + 2 > max_displaced_count) {
+                        break;
+                    }
+                    first[displaced_count++] = temp[--kept_count];
+                    first[displaced_count++] = temp[index];
+                } else {
+                    temp[kept_count++] = temp[index];
+                }
+            }
+            assert(kept_count + displaced_count == index);
+
+            if (index < count) {
+                // NOTE: Gave up, so put the entries back in first where they started out. The displaced ones fill the
+                // gap between the kept ones and the ones that weren't looked at yet.
+                copy(sizeof(SortEntry)*displaced_count, first, temp + kept_count);
+                for (u32 position = 0; position < count; position++) {
+                    first[temp[position].index] = temp[position];
+                }
+            } else {
+                // NOTE: Move the displaced entries to the end of first, sort them using the free end of temp, and merge
+                // them back in from the front. The merge never catches up with the displaced entries it hasn't read
+                // yet. There are at most max_displaced_count of them, so they don't overlap where they came from.
+                SortEntry* displaced = first + kept_count;
+                copy(sizeof(SortEntry)*displaced_count, first, displaced);
+                natural_merge_sort(displaced_count, displaced, temp + kept_count, true);
+
+                SortEntry* read_kept = temp;
+                SortEntry* end_kept = temp + kept_count;
+                SortEntry* read_displaced = displaced;
+                SortEntry* end_displaced = first + count;
+                SortEntry* out = first;
+                while (read_kept < end_kept && read_displaced < end_displaced) {
+                    if (sort_entry_is_less(read_displaced, read_kept, true)) {
+                        *out++ = *read_displaced++;
+                    } else {
+                        *out++ = *read_kept++;
+                    }
+                }
+                while (read_kept < end_kept) {
+                    *out++ = *read_kept++;
+                }
+                assert(out == read_displaced);
+
+                sorted = true;
+            }
+        }
+    }
+
+    if (!sorted) {
+        sort_entries(count, first, temp);
+    }
+
+    for (u32 position = 0; position < count; position++) {
+        u32 source_position = first[position].index;
+        state->permutation[position] = source_position;
+        first[position].index = state->indices[source_position];
+    }
+    state->count = count;
 }
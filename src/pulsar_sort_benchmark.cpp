@@ -0,0 +1,441 @@
+#include <windows.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <assert.h>
+
+#include "pulsar_common.h"
+#include "pulsar_sort.cpp"
+
+// @Note: Measures every sort in pulsar_sort.cpp, plus the sort_entries dispatch, from 1e2 to 1e7 entries over a handful
+// of key distributions. The render distribution is a frame's worth of render command sort keys as dumped by the
+// capture_sort_keys console command, repeated to fill the count. Without a capture it falls back to made up keys shaped
+// like render_sort_key's. Every result is checked for being sorted and stable, the table goes to stdout and the same
+// numbers go to a JSON file for plotting.
+// Last, a sequence of frames of render keys that change a little from one frame to the next is sorted from scratch
+// with sort_entries and incrementally with coherent_sort_entries, once with indices that are the entries' positions and
+// once with indices spaced out like the command buffer offsets render commands use. Before that, coherent_sort_entries
+// gets checked on a frame where one descent displaces most of the entries.
+//
+// Usage: pulsar_sort_benchmark [-keys sort_keys.bin] [-json sort_benchmark.json]
+
+#define BENCHMARK_MIN_COUNT 100
+#define BENCHMARK_MAX_COUNT 10000000
+#define BENCHMARK_ENTRIES_PER_RUN 1000000
+#define BENCHMARK_RUNS 3
+
+// @Note: The quadratic sorts are only timed up to here, past it a single run takes minutes
+#define BENCHMARK_QUADRATIC_MAX_COUNT 10000
+
+// @Note: The frame sequence changes this fraction of the render keys every frame
+#define BENCHMARK_FRAME_COUNT 60
+#define BENCHMARK_FRAME_CHANGED_FRACTION 200
+
+// @Note: Roughly how far apart render commands are in the command buffer
+#define BENCHMARK_COMMAND_STRIDE 48
+
+global s64 perf_count_frequency;
+
+inline LARGE_INTEGER win32_get_clock() {
+    LARGE_INTEGER result;
+    QueryPerformanceCounter(&result);
+    return result;
+}
+
+inline f64 win32_get_seconds_elapsed(LARGE_INTEGER start, LARGE_INTEGER end) {
+    f64 result = cast(f64) (end.QuadPart - start.QuadPart) / cast(f64) perf_count_frequency;
+    return result;
+}
+
+inline void win32_initialize_perf_counter() {
+    LARGE_INTEGER perf_count_frequency_result;
+    QueryPerformanceFrequency(&perf_count_frequency_result);
+    perf_count_frequency = perf_count_frequency_result.QuadPart;
+}
+
+global RandomSeries random_series = { 0x123456789ABCDEFull };
+
+//
+// Sorts
+//
+
+#define BENCHMARK_SORT(name) void name(u32 count, SortEntry* first, SortEntry* temp)
+typedef BENCHMARK_SORT(BenchmarkSortFunction);
+
+internal BENCHMARK_SORT(benchmark_bubble_sort)         { bubble_sort(count, first); }
+internal BENCHMARK_SORT(benchmark_insertion_sort)      { insertion_sort(count, first); }
+internal BENCHMARK_SORT(benchmark_merge_sort)          { merge_sort(count, first, temp); }
+internal BENCHMARK_SORT(benchmark_natural_merge_sort)  { natural_merge_sort(count, first, temp); }
+internal BENCHMARK_SORT(benchmark_radix_sort)          { radix_sort(count, first, temp); }
+internal BENCHMARK_SORT(benchmark_sort_entries)        { sort_entries(count, first, temp); }
+
+struct BenchmarkSort {
+    char* name;
+    BenchmarkSortFunction* sort;
+    b32 quadratic;
+};
+
+global BenchmarkSort benchmark_sorts[] = {
+    { "bubble",         benchmark_bubble_sort,        true  },
+    { "insertion",      benchmark_insertion_sort,     true  },
+    { "merge",          benchmark_merge_sort,         false },
+    { "natural_merge",  benchmark_natural_merge_sort, false },
+    { "radix",          benchmark_radix_sort,         false },
+    { "sort_entries",   benchmark_sort_entries,       false },
+};
+
+//
+// Key distributions
+//
+
+enum BenchmarkDistribution {
+    Distribution_Uniform,
+    Distribution_FewDistinct,
+    Distribution_Sorted,
+    Distribution_NearlySorted,
+    Distribution_Reverse,
+    Distribution_Render,
+
+    Distribution_Count,
+};
+
+global char* distribution_names[Distribution_Count] = {
+    "uniform",
+    "few_distinct",
+    "sorted",
+    "nearly_sorted",
+    "reverse",
+    "render",
+};
+
+struct CapturedKeys {
+    u32 count;
+    u64* keys;
+};
+
+internal CapturedKeys load_captured_keys(char* file_name) {
+    CapturedKeys result = {};
+
+    FILE* file = fopen(file_name, "rb");
+    if (file) {
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        result.count = cast(u32) (size / sizeof(u64));
+        result.keys = cast(u64*) malloc(result.count*sizeof(u64));
+        if (fread(result.keys, sizeof(u64), result.count, file) != result.count) {
+            result.count = 0;
+        }
+
+        fclose(file);
+    }
+
+    return result;
+}
+
+// @Note: Roughly what a frame pushes: long stretches on the same layer, a few command types, a couple hundred textures
+inline u64 make_render_like_key(u32 index) {
+    f32 layers[] = { -1.0f, 0.0f, 0.0f, 0.0f, 100.0f, 1000.0f, 32000.0f, 50000.0f };
+    u32 layer_index = MIN((index / 512) % 11, cast(u32) ARRAY_COUNT(layers) - 1);
+
+    // @Note: Shapes, images and particle systems, of which only images have a texture
+    u64 type = 1 + (random_u64(&random_series) % 3);
+    u64 texture = (type == 2) ? 1 + (random_u64(&random_series) % 200) : 0;
+    u64 result = sort_key_from_f32(layers[layer_index]) | (type << 24) | texture;
+    return result;
+}
+
+internal void fill_distribution(BenchmarkDistribution distribution, u32 count, SortEntry* entries, CapturedKeys* captured) {
+    for (u32 index = 0; index < count; index++) {
+        SortEntry* entry = entries + index;
+        entry->index = index;
+
+        switch (distribution) {
+            case Distribution_Uniform:      { entry->sort_key = random_u64(&random_series); } break;
+            case Distribution_FewDistinct:  { entry->sort_key = random_u64(&random_series) % 16; } break;
+            case Distribution_Sorted:       { entry->sort_key = index; } break;
+            case Distribution_NearlySorted: { entry->sort_key = index; } break;
+            case Distribution_Reverse:      { entry->sort_key = count - index; } break;
+            case Distribution_Render: {
+                entry->sort_key = captured->count ? captured->keys[index % captured->count] : make_render_like_key(index);
+            } break;
+
+            default: { assert(!"Unhandled distribution"); } break;
+        }
+    }
+
+    if (distribution == Distribution_NearlySorted) {
+        // @Note: Swap one percent of the entries with a random other one
+        for (u32 swap_index = 0; swap_index < count / 100; swap_index++) {
+            u32 a = cast(u32) (random_u64(&random_series) % count);
+            u32 b = cast(u32) (random_u64(&random_series) % count);
+            u64 swap_key = entries[a].sort_key;
+            entries[a].sort_key = entries[b].sort_key;
+            entries[b].sort_key = swap_key;
+        }
+    }
+}
+
+//
+// Validation
+//
+
+// @Note: The input's indices are its positions times index_stride
+internal b32 validate_sorted(u32 count, SortEntry* sorted, SortEntry* input, u8* seen, u32 index_stride = 1) {
+    memset(seen, 0, count);
+    for (u32 index = 0; index < count; index++) {
+        SortEntry* entry = sorted + index;
+        u32 position = entry->index / index_stride;
+        if (entry->index % index_stride || position >= count || seen[position] || input[position].sort_key != entry->sort_key) {
+            return false;
+        }
+        seen[position] = true;
+
+        if (index > 0) {
+            SortEntry* prev = entry - 1;
+            if (prev->sort_key > entry->sort_key || (prev->sort_key == entry->sort_key && prev->index > entry->index)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//
+// Timing
+//
+
+// @Note: Small counts are sorted as many back to back copies of the same input, so every run sorts about
+// BENCHMARK_ENTRIES_PER_RUN entries and the timer resolution doesn't matter. Returns the best of BENCHMARK_RUNS in
+// nanoseconds per element, or a negative number if the sort got it wrong.
+internal f64 time_sort(BenchmarkSort* sort, u32 count, SortEntry* input, SortEntry* work, SortEntry* temp, u8* seen) {
+    u32 copy_count = MAX(1, BENCHMARK_ENTRIES_PER_RUN / count);
+
+    f64 best_seconds = DBL_MAX;
+    for (u32 run = 0; run < BENCHMARK_RUNS; run++) {
+        for (u32 copy_index = 0; copy_index < copy_count; copy_index++) {
+            copy(sizeof(SortEntry)*count, input, work + copy_index*count);
+        }
+
+        LARGE_INTEGER start = win32_get_clock();
+        for (u32 copy_index = 0; copy_index < copy_count; copy_index++) {
+            sort->sort(count, work + copy_index*count, temp);
+        }
+        LARGE_INTEGER end = win32_get_clock();
+
+        best_seconds = MIN(best_seconds, win32_get_seconds_elapsed(start, end));
+
+        if (run == 0 && !validate_sorted(count, work, input, seen)) {
+            return -1.0;
+        }
+    }
+
+    f64 result = 1.0e9*best_seconds / (cast(f64) copy_count*cast(f64) count);
+    return result;
+}
+
+// @Note: Sorts BENCHMARK_FRAME_COUNT frames of render keys, changing some of them in between like a frame's worth of
+// moving things would. Returns the average in nanoseconds per element, or a negative number if the sort got it wrong.
+internal f64 time_frames(b32 coherent, u32 index_stride, u32 count, SortEntry* input, SortEntry* work, SortEntry* temp, u8* seen, u32* permutation, u32* indices, CapturedKeys* captured) {
+    random_series = random_seed(0x123456789ABCDEFull);
+    fill_distribution(Distribution_Render, count, input, captured);
+    for (u32 index = 0; index < count; index++) {
+        input[index].index = index*index_stride;
+    }
+
+    CoherentSortState state;
+    initialize_coherent_sort(&state, count, permutation, indices);
+
+    f64 total_seconds = 0.0;
+    for (u32 frame = 0; frame < BENCHMARK_FRAME_COUNT; frame++) {
+        for (u32 change_index = 0; change_index < count / BENCHMARK_FRAME_CHANGED_FRACTION; change_index++) {
+            u32 index = cast(u32) (random_u64(&random_series) % count);
+            input[index].sort_key = captured->count ? captured->keys[random_u64(&random_series) % captured->count] : make_render_like_key(index);
+        }
+        copy(sizeof(SortEntry)*count, input, work);
+
+        LARGE_INTEGER start = win32_get_clock();
+        if (coherent) {
+            coherent_sort_entries(&state, count, work, temp);
+        } else {
+            sort_entries(count, work, temp);
+        }
+        LARGE_INTEGER end = win32_get_clock();
+
+        // @Note: The first frame has nothing to go on yet, so it doesn't count
+        if (frame > 0) {
+            total_seconds += win32_get_seconds_elapsed(start, end);
+        }
+
+        if (!validate_sorted(count, work, input, seen, index_stride)) {
+            return -1.0;
+        }
+    }
+
+    f64 result = 1.0e9*total_seconds / (cast(f64) (BENCHMARK_FRAME_COUNT - 1)*cast(f64) count);
+    return result;
+}
+
+// @Note: Sorts a frame in order, then one whose keys come out of last frame's order as 0, 600..999, 1..599. That's
+// a single descent, but 1 is smaller than everything from 600 on, so it displaces 800 of the 1000 entries.
+internal b32 check_coherent_displacement(SortEntry* input, SortEntry* work, SortEntry* temp, u8* seen, u32* permutation, u32* indices) {
+    u32 count = 1000;
+    u32 split = 400;
+
+    CoherentSortState state;
+    initialize_coherent_sort(&state, count, permutation, indices);
+
+    for (u32 frame = 0; frame < 2; frame++) {
+        for (u32 index = 0; index < count; index++) {
+            SortEntry* entry = input + index;
+            entry->index = index*BENCHMARK_COMMAND_STRIDE;
+            if (frame == 0 || index == 0) {
+                entry->sort_key = index;
+            } else if (index < split) {
+                entry->sort_key = 600 + (index - 1);
+            } else {
+                entry->sort_key = 1 + (index - split);
+            }
+        }
+        copy(sizeof(SortEntry)*count, input, work);
+
+        coherent_sort_entries(&state, count, work, temp);
+        if (!validate_sorted(count, work, input, seen, BENCHMARK_COMMAND_STRIDE)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argument_count, char** arguments) {
+    win32_initialize_perf_counter();
+    initialize_memory_kernels();
+
+    char* keys_file_name = 0;
+    char* json_file_name = "sort_benchmark.json";
+    for (int argument_index = 1; argument_index + 1 < argument_count; argument_index += 2) {
+        String argument = wrap_cstr(arguments[argument_index]);
+        if (strings_are_equal(argument, string_literal("-keys"))) {
+            keys_file_name = arguments[argument_index + 1];
+        } else if (strings_are_equal(argument, string_literal("-json"))) {
+            json_file_name = arguments[argument_index + 1];
+        } else {
+            fprintf(stderr, "Unknown argument '%s'\n", arguments[argument_index]);
+            return 1;
+        }
+    }
+
+    CapturedKeys captured = {};
+    if (keys_file_name) {
+        captured = load_captured_keys(keys_file_name);
+        if (!captured.count) {
+            fprintf(stderr, "Could not read any sort keys from '%s'\n", keys_file_name);
+            return 1;
+        }
+        fprintf(stdout, "Render keys: %u captured keys from '%s'\n\n", captured.count, keys_file_name);
+    } else {
+        fprintf(stdout, "Render keys: made up, pass -keys with a capture_sort_keys dump to use real ones\n\n");
+    }
+
+    size_t work_count = MAX(BENCHMARK_MAX_COUNT, BENCHMARK_ENTRIES_PER_RUN + BENCHMARK_MIN_COUNT);
+    SortEntry* input = cast(SortEntry*) _aligned_malloc(sizeof(SortEntry)*BENCHMARK_MAX_COUNT, 64);
+    SortEntry* work  = cast(SortEntry*) _aligned_malloc(sizeof(SortEntry)*work_count, 64);
+    SortEntry* temp  = cast(SortEntry*) _aligned_malloc(sizeof(SortEntry)*BENCHMARK_MAX_COUNT, 64);
+    u8* seen = cast(u8*) _aligned_malloc(BENCHMARK_MAX_COUNT, 64);
+    u32* permutation = cast(u32*) _aligned_malloc(sizeof(u32)*BENCHMARK_MAX_COUNT, 64);
+    u32* indices = cast(u32*) _aligned_malloc(sizeof(u32)*BENCHMARK_MAX_COUNT, 64);
+
+    FILE* json = fopen(json_file_name, "wb");
+    if (!json) {
+        fprintf(stderr, "Could not open '%s' for writing\n", json_file_name);
+        return 1;
+    }
+    fprintf(json, "{\n    \"render_keys\": \"%s\",\n    \"results\": [\n", keys_file_name ? "captured" : "synthetic");
+    b32 first_json_result = true;
+
+    u32 sort_count = ARRAY_COUNT(benchmark_sorts);
+    for (u32 distribution = 0; distribution < Distribution_Count; distribution++) {
+        fprintf(stdout, "%s (ns/element)\n", distribution_names[distribution]);
+        fprintf(stdout, "%10s", "count");
+        for (u32 sort_index = 0; sort_index < sort_count; sort_index++) {
+            fprintf(stdout, "%15s", benchmark_sorts[sort_index].name);
+        }
+        fprintf(stdout, "\n");
+
+        for (u32 count = BENCHMARK_MIN_COUNT; count <= BENCHMARK_MAX_COUNT; count *= 10) {
+            fill_distribution(cast(BenchmarkDistribution) distribution, count, input, &captured);
+
+            fprintf(stdout, "%10u", count);
+            for (u32 sort_index = 0; sort_index < sort_count; sort_index++) {
+                BenchmarkSort* sort = benchmark_sorts + sort_index;
+                if (sort->quadratic && count > BENCHMARK_QUADRATIC_MAX_COUNT) {
+                    fprintf(stdout, "%15s", "-");
+                    continue;
+                }
+
+                f64 ns_per_element = time_sort(sort, count, input, work, temp, seen);
+                if (ns_per_element < 0.0) {
+                    fprintf(stderr, "\n%s sort got %s keys wrong at count %u\n", sort->name, distribution_names[distribution], count);
+                    return 1;
+                }
+
+                fprintf(stdout, "%15.2f", ns_per_element);
+                fprintf(json, "%s        { \"sort\": \"%s\", \"distribution\": \"%s\", \"count\": %u, \"ns_per_element\": %.3f }",
+                    first_json_result ? "" : ",\n", sort->name, distribution_names[distribution], count, ns_per_element
+                );
+                first_json_result = false;
+            }
+            fprintf(stdout, "\n");
+            fflush(stdout);
+        }
+        fprintf(stdout, "\n");
+    }
+
+    if (!check_coherent_displacement(input, work, temp, seen, permutation, indices)) {
+        fprintf(stderr, "coherent got a frame with one long descent wrong\n");
+        return 1;
+    }
+
+    // @Note: The last column uses command buffer offsets for indices, like the render commands do
+    char* frame_sort_names[] = { "sort_entries", "coherent", "coherent_offsets" };
+    fprintf(stdout, "render frames, %u frames with 1/%u of the keys changing every frame (ns/element)\n", BENCHMARK_FRAME_COUNT, BENCHMARK_FRAME_CHANGED_FRACTION);
+    fprintf(stdout, "%10s%15s%15s%18s\n", "count", frame_sort_names[0], frame_sort_names[1], frame_sort_names[2]);
+    for (u32 count = 1000; count <= BENCHMARK_MAX_COUNT / 10; count *= 10) {
+        fprintf(stdout, "%10u", count);
+        for (u32 frame_sort = 0; frame_sort < ARRAY_COUNT(frame_sort_names); frame_sort++) {
+            b32 coherent = (frame_sort > 0);
+            u32 index_stride = (frame_sort == 2) ? BENCHMARK_COMMAND_STRIDE : 1;
+            f64 ns_per_element = time_frames(coherent, index_stride, count, input, work, temp, seen, permutation, indices, &captured);
+            if (ns_per_element < 0.0) {
+                fprintf(stderr, "\n%s got render frames wrong at count %u\n", frame_sort_names[frame_sort], count);
+                return 1;
+            }
+
+            fprintf(stdout, (frame_sort == 2) ? "%18.2f" : "%15.2f", ns_per_element);
+            fprintf(json, "%s        { \"sort\": \"%s\", \"distribution\": \"render_frames\", \"count\": %u, \"ns_per_element\": %.3f }",
+                first_json_result ? "" : ",\n", frame_sort_names[frame_sort], count, ns_per_element
+            );
+            first_json_result = false;
+        }
+        fprintf(stdout, "\n");
+        fflush(stdout);
+    }
+    fprintf(stdout, "\n");
+
+    fprintf(json, "\n    ]\n}\n");
+    fclose(json);
+
+    fprintf(stdout, "Wrote results to '%s'\n", json_file_name);
+
+    _aligned_free(input);
+    _aligned_free(work);
+    _aligned_free(temp);
+    _aligned_free(seen);
+    _aligned_free(permutation);
+    _aligned_free(indices);
+
+    return 0;
+}
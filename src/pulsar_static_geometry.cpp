@@ -0,0 +1,122 @@
+// @Note: Invisible walls stay dynamic, whether they get drawn at all depends on the editor
+inline b32 is_static_wall(Entity* entity) {
+    b32 result = (entity->type == EntityType_Wall &&
+                  entity->wall_behaviour != WallBehaviour_Move &&
+                  entity->wall_behaviour != WallBehaviour_Toggle &&
+                  !entity->sprite.value &&
+                  !entity->dead &&
+                  !(entity->flags & EntityFlag_Invisible));
+    return result;
+}
+
+inline v2 get_static_geometry_tile_origin(v2 p) {
+    v2 result;
+    result.x = STATIC_GEOMETRY_TILE_SIZE*(cast(f32) floor_f32_to_i32(p.x / STATIC_GEOMETRY_TILE_SIZE) + 0.5f);
+    result.y = STATIC_GEOMETRY_TILE_SIZE*(cast(f32) floor_f32_to_i32(p.y / STATIC_GEOMETRY_TILE_SIZE) + 0.5f);
+    return result;
+}
+
+// @Note: Sorts walls by tile, and inside a tile by whether they're in the camera zone, so every batch is one run of keys
+inline u64 get_static_geometry_sort_key(v2 p, b32 in_camera_zone) {
+    u32 tile_x = cast(u32) (floor_f32_to_i32(p.x / STATIC_GEOMETRY_TILE_SIZE) + (1 << 30)) & 0x7FFFFFFF;
+    u32 tile_y = cast(u32) (floor_f32_to_i32(p.y / STATIC_GEOMETRY_TILE_SIZE) + (1 << 30)) & 0x7FFFFFFF;
+    u64 result = (cast(u64) tile_y << 32) | (cast(u64) tile_x << 1) | (in_camera_zone ? 1 : 0);
+    return result;
+}
+
+internal void bake_static_geometry(StaticGeometry* geometry, Entity* entities, u32 entity_count, Entity* camera_zone, v4 foreground_color) {
+    assert(entity_count <= MAX_ENTITY_COUNT);
+
+    geometry->current_bake = (geometry->current_bake + 1) % ARRAY_COUNT(geometry->bakes);
+    StaticGeometryBake* bake = geometry->bakes + geometry->current_bake;
+    bake->batch_count = 0;
+    bake->dynamic_entity_count = 0;
+
+    TemporaryMemory scratch = get_scratch();
+
+    SortEntry* walls = push_array(scratch.arena, entity_count, SortEntry, no_clear());
+    SortEntry* sort_temp = push_array(scratch.arena, entity_count, SortEntry, no_clear());
+    u32 wall_count = 0;
+
+    for (u32 entity_index = 1; entity_index < entity_count; entity_index++) {
+        Entity* entity = entities + entity_index;
+        if (is_static_wall(entity)) {
+            b32 in_camera_zone = camera_zone && is_in_entity_local_region(camera_zone, camera_zone->active_region + entity->collision, entity->p);
+
+            SortEntry* wall = walls + wall_count++;
+            wall->sort_key = get_static_geometry_sort_key(entity->p, in_camera_zone);
+            wall->index = entity_index;
+        } else {
+            bake->dynamic_entity_indices[bake->dynamic_entity_count++] = entity_index;
+        }
+    }
+
+    sort_entries(wall_count, walls, sort_temp);
+
+    StaticGeometryBatch* batch = 0;
+    for (u32 wall_index = 0; wall_index < wall_count; wall_index++) {
+        SortEntry* wall = walls + wall_index;
+        Entity* entity = entities + wall->index;
+
+        if (!batch || wall->sort_key != walls[wall_index - 1].sort_key) {
+            batch = bake->batches + bake->batch_count++;
+            batch->origin = get_static_geometry_tile_origin(entity->p);
+            batch->bounds = inverted_infinity_aab2();
+            batch->in_camera_zone = cast(b32) (wall->sort_key & 1);
+            batch->rect_count = 0;
+            batch->rects = bake->rects + wall_index;
+        }
+
+        // @Note: The same as the render loop draws dynamic walls
+        v4 color = (entity->flags & EntityFlag_Hazard) ? COLOR_RED : foreground_color;
+
+        RenderRect* rect = batch->rects + batch->rect_count++;
+        rect->aab = aab_center_dim(entity->p - batch->origin, entity->collision);
+        if (entity->flags & EntityFlag_Collides) {
+            rect->render_mode = ShapeRenderMode_Fill;
+        } else {
+            rect->render_mode = ShapeRenderMode_Outline;
+            color.a *= 0.5f;
+        }
+        rect->color = transform_color(color);
+
+        batch->bounds = aab_union(batch->bounds, rect->aab);
+    }
+
+    release_scratch(scratch);
+
+    geometry->invalidated = false;
+    geometry->entities = entities;
+    geometry->entity_count = entity_count;
+    geometry->camera_zone = camera_zone;
+    geometry->foreground_color = foreground_color;
+}
+
+// @Note: Bakes again if anything the current bake was made from has changed
+internal StaticGeometryBake* update_static_geometry(StaticGeometry* geometry, Entity* entities, u32 entity_count, Entity* camera_zone, v4 foreground_color) {
+    if (geometry->invalidated ||
+        geometry->entities != entities ||
+        geometry->entity_count != entity_count ||
+        geometry->camera_zone != camera_zone ||
+        geometry->foreground_color.r != foreground_color.r || geometry->foreground_color.g != foreground_color.g ||
+        geometry->foreground_color.b != foreground_color.b || geometry->foreground_color.a != foreground_color.a)
+    {
+        bake_static_geometry(geometry, entities, entity_count, camera_zone, foreground_color);
+    }
+
+    StaticGeometryBake* result = geometry->bakes + geometry->current_bake;
+    return result;
+}
+
+internal void push_static_geometry(RenderContext* render_context, StaticGeometryBake* bake, v2 camera_zone_shake) {
+    for (u32 batch_index = 0; batch_index < bake->batch_count; batch_index++) {
+        StaticGeometryBatch* batch = bake->batches + batch_index;
+
+        v2 origin = batch->origin;
+        if (batch->in_camera_zone) {
+            origin += camera_zone_shake;
+        }
+
+        push_rect_batch(render_context, transform2d(origin), batch->rect_count, batch->rects, batch->bounds);
+    }
+}
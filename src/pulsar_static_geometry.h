@@ -0,0 +1,48 @@
+#ifndef PULSAR_STATIC_GEOMETRY_H
+#define PULSAR_STATIC_GEOMETRY_H
+
+// @Note: Most walls never move or change after the level starts, so instead of pushing a shape for each of them every
+// frame they get baked into rect batches, one per tile of the level, which get pushed as one command each. Everything
+// that isn't a static wall goes in the list of dynamic entities, which are the only ones that still get drawn one by
+// one. The bake gets redone when the entities it was baked from change, which the editor reports through
+// invalidate_static_geometry, or when the entity array, the camera zone or the foreground color are different ones.
+
+#define STATIC_GEOMETRY_TILE_SIZE 16.0f
+
+struct StaticGeometryBatch {
+    v2 origin; // @Note: The center of the tile
+    AxisAlignedBox2 bounds; // @Note: Relative to the origin, and may stick out of the tile
+    b32 in_camera_zone; // @Note: Shaken along with the rest of the entities in the active camera zone
+    u32 rect_count;
+    RenderRect* rects;
+};
+
+// @Note: The platform can still be rendering the previous frame while the game builds the next one, so baking again
+// goes into the other bake, and the rects the previous frame's commands point to stay put.
+struct StaticGeometryBake {
+    u32 batch_count;
+    StaticGeometryBatch batches[MAX_ENTITY_COUNT];
+    RenderRect rects[MAX_ENTITY_COUNT];
+
+    u32 dynamic_entity_count;
+    u32 dynamic_entity_indices[MAX_ENTITY_COUNT];
+};
+
+struct StaticGeometry {
+    b32 invalidated;
+
+    // @Note: What the current bake was made from
+    Entity* entities;
+    u32 entity_count;
+    Entity* camera_zone;
+    v4 foreground_color;
+
+    u32 current_bake;
+    StaticGeometryBake bakes[2];
+};
+
+inline void invalidate_static_geometry(StaticGeometry* geometry) {
+    geometry->invalidated = true;
+}
+
+#endif /* PULSAR_STATIC_GEOMETRY_H */
@@ -61,4 +61,163 @@ inline void clear_array(Array<T>* array) {
     array->count = 0;
 }
 
+// @Note: BucketArray<T> grows a bucket at a time instead of reallocating, so items never move and pointers to them stay
+// valid for as long as the item lives. Removed slots go back to their bucket, and buckets with free slots are kept on a
+// list, so adding and removing are both O(1). Iteration walks each bucket's occupancy mask, so it only touches live items.
+// Without removals, iteration order is insertion order.
+
+#define BUCKET_ARRAY_BUCKET_SIZE 64
+
+template <typename T>
+struct ArrayBucket {
+    ArrayBucket<T>* next;
+    ArrayBucket<T>* next_non_full;
+    u64 occupied; // @Note: One bit per slot
+    T items[BUCKET_ARRAY_BUCKET_SIZE];
+};
+
+template <typename T>
+struct BucketArray {
+    Allocator allocator;
+    size_t count;
+    size_t bucket_count;
+
+    ArrayBucket<T>* first_bucket;
+    ArrayBucket<T>* last_bucket;
+    ArrayBucket<T>* first_non_full_bucket;
+};
+
+template <typename T>
+struct BucketLocator {
+    ArrayBucket<T>* bucket;
+    u32 slot;
+};
+
+template <typename T>
+inline void allocate_bucket_array(BucketArray<T>* array, Allocator allocator) {
+    array->allocator = allocator;
+    array->count = 0;
+    array->bucket_count = 0;
+    array->first_bucket = 0;
+    array->last_bucket = 0;
+    array->first_non_full_bucket = 0;
+}
+
+template <typename T>
+inline T* bucket_array_add(BucketArray<T>* array, BucketLocator<T>* out_locator = 0) {
+    if (!array->first_non_full_bucket) {
+        ArrayBucket<T>* new_bucket = cast(ArrayBucket<T>*) allocate(array->allocator, sizeof(ArrayBucket<T>), align_no_clear(alignof(ArrayBucket<T>)));
+        assert(new_bucket);
+        new_bucket->next = 0;
+        new_bucket->next_non_full = 0;
+        new_bucket->occupied = 0;
+
+        if (array->last_bucket) {
+            array->last_bucket->next = new_bucket;
+        } else {
+            array->first_bucket = new_bucket;
+        }
+        array->last_bucket = new_bucket;
+        array->first_non_full_bucket = new_bucket;
+        array->bucket_count++;
+    }
+
+    ArrayBucket<T>* bucket = array->first_non_full_bucket;
+
+    BitScanResult free_slot = find_least_significant_set_bit(~bucket->occupied);
+    assert(free_slot.found);
+
+    bucket->occupied |= 1ull << free_slot.index;
+    if (bucket->occupied == ~0ull) {
+        array->first_non_full_bucket = bucket->next_non_full;
+        bucket->next_non_full = 0;
+    }
+
+    array->count++;
+
+    if (out_locator) {
+        out_locator->bucket = bucket;
+        out_locator->slot = free_slot.index;
+    }
+
+    T* result = bucket->items + free_slot.index;
+    return result;
+}
+
+template <typename T>
+inline T* bucket_array_add(BucketArray<T>* array, T item) {
+    T* slot = bucket_array_add(array);
+    *slot = item;
+    return slot;
+}
+
+// @Note: Nothing moves to fill the hole, the slot just gets handed out again by a later add. It's fine to remove the
+// current item while iterating.
+template <typename T>
+inline void bucket_array_remove(BucketArray<T>* array, BucketLocator<T> locator) {
+    ArrayBucket<T>* bucket = locator.bucket;
+    u64 slot_bit = 1ull << locator.slot;
+    assert(bucket->occupied & slot_bit);
+
+    if (bucket->occupied == ~0ull) {
+        bucket->next_non_full = array->first_non_full_bucket;
+        array->first_non_full_bucket = bucket;
+    }
+
+    bucket->occupied &= ~slot_bit;
+    array->count--;
+}
+
+template <typename T>
+inline void clear_bucket_array(BucketArray<T>* array) {
+    array->count = 0;
+    array->first_non_full_bucket = array->first_bucket;
+    for (ArrayBucket<T>* bucket = array->first_bucket; bucket; bucket = bucket->next) {
+        bucket->occupied = 0;
+        bucket->next_non_full = bucket->next;
+    }
+}
+
+template <typename T>
+struct BucketIterator {
+    ArrayBucket<T>* bucket;
+    u64 remaining; // @Note: Occupied slots of the current bucket that haven't been visited yet
+    u32 slot;
+    T* item;       // @Note: 0 once the iterator is done
+};
+
+template <typename T>
+inline void advance_iterator(BucketIterator<T>* it) {
+    it->item = 0;
+    while (it->bucket) {
+        BitScanResult next_slot = find_least_significant_set_bit(it->remaining);
+        if (next_slot.found) {
+            it->remaining &= it->remaining - 1;
+            it->slot = next_slot.index;
+            it->item = it->bucket->items + next_slot.index;
+            break;
+        }
+
+        it->bucket = it->bucket->next;
+        it->remaining = it->bucket ? it->bucket->occupied : 0;
+    }
+}
+
+template <typename T>
+inline BucketIterator<T> iterate_bucket_array(BucketArray<T>* array) {
+    BucketIterator<T> it = {};
+    it.bucket = array->first_bucket;
+    it.remaining = it.bucket ? it.bucket->occupied : 0;
+    advance_iterator(&it);
+    return it;
+}
+
+template <typename T>
+inline BucketLocator<T> get_locator(BucketIterator<T> it) {
+    BucketLocator<T> result;
+    result.bucket = it.bucket;
+    result.slot = it.slot;
+    return result;
+}
+
 #endif
@@ -0,0 +1,282 @@
+#ifndef PULSAR_HASH_TABLE_H
+#define PULSAR_HASH_TABLE_H
+
+// @Note: HashTable<K, V> is an open addressing table in the style of Swiss tables. Every slot has a control byte, which
+// is HASH_TABLE_CONTROL_EMPTY for an empty slot, or the low 7 bits of the key's hash for a full one. Lookups compare 16
+// control bytes at a time with SSE2, so most candidates that can't match are rejected without touching their keys.
+// Probing is linear, which lets removal shift the keys behind the removed one back towards their home slots instead of
+// leaving tombstones, so lookups don't slow down as keys come and go.
+// Adding can grow the table and removing moves keys around, so don't hold on to pointers into the table across either.
+// Keys need a hash_key() and a keys_are_equal() overload, see the u32 and String ones below. String keys aren't copied,
+// so the string data has to outlive the table.
+
+#define HASH_TABLE_GROUP_SIZE 16
+#define HASH_TABLE_MIN_CAPACITY HASH_TABLE_GROUP_SIZE
+#define HASH_TABLE_CONTROL_EMPTY 0x80
+
+inline u64 hash_mix(u64 x) {
+    // @Note: The splitmix64 finalizer
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+inline u64 hash_key(u32 key) {
+    // @Note: Ids are mostly small and sequential, so they need a proper mix before both the probe position and the
+    // control byte can be taken from the same hash.
+    u64 result = hash_mix(key);
+    return result;
+}
+
+inline u64 hash_key(String key) {
+    // @Note: Eats the string 8 bytes at a time. A byte at a time hash like FNV-1a spends more time hashing a typical asset
+    // name than the probe takes.
+    u64 result = 0x9E3779B97F4A7C15ull ^ key.len;
+
+    u8* at = cast(u8*) key.data;
+    size_t remaining = key.len;
+    while (remaining >= 8) {
+        result = hash_mix(result ^ *cast(u64*) at);
+        at += 8;
+        remaining -= 8;
+    }
+
+    u64 tail = 0;
+    for (size_t byte_index = 0; byte_index < remaining; byte_index++) {
+        tail |= cast(u64) at[byte_index] << (8*byte_index);
+    }
+    result = hash_mix(result ^ tail);
+
+    return result;
+}
+
+inline b32 keys_are_equal(u32 a, u32 b) {
+    b32 result = (a == b);
+    return result;
+}
+
+inline b32 keys_are_equal(String a, String b) {
+    b32 result = strings_are_equal(a, b);
+    return result;
+}
+
+template <typename K, typename V>
+struct HashTable {
+    Allocator allocator;
+    u32 capacity; // @Note: Always a power of two
+    u32 count;
+
+    // @Note: There are HASH_TABLE_GROUP_SIZE - 1 control bytes past the end that mirror the first ones, so a group can
+    // be loaded starting from any slot without wrapping.
+    u8* control;
+    K* keys;
+    V* values;
+};
+
+inline u32 hash_table_group_match(u8* group_control, u8 control_byte) {
+    __m128i group = _mm_loadu_si128(cast(__m128i*) group_control);
+    u32 result = cast(u32) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(cast(char) control_byte)));
+    return result;
+}
+
+inline u32 hash_table_group_match_empty(u8* group_control) {
+    // @Note: Only empty slots have their top bit set
+    __m128i group = _mm_loadu_si128(cast(__m128i*) group_control);
+    u32 result = cast(u32) _mm_movemask_epi8(group);
+    return result;
+}
+
+template <typename K, typename V>
+inline u32 hash_table_home_slot(HashTable<K, V>* table, u64 hash) {
+    u32 result = cast(u32) (hash >> 7) & (table->capacity - 1);
+    return result;
+}
+
+template <typename K, typename V>
+inline void hash_table_set_control(HashTable<K, V>* table, u32 slot, u8 control_byte) {
+    table->control[slot] = control_byte;
+    if (slot < HASH_TABLE_GROUP_SIZE - 1) {
+        table->control[table->capacity + slot] = control_byte;
+    }
+}
+
+template <typename K, typename V>
+inline void hash_table_allocate_slots(HashTable<K, V>* table, u32 capacity) {
+    assert(capacity >= HASH_TABLE_MIN_CAPACITY && (capacity & (capacity - 1)) == 0);
+
+    table->capacity = capacity;
+    table->count = 0;
+
+    u32 control_size = capacity + HASH_TABLE_GROUP_SIZE - 1;
+    table->control = cast(u8*) allocate(table->allocator, control_size, align_no_clear(HASH_TABLE_GROUP_SIZE));
+    table->keys    = cast(K*) allocate(table->allocator, sizeof(K)*capacity, align_no_clear(alignof(K)));
+    table->values  = cast(V*) allocate(table->allocator, sizeof(V)*capacity, align_no_clear(alignof(V)));
+    assert(table->control && table->keys && table->values);
+
+    for (u32 control_index = 0; control_index < control_size; control_index++) {
+        table->control[control_index] = HASH_TABLE_CONTROL_EMPTY;
+    }
+}
+
+template <typename K, typename V>
+inline void initialize_hash_table(HashTable<K, V>* table, Allocator allocator, u32 initial_capacity = HASH_TABLE_MIN_CAPACITY) {
+    table->allocator = allocator;
+
+    u32 capacity = HASH_TABLE_MIN_CAPACITY;
+    while (capacity < initial_capacity) {
+        capacity *= 2;
+    }
+
+    hash_table_allocate_slots(table, capacity);
+}
+
+// @Note: Returns true and the key's slot if the key is in the table. Otherwise returns false and the slot the key would
+// be added at, which is the first empty slot after its home slot.
+template <typename K, typename V>
+inline b32 hash_table_probe(HashTable<K, V>* table, K key, u64 hash, u32* out_slot) {
+    u32 mask = table->capacity - 1;
+    u8 control_byte = cast(u8) (hash & 0x7F);
+
+    u32 position = hash_table_home_slot(table, hash);
+    for (;;) {
+        u8* group_control = table->control + position;
+        u32 matches = hash_table_group_match(group_control, control_byte);
+        u32 empties = hash_table_group_match_empty(group_control);
+        if (empties) {
+            // @Note: Keys are never stored past an empty slot on their probe sequence
+            matches &= empties ^ (empties - 1);
+        }
+
+        while (matches) {
+            u32 slot = (position + find_least_significant_set_bit(matches).index) & mask;
+            if (keys_are_equal(table->keys[slot], key)) {
+                *out_slot = slot;
+                return true;
+            }
+            matches &= matches - 1;
+        }
+
+        if (empties) {
+            *out_slot = (position + find_least_significant_set_bit(empties).index) & mask;
+            return false;
+        }
+
+        position = (position + HASH_TABLE_GROUP_SIZE) & mask;
+    }
+}
+
+template <typename K, typename V>
+inline void hash_table_grow(HashTable<K, V>* table) {
+    u32 old_capacity = table->capacity;
+    u8* old_control  = table->control;
+    K* old_keys      = table->keys;
+    V* old_values    = table->values;
+
+    hash_table_allocate_slots(table, 2*old_capacity);
+
+    for (u32 old_slot = 0; old_slot < old_capacity; old_slot++) {
+        if (old_control[old_slot] != HASH_TABLE_CONTROL_EMPTY) {
+            u64 hash = hash_key(old_keys[old_slot]);
+
+            u32 slot;
+            b32 found = hash_table_probe(table, old_keys[old_slot], hash, &slot);
+            assert(!found);
+
+            hash_table_set_control(table, slot, cast(u8) (hash & 0x7F));
+            table->keys[slot] = old_keys[old_slot];
+            table->values[slot] = old_values[old_slot];
+            table->count++;
+        }
+    }
+
+    deallocate(table->allocator, old_control);
+    deallocate(table->allocator, old_keys);
+    deallocate(table->allocator, old_values);
+}
+
+template <typename K, typename V>
+inline V* hash_table_find(HashTable<K, V>* table, K key) {
+    V* result = 0;
+
+    u32 slot;
+    if (hash_table_probe(table, key, hash_key(key), &slot)) {
+        result = table->values + slot;
+    }
+
+    return result;
+}
+
+// @Note: Returns the key's value, adding the key with a zeroed value first if it wasn't in the table yet
+template <typename K, typename V>
+inline V* hash_table_add(HashTable<K, V>* table, K key, b32* out_added = 0) {
+    u64 hash = hash_key(key);
+
+    u32 slot;
+    b32 found = hash_table_probe(table, key, hash, &slot);
+    if (!found) {
+        // @Note: Linear probing clusters quickly past 3/4 full
+        if (4*(table->count + 1) > 3*table->capacity) {
+            hash_table_grow(table);
+            hash_table_probe(table, key, hash, &slot);
+        }
+
+        hash_table_set_control(table, slot, cast(u8) (hash & 0x7F));
+        table->keys[slot] = key;
+        zero_struct(table->values[slot]);
+        table->count++;
+    }
+
+    if (out_added) {
+        *out_added = !found;
+    }
+
+    V* result = table->values + slot;
+    return result;
+}
+
+template <typename K, typename V>
+inline V* hash_table_insert(HashTable<K, V>* table, K key, V value) {
+    V* result = hash_table_add(table, key);
+    *result = value;
+    return result;
+}
+
+template <typename K, typename V>
+inline b32 hash_table_remove(HashTable<K, V>* table, K key) {
+    u32 hole;
+    b32 result = hash_table_probe(table, key, hash_key(key), &hole);
+
+    if (result) {
+        u32 mask = table->capacity - 1;
+
+        // @Note: Walk the rest of the cluster and move back every key that may live in the hole, so there's never an
+        // empty slot between a key and its home slot.
+        for (u32 slot = (hole + 1) & mask; table->control[slot] != HASH_TABLE_CONTROL_EMPTY; slot = (slot + 1) & mask) {
+            u32 home = hash_table_home_slot(table, hash_key(table->keys[slot]));
+            if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+                hash_table_set_control(table, hole, table->control[slot]);
+                table->keys[hole] = table->keys[slot];
+                table->values[hole] = table->values[slot];
+                hole = slot;
+            }
+        }
+
+        hash_table_set_control(table, hole, HASH_TABLE_CONTROL_EMPTY);
+        table->count--;
+    }
+
+    return result;
+}
+
+template <typename K, typename V>
+inline void clear_hash_table(HashTable<K, V>* table) {
+    for (u32 control_index = 0; control_index < table->capacity + HASH_TABLE_GROUP_SIZE - 1; control_index++) {
+        table->control[control_index] = HASH_TABLE_CONTROL_EMPTY;
+    }
+    table->count = 0;
+}
+
+#endif /* PULSAR_HASH_TABLE_H */
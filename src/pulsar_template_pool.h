@@ -0,0 +1,199 @@
+#ifndef PULSAR_POOL_H
+#define PULSAR_POOL_H
+
+// @Note: Pool<T> hands out fixed-size items from cache line aligned slabs pushed onto an arena. Items never move, but
+// anything held across frames should be a Handle<T>, which stops resolving once its item has been freed.
+// The live items are tracked in a dense list, so iterating them doesn't chase pointers through dead slots.
+// A pool holds at most POOL_SLAB_CAPACITY*POOL_MAX_SLABS items, past that pool_alloc returns null.
+
+#define POOL_SLAB_CAPACITY 64
+#define POOL_MAX_SLABS 64
+#define POOL_SLAB_ALIGN 64
+
+template <typename T>
+struct Handle {
+    u32 index;
+    u32 generation; // @Note: Odd generations are live, so a zeroed handle never resolves
+};
+
+template <typename T>
+inline b32 is_null(Handle<T> handle) {
+    b32 result = !handle.generation;
+    return result;
+}
+
+template <typename T>
+inline b32 handles_are_equal(Handle<T> a, Handle<T> b) {
+    b32 result = (a.index == b.index) && (a.generation == b.generation);
+    return result;
+}
+
+template <typename T>
+struct PoolSlab {
+    T items[POOL_SLAB_CAPACITY];
+    u32 generations[POOL_SLAB_CAPACITY];
+    u32 next_free[POOL_SLAB_CAPACITY];
+    u32 live_position[POOL_SLAB_CAPACITY]; // where this slot sits in the live list
+    u32 live_slots[POOL_SLAB_CAPACITY];    // the live list itself, striped across the slabs
+};
+
+template <typename T>
+struct Pool {
+    MemoryArena* arena;
+
+    u32 slab_count;
+    u32 capacity;
+    u32 live_count;
+    u32 first_free; // @Note: slot index + 1, 0 means the free list is empty
+
+    PoolSlab<T>* slabs[POOL_MAX_SLABS];
+};
+
+template <typename T>
+inline void initialize_pool(Pool<T>* pool, MemoryArena* arena) {
+    zero_struct(*pool);
+    pool->arena = arena;
+}
+
+template <typename T>
+inline PoolSlab<T>* get_pool_slab(Pool<T>* pool, u32 slot) {
+    assert(slot < pool->capacity);
+    PoolSlab<T>* result = pool->slabs[slot / POOL_SLAB_CAPACITY];
+    return result;
+}
+
+template <typename T>
+inline void pool_add_slab(Pool<T>* pool) {
+    assert(pool->slab_count < POOL_MAX_SLABS);
+
+    PoolSlab<T>* slab = push_struct(pool->arena, PoolSlab<T>, align(POOL_SLAB_ALIGN, true));
+    pool->slabs[pool->slab_count++] = slab;
+
+    u32 first_slot = pool->capacity;
+    pool->capacity += POOL_SLAB_CAPACITY;
+
+    // @Note: Thread the new slots onto the free list in order, so allocation fills slabs front to back
+    for (u32 slot_index = POOL_SLAB_CAPACITY; slot_index > 0; slot_index--) {
+        u32 slot = first_slot + slot_index - 1;
+        slab->next_free[slot_index - 1] = pool->first_free;
+        pool->first_free = slot + 1;
+    }
+}
+
+// @Note: Returns null, and leaves out_handle null, if the pool is full
+template <typename T>
+inline T* pool_alloc(Pool<T>* pool, Handle<T>* out_handle = 0) {
+    if (out_handle) {
+        zero_struct(*out_handle);
+    }
+
+    if (!pool->first_free) {
+        if (pool->slab_count == POOL_MAX_SLABS) {
+            return 0;
+        }
+        pool_add_slab(pool);
+    }
+
+    u32 slot = pool->first_free - 1;
+    PoolSlab<T>* slab = get_pool_slab(pool, slot);
+    u32 slab_index = slot % POOL_SLAB_CAPACITY;
+
+    pool->first_free = slab->next_free[slab_index];
+
+    assert(!(slab->generations[slab_index] & 1));
+    slab->generations[slab_index]++;
+
+    u32 live_position = pool->live_count++;
+    slab->live_position[slab_index] = live_position;
+    get_pool_slab(pool, live_position)->live_slots[live_position % POOL_SLAB_CAPACITY] = slot;
+
+    T* result = slab->items + slab_index;
+    zero_struct(*result);
+
+    if (out_handle) {
+        out_handle->index = slot;
+        out_handle->generation = slab->generations[slab_index];
+    }
+
+    return result;
+}
+
+template <typename T>
+inline T* pool_get(Pool<T>* pool, Handle<T> handle) {
+    T* result = 0;
+    if (handle.generation && handle.index < pool->capacity) {
+        PoolSlab<T>* slab = get_pool_slab(pool, handle.index);
+        u32 slab_index = handle.index % POOL_SLAB_CAPACITY;
+        if (slab->generations[slab_index] == handle.generation) {
+            result = slab->items + slab_index;
+        }
+    }
+    return result;
+}
+
+template <typename T>
+inline u32 pool_live_slot(Pool<T>* pool, u32 live_index) {
+    assert(live_index < pool->live_count);
+    u32 result = get_pool_slab(pool, live_index)->live_slots[live_index % POOL_SLAB_CAPACITY];
+    return result;
+}
+
+template <typename T>
+inline T* pool_get_live(Pool<T>* pool, u32 live_index) {
+    u32 slot = pool_live_slot(pool, live_index);
+    T* result = get_pool_slab(pool, slot)->items + (slot % POOL_SLAB_CAPACITY);
+    return result;
+}
+
+template <typename T>
+inline Handle<T> pool_get_live_handle(Pool<T>* pool, u32 live_index) {
+    u32 slot = pool_live_slot(pool, live_index);
+
+    Handle<T> result;
+    result.index = slot;
+    result.generation = get_pool_slab(pool, slot)->generations[slot % POOL_SLAB_CAPACITY];
+    return result;
+}
+
+// @Note: Freeing moves the last live item into the freed item's place in the live list. When freeing while iterating
+// with pool_get_live, don't advance the live index after freeing the current item.
+template <typename T>
+inline void pool_free_slot(Pool<T>* pool, u32 slot) {
+    PoolSlab<T>* slab = get_pool_slab(pool, slot);
+    u32 slab_index = slot % POOL_SLAB_CAPACITY;
+
+    assert(slab->generations[slab_index] & 1);
+    slab->generations[slab_index]++;
+
+    u32 live_position = slab->live_position[slab_index];
+    u32 last_live_position = --pool->live_count;
+    if (live_position != last_live_position) {
+        u32 moved_slot = get_pool_slab(pool, last_live_position)->live_slots[last_live_position % POOL_SLAB_CAPACITY];
+        get_pool_slab(pool, live_position)->live_slots[live_position % POOL_SLAB_CAPACITY] = moved_slot;
+        get_pool_slab(pool, moved_slot)->live_position[moved_slot % POOL_SLAB_CAPACITY] = live_position;
+    }
+
+    slab->next_free[slab_index] = pool->first_free;
+    pool->first_free = slot + 1;
+}
+
+template <typename T>
+inline void pool_free(Pool<T>* pool, Handle<T> handle) {
+    if (pool_get(pool, handle)) {
+        pool_free_slot(pool, handle.index);
+    }
+}
+
+template <typename T>
+inline void pool_free_live(Pool<T>* pool, u32 live_index) {
+    pool_free_slot(pool, pool_live_slot(pool, live_index));
+}
+
+template <typename T>
+inline void clear_pool(Pool<T>* pool) {
+    while (pool->live_count) {
+        pool_free_live(pool, pool->live_count - 1);
+    }
+}
+
+#endif /* PULSAR_POOL_H */
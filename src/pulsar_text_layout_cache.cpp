@@ -0,0 +1,214 @@
+// @Note: Lays the text out from a pen at the origin, new lines going back to newline_x and down by vertical_advance.
+// The glyphs are pushed on the arena.
+internal TextLayout lay_out_text(Assets* assets, Font* font, String text, u32 leading_codepoint, f32 newline_x, f32 vertical_advance, MemoryArena* arena) {
+    TextLayout result = {};
+    result.glyphs = push_array(arena, text.len, TextLayoutGlyph, no_clear());
+    result.bounds = inverted_infinity_aab2();
+
+    v2 at_p = vec2(0, 0);
+    if (in_font_range(font, leading_codepoint) && in_font_range(font, text.data[0])) {
+        at_p.x += get_advance_for_codepoint_pair(font, leading_codepoint, text.data[0]);
+    }
+
+    for (char* at = text.data; at[0]; at++) {
+        result.last_codepoint = at[0];
+        if (at[0] == ' ') {
+            at_p.x += font->whitespace_width;
+        } else if (at[0] == '\n') {
+            at_p.x  = newline_x;
+            at_p.y += vertical_advance;
+        } else if (in_font_range(font, at[0])) {
+            PackedGlyph* glyph = get_glyph_for_codepoint(font, at[0]);
+            if (glyph) {
+                u32 glyph_index = at[0] - font->first_codepoint;
+                Image* atlas_page = get_glyph_atlas_page(assets, font, glyph);
+
+                AxisAlignedBox2 glyph_aab = {};
+                if (atlas_page) {
+                    glyph_aab = offset(get_aligned_glyph_aab(font, glyph), at_p);
+                    if (glyph->w && glyph->h) {
+                        TextLayoutGlyph* layout_glyph = result.glyphs + result.glyph_count++;
+                        layout_glyph->glyph_index = cast(u16) glyph_index;
+                        layout_glyph->atlas_page = cast(u16) glyph->atlas_page;
+                        layout_glyph->p = at_p;
+                    }
+                } else {
+                    glyph_aab = aab_min_dim(at_p, vec2(font->size, font->size));
+
+                    TextLayoutGlyph* layout_glyph = result.glyphs + result.glyph_count++;
+                    layout_glyph->glyph_index = cast(u16) glyph_index;
+                    layout_glyph->atlas_page = TEXT_LAYOUT_MISSING_PAGE;
+                    layout_glyph->p = at_p;
+                }
+
+                result.bounds = aab_union(result.bounds, glyph_aab);
+
+                if (in_font_range(font, at[1])) {
+                    at_p.x += get_advance_for_codepoint_pair(font, at[0], at[1]);
+                }
+            }
+        } else {
+            // @TODO: Make it clear some unsupported characters showed up
+        }
+    }
+
+    result.end_p = at_p;
+
+    return result;
+}
+
+// @Note: Has to be called whenever fonts get loaded, the layouts point into them
+internal void reset_text_layout_cache(TextLayoutCache* cache) {
+    clear_hash_table(&cache->entry_table);
+
+    CachedTextLayout* sentinel = cache->entries;
+    sentinel->older = 0;
+    sentinel->newer = 0;
+
+    cache->first_free_entry = 1;
+    for (u32 entry_index = 1; entry_index < TEXT_LAYOUT_CACHE_ENTRY_COUNT; entry_index++) {
+        cache->entries[entry_index].newer = (entry_index + 1) % TEXT_LAYOUT_CACHE_ENTRY_COUNT;
+    }
+
+    cache->glyph_write_index = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+internal void initialize_text_layout_cache(TextLayoutCache* cache, Allocator allocator) {
+    // @Note: A new layout evicts the oldest one once the entry ring runs out, so the table never holds more than
+    // TEXT_LAYOUT_CACHE_ENTRY_COUNT keys and twice that keeps it out of hash_table_grow.
+    initialize_hash_table(&cache->entry_table, allocator, 2*TEXT_LAYOUT_CACHE_ENTRY_COUNT);
+    reset_text_layout_cache(cache);
+}
+
+inline void unlink_cached_text_layout(TextLayoutCache* cache, u32 entry_index) {
+    CachedTextLayout* entry = cache->entries + entry_index;
+    cache->entries[entry->older].newer = entry->newer;
+    cache->entries[entry->newer].older = entry->older;
+}
+
+inline void link_newest_cached_text_layout(TextLayoutCache* cache, u32 entry_index) {
+    CachedTextLayout* sentinel = cache->entries;
+    CachedTextLayout* entry = cache->entries + entry_index;
+    entry->newer = 0;
+    entry->older = sentinel->older;
+    cache->entries[sentinel->older].newer = entry_index;
+    sentinel->older = entry_index;
+}
+
+inline void evict_oldest_cached_text_layout(TextLayoutCache* cache) {
+    u32 entry_index = cache->entries[0].newer;
+    assert(entry_index);
+
+    CachedTextLayout* entry = cache->entries + entry_index;
+    hash_table_remove(&cache->entry_table, entry->key);
+    unlink_cached_text_layout(cache, entry_index);
+
+    entry->newer = cache->first_free_entry;
+    cache->first_free_entry = entry_index;
+}
+
+// @Note: The entries are in the same order as their glyphs are in the ring, starting at the write index, so making room
+// is overwriting the oldest entries until the next one is out of the way. When the glyphs don't fit before the end of
+// the ring, they go at the start and the entries left between the write index and the end go too.
+internal u32 reserve_text_layout_glyphs(TextLayoutCache* cache, u32 count) {
+    assert(count <= TEXT_LAYOUT_CACHE_GLYPH_COUNT);
+
+    u32 first_glyph = cache->glyph_write_index;
+    b32 wrapped = false;
+    if (first_glyph + count > TEXT_LAYOUT_CACHE_GLYPH_COUNT) {
+        first_glyph = 0;
+        wrapped = true;
+    }
+
+    while (cache->entries[0].newer) {
+        CachedTextLayout* oldest = cache->entries + cache->entries[0].newer;
+        b32 past_write_index = wrapped && oldest->first_glyph >= cache->glyph_write_index;
+        b32 in_the_way = oldest->first_glyph < first_glyph + count && first_glyph < oldest->first_glyph + oldest->reserved_glyph_count;
+        if (!past_write_index && !in_the_way) {
+            break;
+        }
+        evict_oldest_cached_text_layout(cache);
+    }
+
+    cache->glyph_write_index = first_glyph + count;
+    return first_glyph;
+}
+
+// @Note: The layout stays valid until the next call. Layouts of more than a quarter of the ring don't get cached, and
+// come back pushed on the scratch arena.
+internal TextLayout* get_text_layout(TextLayoutCache* cache, Assets* assets, Font* font, String text, u32 leading_codepoint, f32 newline_x, f32 vertical_advance, MemoryArena* scratch_arena) {
+    b32 has_newlines = false;
+    for (size_t char_index = 0; char_index < text.len; char_index++) {
+        if (text.data[char_index] == '\n') {
+            has_newlines = true;
+            break;
+        }
+    }
+
+    TextLayoutKey key;
+    key.font = font;
+    key.text_hash = hash_key(text);
+    key.text_length = cast(u32) text.len;
+    key.leading_codepoint = leading_codepoint;
+    key.newline_x = has_newlines ? newline_x : 0.0f;
+    key.vertical_advance = has_newlines ? vertical_advance : 0.0f;
+
+    u32 max_cached_glyph_count = TEXT_LAYOUT_CACHE_GLYPH_COUNT / 4;
+
+    u32* found_index = hash_table_find(&cache->entry_table, key);
+    if (found_index) {
+        cache->hits++;
+
+        u32 entry_index = *found_index;
+        CachedTextLayout* entry = cache->entries + entry_index;
+
+        // @Note: Still in use, so it gets moved out of the part of the ring that's going to be overwritten next
+        u32 distance_from_write_index = (entry->first_glyph - cache->glyph_write_index) & (TEXT_LAYOUT_CACHE_GLYPH_COUNT - 1);
+        if (distance_from_write_index < max_cached_glyph_count) {
+            TextLayoutGlyph* glyphs = push_array(scratch_arena, entry->reserved_glyph_count, TextLayoutGlyph, no_clear());
+            copy(sizeof(TextLayoutGlyph)*entry->reserved_glyph_count, cache->glyphs + entry->first_glyph, glyphs);
+
+            unlink_cached_text_layout(cache, entry_index);
+            entry->first_glyph = reserve_text_layout_glyphs(cache, entry->reserved_glyph_count);
+            link_newest_cached_text_layout(cache, entry_index);
+
+            entry->layout.glyphs = cache->glyphs + entry->first_glyph;
+            copy(sizeof(TextLayoutGlyph)*entry->reserved_glyph_count, glyphs, entry->layout.glyphs);
+        }
+
+        return &entry->layout;
+    }
+
+    cache->misses++;
+
+    TextLayout* result = push_struct(scratch_arena, TextLayout, no_clear());
+    *result = lay_out_text(assets, font, text, leading_codepoint, newline_x, vertical_advance, scratch_arena);
+
+    u32 reserved_glyph_count = MAX(1, result->glyph_count);
+    if (reserved_glyph_count <= max_cached_glyph_count) {
+        u32 first_glyph = reserve_text_layout_glyphs(cache, reserved_glyph_count);
+
+        if (!cache->first_free_entry) {
+            evict_oldest_cached_text_layout(cache);
+        }
+        u32 entry_index = cache->first_free_entry;
+        CachedTextLayout* entry = cache->entries + entry_index;
+        cache->first_free_entry = entry->newer;
+
+        entry->key = key;
+        entry->layout = *result;
+        entry->layout.glyphs = cache->glyphs + first_glyph;
+        entry->first_glyph = first_glyph;
+        entry->reserved_glyph_count = reserved_glyph_count;
+        copy(sizeof(TextLayoutGlyph)*result->glyph_count, result->glyphs, entry->layout.glyphs);
+
+        link_newest_cached_text_layout(cache, entry_index);
+        hash_table_insert(&cache->entry_table, key, entry_index);
+
+        result = &entry->layout;
+    }
+
+    return result;
+}
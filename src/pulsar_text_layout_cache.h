@@ -0,0 +1,77 @@
+#ifndef PULSAR_TEXT_LAYOUT_CACHE_H
+#define PULSAR_TEXT_LAYOUT_CACHE_H
+
+// @Note: Laying a string out means looking up every one of its glyphs and kerning pairs, and most UI text comes out
+// the same every frame. The cache keeps the layouts of strings it has seen recently, with glyph positions relative to
+// where the pen started, so printing the same string again costs one lookup.
+// The glyphs live in a ring that gets overwritten oldest layout first. Layouts that get used while they're close to
+// being overwritten get copied to the front, so what stays in the cache is what was used most recently.
+// The text isn't copied in, a layout is found by the string's hash and length, plus the font and pen state it needs.
+
+#define TEXT_LAYOUT_CACHE_ENTRY_COUNT 1024
+#define TEXT_LAYOUT_CACHE_GLYPH_COUNT (64*1024)
+#define TEXT_LAYOUT_MISSING_PAGE 0xFFFF
+
+struct TextLayoutGlyph {
+    u16 glyph_index;
+    u16 atlas_page; // @Note: TEXT_LAYOUT_MISSING_PAGE if the font's page isn't loaded, which gets drawn as a red box
+    v2 p;
+};
+
+// @Note: Only glyphs with something to draw are in glyphs, but all of them count towards the bounds
+struct TextLayout {
+    u32 glyph_count;
+    TextLayoutGlyph* glyphs;
+    v2 end_p;
+    u32 last_codepoint;
+    AxisAlignedBox2 bounds;
+};
+
+struct TextLayoutKey {
+    Font* font;
+    u64 text_hash;
+    u32 text_length;
+    u32 leading_codepoint; // @Note: The codepoint printed before the string, which the first advance is kerned against
+    // @Note: Where new lines start relative to the pen, which only matters for strings that have new lines in them
+    f32 newline_x;
+    f32 vertical_advance;
+};
+
+inline u64 hash_key(TextLayoutKey key) {
+    u64 result = hash_mix(key.text_hash ^ cast(u64) cast(size_t) key.font);
+    result = hash_mix(result ^ ((cast(u64) key.text_length << 32) | key.leading_codepoint));
+    return result;
+}
+
+inline b32 keys_are_equal(TextLayoutKey a, TextLayoutKey b) {
+    b32 result = (a.font == b.font && a.text_hash == b.text_hash && a.text_length == b.text_length &&
+                  a.leading_codepoint == b.leading_codepoint && a.newline_x == b.newline_x && a.vertical_advance == b.vertical_advance);
+    return result;
+}
+
+struct CachedTextLayout {
+    TextLayoutKey key;
+    TextLayout layout;
+
+    u32 first_glyph;
+    u32 reserved_glyph_count; // @Note: At least 1, so every entry holds a place in the ring
+
+    // @Note: In the order their glyphs were written to the ring, entry 0 is the sentinel
+    u32 older;
+    u32 newer;
+};
+
+struct TextLayoutCache {
+    HashTable<TextLayoutKey, u32> entry_table;
+
+    u32 first_free_entry;
+    u32 glyph_write_index;
+
+    u32 hits;
+    u32 misses;
+
+    CachedTextLayout entries[TEXT_LAYOUT_CACHE_ENTRY_COUNT];
+    TextLayoutGlyph glyphs[TEXT_LAYOUT_CACHE_GLYPH_COUNT];
+};
+
+#endif /* PULSAR_TEXT_LAYOUT_CACHE_H */
@@ -0,0 +1,166 @@
+// @Note: Twice the signed area of the triangle, positive when a, b, c go counter clockwise
+inline f32 get_triangle_area_x2(v2 a, v2 b, v2 c) {
+    f32 result = (b.x - a.x)*(c.y - a.y) - (b.y - a.y)*(c.x - a.x);
+    return result;
+}
+
+// @Note: Writes the vert_count - 2 triangles that make up the polygon to indices, 3 indices per triangle, and returns how
+// many there are. The polygon can wind either way. If it isn't simple there might be no ear left to clip, and then the
+// vertex it got stuck on gets clipped anyway, so it always finishes but the triangles might not cover the right area.
+internal u32 triangulate_polygon(u32 vert_count, v2* vertices, u16* indices, MemoryArena* scratch_arena) {
+    if (vert_count < 3) {
+        return 0;
+    }
+    assert(vert_count <= TRIANGULATION_MAX_VERTEX_COUNT);
+
+    TemporaryMemory temp = begin_temporary_memory(scratch_arena);
+
+    // @Note: The vertices that haven't been clipped yet, as a ring
+    u16* prev = push_array(scratch_arena, vert_count, u16, no_clear());
+    u16* next = push_array(scratch_arena, vert_count, u16, no_clear());
+
+    f32 area_x2 = 0.0f;
+    for (u32 vertex_index = 0; vertex_index < vert_count; vertex_index++) {
+        u32 next_index = (vertex_index + 1 < vert_count) ? vertex_index + 1 : 0;
+        prev[next_index] = cast(u16) vertex_index;
+        next[vertex_index] = cast(u16) next_index;
+
+        v2 a = vertices[vertex_index];
+        v2 b = vertices[next_index];
+        area_x2 += a.x*b.y - a.y*b.x;
+    }
+    f32 winding = (area_x2 < 0.0f) ? -1.0f : 1.0f;
+
+    u16* at = indices;
+    u32 remaining_count = vert_count;
+    u32 vertex_index = 0;
+    u32 failed_count = 0;
+    while (remaining_count > 3) {
+        u32 prev_index = prev[vertex_index];
+        u32 next_index = next[vertex_index];
+        v2 a = vertices[prev_index];
+        v2 b = vertices[vertex_index];
+        v2 c = vertices[next_index];
+
+        // @Note: A convex corner is an ear if none of the other vertices are inside it. Vertices on top of one of its
+        // corners don't count, that's how polygons with a hole bridged into them come out.
+        b32 is_ear = winding*get_triangle_area_x2(a, b, c) > 0.0f;
+        for (u32 test_index = next[next_index]; is_ear && test_index != prev_index; test_index = next[test_index]) {
+            v2 p = vertices[test_index];
+            if ((p.x == a.x && p.y == a.y) || (p.x == b.x && p.y == b.y) || (p.x == c.x && p.y == c.y)) {
+                continue;
+            }
+
+            if (winding*get_triangle_area_x2(a, b, p) >= 0.0f &&
+                winding*get_triangle_area_x2(b, c, p) >= 0.0f &&
+                winding*get_triangle_area_x2(c, a, p) >= 0.0f) {
+                is_ear = false;
+            }
+        }
+
+        // @Note: Been all the way around without finding an ear
+        if (failed_count >= remaining_count) {
+            is_ear = true;
+        }
+
+        if (is_ear) {
+            *at++ = cast(u16) prev_index;
+            *at++ = cast(u16) vertex_index;
+            *at++ = cast(u16) next_index;
+
+            next[prev_index] = cast(u16) next_index;
+            prev[next_index] = cast(u16) prev_index;
+            remaining_count--;
+
+            vertex_index = next_index;
+            failed_count = 0;
+        } else {
+            vertex_index = next_index;
+            failed_count++;
+        }
+    }
+
+    *at++ = prev[vertex_index];
+    *at++ = cast(u16) vertex_index;
+    *at++ = next[vertex_index];
+
+    end_temporary_memory(temp);
+
+    u32 result = vert_count - 2;
+    assert(at == indices + 3*result);
+    return result;
+}
+
+inline u64 hash_polygon_vertices(u32 vert_count, v2* vertices) {
+    // @Note: A vertex is two f32s, so it goes in as one u64
+    u64 result = 0x9E3779B97F4A7C15ull ^ vert_count;
+    for (u32 vertex_index = 0; vertex_index < vert_count; vertex_index++) {
+        result = hash_mix(result ^ *cast(u64*) (vertices + vertex_index));
+    }
+    return result;
+}
+
+internal void reset_triangulation_cache(TriangulationCache* cache) {
+    clear_hash_table(&cache->entry_table);
+    cache->entry_count = 0;
+    cache->index_count = 0;
+}
+
+internal void initialize_triangulation_cache(TriangulationCache* cache, Allocator allocator) {
+    // @Note: The cache gets cleared rather than adding past TRIANGULATION_CACHE_ENTRY_COUNT, so the table stays at most
+    // half full.
+    initialize_hash_table(&cache->entry_table, allocator, 2*TRIANGULATION_CACHE_ENTRY_COUNT);
+    reset_triangulation_cache(cache);
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+// @Note: Returns the polygon's triangles as 3 indices each, pushed on the arena. Without a cache the polygon gets
+// triangulated from scratch. Triangulations of more than a quarter of the cache's indices don't get cached.
+internal u16* get_polygon_triangulation(TriangulationCache* cache, u32 vert_count, v2* vertices, MemoryArena* arena, u32* out_triangle_count) {
+    u32 triangle_count = (vert_count >= 3) ? vert_count - 2 : 0;
+    *out_triangle_count = triangle_count;
+    if (!triangle_count) {
+        return 0;
+    }
+
+    u32 index_count = 3*triangle_count;
+    u16* result = push_array(arena, index_count, u16, no_clear());
+
+    PolygonKey key = {};
+    if (cache) {
+        key.vertex_hash = hash_polygon_vertices(vert_count, vertices);
+        key.vert_count = vert_count;
+
+        u32* found_index = hash_table_find(&cache->entry_table, key);
+        if (found_index) {
+            cache->hits++;
+
+            CachedTriangulation* entry = cache->entries + *found_index;
+            copy(sizeof(u16)*index_count, cache->indices + entry->first_index, result);
+            return result;
+        }
+
+        cache->misses++;
+    }
+
+    triangulate_polygon(vert_count, vertices, result, arena);
+
+    if (cache && index_count <= TRIANGULATION_CACHE_INDEX_COUNT / 4) {
+        if (cache->entry_count == TRIANGULATION_CACHE_ENTRY_COUNT || cache->index_count + index_count > TRIANGULATION_CACHE_INDEX_COUNT) {
+            reset_triangulation_cache(cache);
+        }
+
+        u32 entry_index = cache->entry_count++;
+        CachedTriangulation* entry = cache->entries + entry_index;
+        entry->first_index = cache->index_count;
+        entry->triangle_count = triangle_count;
+
+        copy(sizeof(u16)*index_count, result, cache->indices + entry->first_index);
+        cache->index_count += index_count;
+
+        hash_table_insert(&cache->entry_table, key, entry_index);
+    }
+
+    return result;
+}
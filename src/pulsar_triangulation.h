@@ -0,0 +1,50 @@
+#ifndef PULSAR_TRIANGULATION_H
+#define PULSAR_TRIANGULATION_H
+
+// @Note: Filled polygons are cut into triangles by ear clipping when they get pushed, so the renderers only ever draw
+// triangles, whatever the polygon's winding and whether it's convex or not. Ear clipping is quadratic in the vertex
+// count, and the same polygon tends to get pushed every frame with a different transform, so the triangulations are
+// cached by their local space vertices. Only a hash of those and the vertex count is stored, so a hit is trusted
+// without comparing vertices.
+// There's no eviction, the cache gets cleared when it fills up, which only happens if polygons keep changing shape.
+
+#define TRIANGULATION_CACHE_ENTRY_COUNT 1024
+#define TRIANGULATION_CACHE_INDEX_COUNT (64*1024)
+
+// @Note: The indices are u16s
+#define TRIANGULATION_MAX_VERTEX_COUNT 0xFFFF
+
+struct PolygonKey {
+    u64 vertex_hash;
+    u32 vert_count;
+};
+
+inline u64 hash_key(PolygonKey key) {
+    u64 result = hash_mix(key.vertex_hash ^ key.vert_count);
+    return result;
+}
+
+inline b32 keys_are_equal(PolygonKey a, PolygonKey b) {
+    b32 result = (a.vertex_hash == b.vertex_hash && a.vert_count == b.vert_count);
+    return result;
+}
+
+struct CachedTriangulation {
+    u32 first_index;
+    u32 triangle_count;
+};
+
+struct TriangulationCache {
+    HashTable<PolygonKey, u32> entry_table;
+
+    u32 entry_count;
+    u32 index_count;
+
+    u32 hits;
+    u32 misses;
+
+    CachedTriangulation entries[TRIANGULATION_CACHE_ENTRY_COUNT];
+    u16 indices[TRIANGULATION_CACHE_INDEX_COUNT];
+};
+
+#endif /* PULSAR_TRIANGULATION_H */
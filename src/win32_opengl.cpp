@@ -140,7 +140,53 @@ int wgl_opengl_attribs[] = {
     0,
 };
 
-internal HGLRC wgl_opengl_init(HDC window_dc, WglInfo* wgl_info, OpenGLInfo* opengl_info, u32 msaa_count) {
+int wgl_opengl_core_attribs[] = {
+    WGL_CONTEXT_MAJOR_VERSION_ARB, 3,
+    WGL_CONTEXT_MINOR_VERSION_ARB, 3,
+    WGL_CONTEXT_FLAGS_ARB, 0
+#if HANDMADE_INTERNAL
+    | WGL_CONTEXT_DEBUG_BIT_ARB
+#endif
+    ,
+    WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
+    0,
+};
+
+// @Note: Returns a current GL 3.3 core context with the shader path up and running, or 0 if it couldn't make one
+internal HGLRC wgl_create_core_context(HDC window_dc, OpenGLInfo* opengl_info) {
+    HGLRC glrc = 0;
+    if (wglCreateContextAttribsARB) {
+        glrc = wglCreateContextAttribsARB(window_dc, 0, wgl_opengl_core_attribs);
+    }
+
+    if (glrc) {
+        b32 shader_path = false;
+        if (wglMakeCurrent(window_dc, glrc)) {
+#define GL_LOAD_FUNCTION(name) name = (GL_FUNCTION_##name*)wglGetProcAddress(#name);
+            OPENGL_SHADER_PATH_FUNCTIONS(GL_LOAD_FUNCTION)
+            GL_LOAD_FUNCTION(glBufferStorage)
+#undef GL_LOAD_FUNCTION
+
+            opengl_init(true, true, opengl_info);
+            shader_path = opengl_init_shader_path(opengl_info);
+        }
+
+        if (!shader_path) {
+            wglMakeCurrent(0, 0);
+            wglDeleteContext(glrc);
+            glrc = 0;
+
+            // @Note: Start the fallback context from scratch, but keep around why the shader path didn't make it
+            OpenGLInfo failed_info = *opengl_info;
+            zero_struct(*opengl_info);
+            copy(sizeof(opengl_info->shader_log), failed_info.shader_log, opengl_info->shader_log);
+        }
+    }
+
+    return glrc;
+}
+
+internal HGLRC wgl_opengl_init(HDC window_dc, WglInfo* wgl_info, OpenGLInfo* opengl_info, u32 msaa_count, b32 use_shader_renderer = true) {
     if (!wgl_info) {
         WglInfo local_wgl_info;
         wgl_info = &local_wgl_info;
@@ -154,9 +200,22 @@ internal HGLRC wgl_opengl_init(HDC window_dc, WglInfo* wgl_info, OpenGLInfo* ope
     wgl_load_extensions(wgl_info);
     wgl_set_pixel_format(window_dc, wgl_info, msaa_count);
 
+    HGLRC glrc = 0;
+    if (use_shader_renderer) {
+        glrc = wgl_create_core_context(window_dc, opengl_info);
+        if (glrc) {
+            if (wglSwapIntervalEXT) {
+                wglSwapIntervalEXT(1);
+            }
+
+            glFinish();
+
+            return glrc;
+        }
+    }
+
     b32 modern_context = true;
 
-    HGLRC glrc = 0;
     if (wglCreateContextAttribsARB) {
         glrc = wglCreateContextAttribsARB(window_dc, 0, wgl_opengl_attribs);
     }
@@ -167,7 +226,7 @@ internal HGLRC wgl_opengl_init(HDC window_dc, WglInfo* wgl_info, OpenGLInfo* ope
     }
 
     if (wglMakeCurrent(window_dc, glrc)) {
-        opengl_init(modern_context, opengl_info);
+        opengl_init(modern_context, false, opengl_info);
 
         if (wglSwapIntervalEXT) {
             wglSwapIntervalEXT(1);
@@ -1,8 +1,7 @@
-// @TODO: Use large pages with VirtualAlloc
-
 #define ASSERT_ON_LOG_ERROR 0
 
 #include <windows.h>
+#include <psapi.h>
 #include <xinput.h>
 #include <dsound.h>
 #include <gl/gl.h>
@@ -24,9 +23,11 @@
 
 #include "pulsar_shapes.h"
 #include "pulsar_render_commands.h"
+#include "pulsar_software_renderer.h"
 
 #include "pulsar_opengl.cpp"
 #include "win32_opengl.cpp"
+#include "pulsar_software_renderer.cpp"
 
 global WglInfo wgl_info;
 global OpenGLInfo opengl_info;
@@ -52,6 +53,8 @@ struct Win32State {
 
     MemoryArena platform_arena;
 
+    CoherentSortState render_sort;
+
     u64 last_config_write_time;
     String config_file;
     GameConfig config;
@@ -71,6 +74,19 @@ struct Win32State {
     Win32LogMemory* first_log_memory;
 
     HANDLE log_file;
+
+    size_t large_page_size; // @Note: 0 if large pages weren't requested or the privilege isn't held
+    u8* large_page_storage;
+    size_t large_page_storage_size;
+
+    // @Note: Picked once at startup, the renderer can't be swapped while the assets hold handles from the other one
+    b32 use_software_renderer;
+    SoftwareRenderer software_renderer;
+    SoftwareFramebuffer software_framebuffer;
+    MemoryArena software_render_arena;
+    HANDLE software_render_semaphore;
+    u32 software_render_worker_count;
+    u32 volatile software_render_workers_finished;
 };
 
 global Win32State win32_state;
@@ -86,6 +102,81 @@ internal PLATFORM_DEALLOCATE_MEMORY(win32_deallocate_memory) {
     }
 }
 
+internal PLATFORM_RESERVE_MEMORY(win32_reserve_memory) {
+    void* result = VirtualAlloc(0, size, MEM_RESERVE, PAGE_READWRITE);
+    return result;
+}
+
+// @Note: Large page allocations are committed and locked in memory up front, and can't be committed or decommitted
+// piecemeal, so the arenas living in them commit and decommit as normal and this just ignores it.
+inline b32 win32_is_large_page_storage(void* address) {
+    u8* at = cast(u8*) address;
+    b32 result = at >= win32_state.large_page_storage && at < win32_state.large_page_storage + win32_state.large_page_storage_size;
+    return result;
+}
+
+internal PLATFORM_COMMIT_MEMORY(win32_commit_memory) {
+    b32 result = true;
+    if (size && !win32_is_large_page_storage(address)) {
+        result = VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != 0;
+    }
+    return result;
+}
+
+internal PLATFORM_DECOMMIT_MEMORY(win32_decommit_memory) {
+    if (size && !win32_is_large_page_storage(address)) {
+        VirtualFree(address, size, MEM_DECOMMIT);
+    }
+}
+
+internal size_t win32_enable_large_pages() {
+    // @Note: The user needs to have been granted the "Lock pages in memory" privilege, and even then it has to be
+    // enabled on the process token before VirtualAlloc will hand out large pages.
+    size_t result = 0;
+
+    HANDLE token;
+    if (OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES|TOKEN_QUERY, &token)) {
+        TOKEN_PRIVILEGES privileges = {};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        if (LookupPrivilegeValueA(NULL, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid)) {
+            AdjustTokenPrivileges(token, FALSE, &privileges, 0, NULL, NULL);
+            // @Note: AdjustTokenPrivileges succeeds when it didn't assign anything, too, so GetLastError is the real answer
+            if (GetLastError() == ERROR_SUCCESS) {
+                result = GetLargePageMinimum();
+            }
+        }
+        CloseHandle(token);
+    }
+
+    return result;
+}
+
+internal void* win32_allocate_large_pages(size_t size) {
+    void* result = 0;
+    if (win32_state.large_page_size) {
+        size_t large_page_size = win32_state.large_page_size;
+        size_t rounded_size = (size + large_page_size - 1) & ~(large_page_size - 1);
+        result = VirtualAlloc(0, rounded_size, MEM_RESERVE|MEM_COMMIT|MEM_LARGE_PAGES, PAGE_READWRITE);
+    }
+    return result;
+}
+
+internal void win32_prefault_memory(void* address, size_t size) {
+    // @Note: Touching a byte in every page takes the demand-zero faults here, instead of in the first frames
+    volatile u8* at = cast(volatile u8*) address;
+    for (size_t offset = 0; offset < size; offset += KILOBYTES(4)) {
+        at[offset] = 0;
+    }
+}
+
+inline u32 win32_get_page_fault_count() {
+    PROCESS_MEMORY_COUNTERS counters = {};
+    counters.cb = sizeof(counters);
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PageFaultCount;
+}
+
 #define win32_log_print(log_level, format_string, ...) win32_log_print_internal(log_level, string_literal(__FILE__), string_literal(__FUNCTION__), __LINE__, format_string, ##__VA_ARGS__)
 internal PLATFORM_LOG_PRINT(win32_log_print_internal) {
 #if ASSERT_ON_LOG_ERROR
@@ -162,13 +253,20 @@ internal PLATFORM_GET_UNREAD_LOG_MESSAGES(win32_get_unread_log_messages) {
 }
 
 internal PLATFORM_ALLOCATE_TEXTURE(win32_allocate_texture) {
+    // @Note: The software renderer samples image->pixels straight out of the asset data, so there's nothing to upload
+    if (win32_state.use_software_renderer) {
+        return 0;
+    }
+
     GLuint handle = opengl_load_texture(&opengl_info, w, h, data);
     assert(sizeof(handle) <= sizeof(void*));
     return cast(void*) handle;
 }
 
 internal PLATFORM_DEALLOCATE_TEXTURE(win32_deallocate_texture) {
-    opengl_unload_texture(cast(GLuint) handle);
+    if (!win32_state.use_software_renderer) {
+        opengl_unload_texture(cast(GLuint) handle);
+    }
 }
 
 internal PLATFORM_READ_ENTIRE_FILE(win32_read_entire_file) {
@@ -208,18 +306,25 @@ internal PLATFORM_READ_ENTIRE_FILE(win32_read_entire_file) {
     return result;
 }
 
-internal PLATFORM_WRITE_ENTIRE_FILE(win32_write_entire_file) {
+internal PLATFORM_WRITE_ENTIRE_FILE_CHUNKED(win32_write_entire_file_chunked) {
     b32 result = false;
 
     HANDLE file_handle = CreateFileA(file_name, GENERIC_WRITE, NULL, NULL, CREATE_ALWAYS, NULL, NULL);
 
     if (file_handle != INVALID_HANDLE_VALUE) {
-        DWORD bytes_written;
-        if (WriteFile(file_handle, data, size, &bytes_written, NULL)) {
-            // File written successfully
-            result = (bytes_written == size);
-        } else {
-            win32_log_print(LogLevel_Error, "Failed to write file '%s'", file_name);
+        result = true;
+        for (u32 chunk_index = 0; chunk_index < chunk_count; chunk_index++) {
+            FileChunk* chunk = chunks + chunk_index;
+
+            DWORD bytes_written;
+            if (WriteFile(file_handle, chunk->data, chunk->size, &bytes_written, NULL)) {
+                // Chunk written successfully
+                result = result && (bytes_written == chunk->size);
+            } else {
+                result = false;
+                win32_log_print(LogLevel_Error, "Failed to write file '%s'", file_name);
+                break;
+            }
         }
 
         CloseHandle(file_handle);
@@ -230,6 +335,15 @@ internal PLATFORM_WRITE_ENTIRE_FILE(win32_write_entire_file) {
     return result;
 }
 
+internal PLATFORM_WRITE_ENTIRE_FILE(win32_write_entire_file) {
+    FileChunk chunk;
+    chunk.size = size;
+    chunk.data = data;
+
+    b32 result = win32_write_entire_file_chunked(file_name, 1, &chunk);
+    return result;
+}
+
 global s64 perf_count_frequency;
 inline void win32_initialize_perf_counter() {
     LARGE_INTEGER perf_count_frequency_result;
@@ -602,18 +716,150 @@ internal void win32_handle_remaining_messages(GameInput* input, BYTE* keyboard_s
     }
 }
 
-internal void win32_output_image(GameRenderCommands* commands, HDC window_dc) {
+#if PULSAR_ARENA_INSTRUMENTATION
+internal void win32_dump_arena_stats_csv(char* file_name) {
+    TemporaryMemory temp = begin_temporary_memory(&win32_state.platform_arena);
+
+    size_t line_size = 512;
+    size_t buffer_size = (2 + arena_instrumentation.arena_count + arena_instrumentation.call_site_count)*line_size;
+    char* buffer = cast(char*) push_size(&win32_state.platform_arena, buffer_size, no_clear());
+
+    size_t at = 0;
+    at += stbsp_snprintf(buffer + at, cast(int) (buffer_size - at), "kind,name,line,count,bytes,peak_bytes,size,committed\n");
+
+    for (u32 arena_index = 0; arena_index < arena_instrumentation.arena_count; arena_index++) {
+        MemoryArena* arena = arena_instrumentation.arenas[arena_index];
+        at += stbsp_snprintf(buffer + at, cast(int) (buffer_size - at), "arena,\"%s\",,,%llu,%llu,%llu,%llu\n",
+                             arena->debug_name ? arena->debug_name : "(unnamed)",
+                             cast(u64) arena->used, cast(u64) arena->high_water, cast(u64) arena->size, cast(u64) arena->committed);
+    }
+
+    for (u32 site_index = 0; site_index < MAX_ARENA_CALL_SITES; site_index++) {
+        ArenaCallSite* site = arena_instrumentation.call_sites + site_index;
+        if (site->file) {
+            at += stbsp_snprintf(buffer + at, cast(int) (buffer_size - at), "%s,\"%s\",%u,%llu,%llu,%llu,,\n",
+                                 site->kind == ArenaCallSite_Temp ? "temp" : "push",
+                                 site->file, site->line, site->count, site->bytes, site->peak_bytes);
+        }
+    }
+
+    if (win32_write_entire_file(file_name, cast(u32) at, buffer)) {
+        win32_log_print(LogLevel_Info, "Wrote arena stats to '%s'", file_name);
+    }
+
+    end_temporary_memory(temp);
+}
+#endif
+
+internal DWORD WINAPI win32_software_render_thread_proc(LPVOID parameter) {
+    for (;;) {
+        WaitForSingleObject(win32_state.software_render_semaphore, INFINITE);
+        software_render_tiles(&win32_state.software_renderer);
+        atomic_add_u32(&win32_state.software_render_workers_finished, 1);
+    }
+}
+
+internal void win32_init_software_renderer(u32 thread_count) {
+    initialize_software_span_kernels();
+
+    size_t arena_size = GIGABYTES(1);
+    size_t decommit_threshold = MEGABYTES(cast(u64) win32_state.config.arena_decommit_threshold_mb);
+    initialize_growable_arena(&win32_state.software_render_arena, arena_size, win32_reserve_memory(arena_size), win32_commit_memory, win32_decommit_memory, decommit_threshold);
+    name_arena(&win32_state.software_render_arena, "Software Renderer");
+
+    if (!thread_count) {
+        SYSTEM_INFO system_info;
+        GetSystemInfo(&system_info);
+        thread_count = cast(u32) system_info.dwNumberOfProcessors;
+    }
+
+    // @Note: The main thread rasterizes too, so it takes one fewer worker than threads
+    u32 worker_count = thread_count > 1 ? thread_count - 1 : 0;
+    win32_state.software_render_semaphore = CreateSemaphoreA(0, 0, MAX(worker_count, 1), 0);
+    for (u32 worker_index = 0; worker_index < worker_count; worker_index++) {
+        HANDLE thread = CreateThread(0, 0, win32_software_render_thread_proc, 0, 0, 0);
+        if (!thread) {
+            break;
+        }
+        CloseHandle(thread);
+        win32_state.software_render_worker_count++;
+    }
+
+    win32_log_print(LogLevel_Info, "Rendering in software on %u threads with %s span kernels", win32_state.software_render_worker_count + 1, software_span_kernels.name);
+}
+
+internal u32 win32_software_render_commands(GameRenderCommands* commands, HDC window_dc) {
+    SoftwareFramebuffer* framebuffer = &win32_state.software_framebuffer;
+    if (framebuffer->width != commands->width || framebuffer->height != commands->height) {
+        win32_deallocate_memory(framebuffer->pixels);
+        framebuffer->width = commands->width;
+        framebuffer->height = commands->height;
+        framebuffer->pitch = commands->width;
+        framebuffer->pixels = cast(u32*) win32_allocate_memory(sizeof(u32)*framebuffer->pitch*framebuffer->height);
+    }
+
+    u32 result = 0;
+    if (framebuffer->pixels) {
+        TemporaryMemory temp = begin_temporary_memory(&win32_state.software_render_arena);
+
+        SoftwareRenderer* renderer = &win32_state.software_renderer;
+        software_begin_render(renderer, *framebuffer, commands, &win32_state.software_render_arena);
+
+        win32_state.software_render_workers_finished = 0;
+        if (win32_state.software_render_worker_count) {
+            ReleaseSemaphore(win32_state.software_render_semaphore, win32_state.software_render_worker_count, 0);
+        }
+
+        software_render_tiles(renderer);
+
+        // @Note: Wait for the workers to be out of the renderer too, not just for the tiles, so none of them are still
+        // looking at this frame's bins when the next frame starts building its own.
+        while (!software_render_is_done(renderer) || win32_state.software_render_workers_finished != win32_state.software_render_worker_count) {
+            _mm_pause();
+        }
+
+        end_temporary_memory(temp);
+
+        BITMAPINFO bitmap_info = {};
+        bitmap_info.bmiHeader.biSize        = sizeof(bitmap_info.bmiHeader);
+        bitmap_info.bmiHeader.biWidth       = cast(LONG) framebuffer->pitch;
+        bitmap_info.bmiHeader.biHeight      = cast(LONG) framebuffer->height; // @Note: Positive, so the rows go bottom up like the framebuffer's
+        bitmap_info.bmiHeader.biPlanes      = 1;
+        bitmap_info.bmiHeader.biBitCount    = 32;
+        bitmap_info.bmiHeader.biCompression = BI_RGB;
+
+        StretchDIBits(window_dc,
+            0, 0, cast(int) framebuffer->width, cast(int) framebuffer->height,
+            0, 0, cast(int) framebuffer->width, cast(int) framebuffer->height,
+            framebuffer->pixels, &bitmap_info, DIB_RGB_COLORS, SRCCOPY
+        );
+
+        result = renderer->primitive_count;
+    }
+
+    return result;
+}
+
+internal u32 win32_output_image(GameRenderCommands* commands, HDC window_dc) {
     TemporaryMemory temp = begin_temporary_memory(&win32_state.platform_arena);
 
-    SortEntry* sort_entries = cast(SortEntry*) commands->command_buffer;
+    SortEntry* entries = cast(SortEntry*) commands->command_buffer;
     SortEntry* sort_temp_space = push_array(&win32_state.platform_arena, commands->sort_entry_count, SortEntry, no_clear());
 
-    radix_sort(commands->sort_entry_count, sort_entries, sort_temp_space);
+    coherent_sort_entries(&win32_state.render_sort, commands->sort_entry_count, entries, sort_temp_space);
 
-    opengl_render_commands(commands);
-    SwapBuffers(window_dc);
+    u32 draw_batches;
+    if (win32_state.use_software_renderer) {
+        // @Note: Counts primitives rather than draw calls
+        draw_batches = win32_software_render_commands(commands, window_dc);
+    } else {
+        draw_batches = opengl_render_commands(&opengl_info, commands);
+        SwapBuffers(window_dc);
+    }
 
     end_temporary_memory(temp);
+
+    return draw_batches;
 }
 
 inline b32 parse_config(GameConfig* config, String in_file) {
@@ -769,6 +1015,7 @@ inline void handle_config_file(char* config_file_name) {
 
 int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR command_line, int show_code) {
     win32_initialize_perf_counter();
+    initialize_memory_kernels();
 
     win32_state.cursor_shown = true;
 
@@ -776,6 +1023,7 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
     void* platform_storage = win32_allocate_memory(platform_storage_size);
 
     initialize_arena(&win32_state.platform_arena, platform_storage_size, platform_storage);
+    name_arena(&win32_state.platform_arena, "Platform");
 
 #if 0
     win32_state.log_file = CreateFileA("test_log.txt", GENERIC_WRITE, NULL, NULL, CREATE_ALWAYS, NULL, NULL);
@@ -787,6 +1035,8 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
     char* config_file_name = "pulsar_config.pcf";
     handle_config_file(config_file_name);
 
+    win32_log_print(LogLevel_Info, "Using %s memory kernels", memory_kernels.name);
+
     HCURSOR arrow_cursor = LoadCursorA(NULL, IDC_ARROW);
 
     WNDCLASSA window_class = {};
@@ -818,7 +1068,17 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
             ShowWindow(window, show_code);
 
             HDC window_dc = GetDC(window);
-            HGLRC glrc = wgl_opengl_init(window_dc, &wgl_info, &opengl_info, win32_state.config.msaa_count);
+            win32_state.use_software_renderer = win32_state.config.use_software_renderer;
+            if (win32_state.use_software_renderer) {
+                win32_init_software_renderer(win32_state.config.software_renderer_thread_count);
+            } else {
+                wgl_opengl_init(window_dc, &wgl_info, &opengl_info, win32_state.config.msaa_count, win32_state.config.use_shader_renderer);
+                if (opengl_info.shader_path) {
+                    win32_log_print(LogLevel_Info, "Rendering through the GL 3.3 shader path (%s)", opengl_info.stream.persistent ? "persistently mapped" : "mapped per batch");
+                } else if (win32_state.config.use_shader_renderer) {
+                    win32_log_print(LogLevel_Info, "Falling back to fixed function GL: %s", opengl_info.shader_log[0] ? opengl_info.shader_log : "No GL 3.3 core context");
+                }
+            }
 
             u32 monitor_refresh_rate = GetDeviceCaps(window_dc, VREFRESH);
             if (monitor_refresh_rate <= 1) {
@@ -848,20 +1108,79 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
                 sound_output.buffer->Play(0, 0, DSBPLAY_LOOPING);
             }
 
+            if (win32_state.config.use_large_pages) {
+                win32_state.large_page_size = win32_enable_large_pages();
+                if (win32_state.large_page_size) {
+                    win32_log_print(LogLevel_Info, "Using %uKB large pages", win32_state.large_page_size / 1024);
+                } else {
+                    win32_log_print(LogLevel_Warn, "Large pages were requested, but the 'Lock pages in memory' privilege isn't held. Falling back to regular pages.");
+                }
+            }
+
+            b32 prefault = win32_state.config.prefault_storage_mb > 0;
+
             GameRenderCommands render_commands = {};
             render_commands.command_buffer_size = MEGABYTES(win32_state.config.command_buffer_size_mb);
-            render_commands.command_buffer = cast(u8*) win32_allocate_memory(render_commands.command_buffer_size);
+            render_commands.command_buffer = cast(u8*) win32_allocate_large_pages(render_commands.command_buffer_size);
+            b32 command_buffer_uses_large_pages = render_commands.command_buffer != 0;
+            if (!command_buffer_uses_large_pages) {
+                render_commands.command_buffer = cast(u8*) win32_allocate_memory(render_commands.command_buffer_size);
+                if (prefault) {
+                    win32_prefault_memory(render_commands.command_buffer, render_commands.command_buffer_size);
+                }
+            }
+
+            if (win32_state.use_software_renderer) {
+                render_commands.max_particle_count = SOFTWARE_MAX_PARTICLE_COUNT;
+            } else {
+                render_commands.max_particle_count = opengl_info.shader_path ? OPENGL_MAX_PARTICLE_COUNT : OPENGL_FIXED_FUNCTION_MAX_PARTICLE_COUNT;
+            }
+
+            u32 max_sort_entry_count = cast(u32) (render_commands.command_buffer_size / sizeof(SortEntry));
+            initialize_coherent_sort(&win32_state.render_sort, max_sort_entry_count,
+                push_array(&win32_state.platform_arena, max_sort_entry_count, u32, no_clear()),
+                push_array(&win32_state.platform_arena, max_sort_entry_count, u32, no_clear())
+            );
 
             b32 sound_is_valid = false;
 
             size_t permanent_storage_size = MEGABYTES(cast(u64) win32_state.config.permanent_storage_size_mb);
             size_t transient_storage_size = MEGABYTES(cast(u64) win32_state.config.transient_storage_size_mb);
-            void* permanent_storage = win32_allocate_memory(permanent_storage_size + transient_storage_size);
+            void* permanent_storage = win32_allocate_large_pages(permanent_storage_size + transient_storage_size);
+            b32 storage_uses_large_pages = permanent_storage != 0;
+            if (storage_uses_large_pages) {
+                win32_state.large_page_storage = cast(u8*) permanent_storage;
+                win32_state.large_page_storage_size = permanent_storage_size + transient_storage_size;
+            } else {
+                permanent_storage = win32_reserve_memory(permanent_storage_size + transient_storage_size);
+            }
             void* transient_storage = cast(u8*) permanent_storage + permanent_storage_size;
 
-            win32_log_print(LogLevel_Info, "Command Buffer Size:    %uMB", render_commands.command_buffer_size / 1024 / 1024);
-            win32_log_print(LogLevel_Info, "Permanent Storage Size: %uMB", permanent_storage_size / 1024 / 1024);
-            win32_log_print(LogLevel_Info, "Transient Storage Size: %uMB", transient_storage_size / 1024 / 1024);
+            size_t prefault_size = 0;
+            if (!storage_uses_large_pages && prefault) {
+                // @Note: The arenas commit on demand, committing ahead of them is harmless since committing committed pages is a no-op
+                prefault_size = MEGABYTES(cast(u64) win32_state.config.prefault_storage_mb);
+                size_t permanent_prefault_size = MIN(prefault_size, permanent_storage_size);
+                size_t transient_prefault_size = MIN(prefault_size, transient_storage_size);
+                if (win32_commit_memory(permanent_storage, permanent_prefault_size) &&
+                    win32_commit_memory(transient_storage, transient_prefault_size))
+                {
+                    win32_prefault_memory(permanent_storage, permanent_prefault_size);
+                    win32_prefault_memory(transient_storage, transient_prefault_size);
+                } else {
+                    win32_log_print(LogLevel_Warn, "Could not commit %uMB of storage to pre-fault", win32_state.config.prefault_storage_mb);
+                    prefault_size = 0;
+                }
+            }
+
+            char* storage_backing = storage_uses_large_pages ? "large pages" : "reserved";
+            win32_log_print(LogLevel_Info, "Command Buffer Size:    %uMB%s", render_commands.command_buffer_size / 1024 / 1024, command_buffer_uses_large_pages ? " (large pages)" : "");
+            win32_log_print(LogLevel_Info, "Permanent Storage Size: %uMB (%s)", permanent_storage_size / 1024 / 1024, storage_backing);
+            win32_log_print(LogLevel_Info, "Transient Storage Size: %uMB (%s)", transient_storage_size / 1024 / 1024, storage_backing);
+            win32_log_print(LogLevel_Info, "Max Particle Count:     %u", render_commands.max_particle_count);
+            if (prefault_size) {
+                win32_log_print(LogLevel_Info, "Pre-faulted %uMB of each storage block", prefault_size / 1024 / 1024);
+            }
 
             GameMemory game_memory = {};
             game_memory.permanent_storage_size = permanent_storage_size;
@@ -871,8 +1190,12 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
 
             game_memory.platform_api.read_entire_file            = win32_read_entire_file;
             game_memory.platform_api.write_entire_file           = win32_write_entire_file;
+            game_memory.platform_api.write_entire_file_chunked   = win32_write_entire_file_chunked;
             game_memory.platform_api.allocate                    = win32_allocate_memory;
             game_memory.platform_api.deallocate                  = win32_deallocate_memory;
+            game_memory.platform_api.reserve                     = win32_reserve_memory;
+            game_memory.platform_api.commit                      = win32_commit_memory;
+            game_memory.platform_api.decommit                    = win32_decommit_memory;
             game_memory.platform_api.allocate_texture            = win32_allocate_texture;
             game_memory.platform_api.deallocate_texture          = win32_deallocate_texture;
             game_memory.platform_api.log_print                   = win32_log_print_internal;
@@ -887,12 +1210,17 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
             LARGE_INTEGER start_counter = win32_get_clock();
             f32 last_frame_time = 0.0f;
             u32 last_render_commands = 0;
+            u32 last_culled_render_commands = 0;
+            u32 last_draw_batches = 0;
             b32 last_frame_time_is_valid = false;
 
             DWORD previous_padded_write_cursor = 0;
 
             BYTE keyboard_state[256];
 
+            u32 page_faults_before_first_frame = win32_get_page_fault_count();
+            win32_log_print(LogLevel_Info, "Page faults during startup: %u", page_faults_before_first_frame);
+
             win32_state.running = true;
             while (win32_state.running) {
                 if (last_frame_time_is_valid) {
@@ -908,6 +1236,8 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
                     DebugFrameInfo* frame = frame_history->history + frame_index;
                     frame->time = last_frame_time;
                     frame->render_commands = last_render_commands;
+                    frame->culled_render_commands = last_culled_render_commands;
+                    frame->draw_batches = last_draw_batches;
                 }
 
                 handle_config_file(config_file_name);
@@ -936,10 +1266,11 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
                 u32 width  = window_rect.right  - window_rect.left;
                 u32 height = window_rect.bottom - window_rect.top;
 
-                render_commands.sort_entry_count = 0;
-                render_commands.first_command    = render_commands.command_buffer_size;
-                render_commands.width            = width;
-                render_commands.height           = height;
+                render_commands.sort_entry_count     = 0;
+                render_commands.culled_command_count = 0;
+                render_commands.first_command        = render_commands.command_buffer_size;
+                render_commands.width                = width;
+                render_commands.height               = height;
 
                 //
                 // Input
@@ -1110,7 +1441,7 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
                 // @TODO: Handle frame timing when vsync is not available / enabled.
                 //
 
-                win32_output_image(&render_commands, window_dc);
+                last_draw_batches = win32_output_image(&render_commands, window_dc);
 
                 game_post_render(&game_memory, new_input, &render_commands);
 
@@ -1132,9 +1463,13 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
                 }
 
                 last_render_commands = render_commands.sort_entry_count;
+                last_culled_render_commands = render_commands.culled_command_count;
 
                 LARGE_INTEGER end_counter = win32_get_clock();
                 last_frame_time = win32_get_seconds_elapsed(start_counter, end_counter);
+                if (!last_frame_time_is_valid) {
+                    win32_log_print(LogLevel_Info, "Page faults during the first frame: %u", win32_get_page_fault_count() - page_faults_before_first_frame);
+                }
                 last_frame_time_is_valid = true;
                 start_counter = end_counter;
 
@@ -1144,6 +1479,10 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE previous_instance, LPSTR comm
                     SWAP(new_input, old_input);
                 }
             }
+
+#if PULSAR_ARENA_INSTRUMENTATION
+            win32_dump_arena_stats_csv("arena_stats.csv");
+#endif
         } else {
             // @TODO: Some kind of logging?
             INVALID_CODE_PATH;